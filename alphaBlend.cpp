@@ -0,0 +1,281 @@
+/*********************************************************************
+*
+*   NAME:
+*       alphaBlend.cpp
+*
+*   DESCRIPTION:
+*       Solid color over RGB565 blending. The fast paths load two
+*       wire-order pixels per 32-bit word and blend each channel of
+*       both pixels with one multiply, the pair's channels sitting in
+*       16-bit lanes with room for the 8-bit alpha product.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "alphaBlend.hpp"
+#include <string.h>
+
+/*--------------------------------------------------------------------
+                                TYPES
+--------------------------------------------------------------------*/
+/* color * alpha + rounding for each channel, repeated in both lanes */
+typedef struct {
+    uint32_t r;
+    uint32_t g;
+    uint32_t b;
+    uint32_t inv;           /* 256 - alpha */
+} PairTerms;
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       alpha_mask_row
+*
+*   DESCRIPTION:
+*       Start of a mask row
+*
+*********************************************************************/
+const uint8_t* alpha_mask_row(const AlphaMask& mask, uint16_t row)
+    {
+    size_t stride = ((size_t)mask.width * mask.bpp + 7) / 8;
+    return mask.data + stride * row;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       alpha_mask_value
+*
+*   DESCRIPTION:
+*       Scales a mask pixel to 0-255
+*
+*********************************************************************/
+uint8_t alpha_mask_value(const AlphaMask& mask, const uint8_t* row, uint16_t col)
+    {
+    if (mask.bpp == 8) {
+        return row[col];
+    }
+
+    uint32_t bit = (uint32_t)col * mask.bpp;
+    uint8_t max = (uint8_t)((1 << mask.bpp) - 1);
+    uint8_t value = (row[bit >> 3] >> (8 - mask.bpp - (bit & 7))) & max;
+    return (uint8_t)(value * 255 / max);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       blend_wire565_scalar
+*
+*   DESCRIPTION:
+*       Portable fixed alpha blend, one pixel at a time
+*
+*********************************************************************/
+void blend_wire565_scalar(uint8_t* dst, uint16_t color, uint8_t alpha, size_t count)
+    {
+    for (size_t i = 0; i < count; i++) {
+        uint16_t d = (uint16_t)((dst[0] << 8) | dst[1]);
+        uint16_t out = blend565(color, d, alpha);
+        *dst++ = (uint8_t)(out >> 8);
+        *dst++ = (uint8_t)out;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       blend_mask_wire565_scalar
+*
+*   DESCRIPTION:
+*       Portable per-pixel alpha blend, one pixel at a time
+*
+*********************************************************************/
+void blend_mask_wire565_scalar(uint8_t* dst, uint16_t color, const uint8_t* alpha, size_t count)
+    {
+    for (size_t i = 0; i < count; i++) {
+        uint16_t d = (uint16_t)((dst[0] << 8) | dst[1]);
+        uint16_t out = blend565(color, d, alpha[i]);
+        *dst++ = (uint8_t)(out >> 8);
+        *dst++ = (uint8_t)out;
+    }
+    }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       pairTerms
+*
+*   DESCRIPTION:
+*       Source terms of the pair blend for one alpha
+*
+*********************************************************************/
+static inline PairTerms pairTerms(uint16_t color, uint8_t alpha)
+    {
+    uint32_t a = alpha + (alpha >> 7);
+    uint32_t r = (uint32_t)(color >> 11) * a + 128;
+    uint32_t g = (uint32_t)((color >> 5) & 0x3F) * a + 128;
+    uint32_t b = (uint32_t)(color & 0x1F) * a + 128;
+    return {r | (r << 16), g | (g << 16), b | (b << 16), 256 - a};
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       blendPair
+*
+*   DESCRIPTION:
+*       Blends two RGB565 pixels (one per 16-bit lane) with the same
+*       alpha: three multiplies for both pixels
+*
+*********************************************************************/
+static inline uint32_t blendPair(uint32_t d, const PairTerms& t)
+    {
+    uint32_t b = (((d & 0x001F001Fu) * t.inv + t.b) >> 8) & 0x001F001Fu;
+    uint32_t g = ((((d >> 5) & 0x003F003Fu) * t.inv + t.g) >> 8) & 0x003F003Fu;
+    uint32_t r = ((((d >> 11) & 0x001F001Fu) * t.inv + t.r) >> 8) & 0x001F001Fu;
+    return (r << 11) | (g << 5) | b;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       blendOne
+*
+*   DESCRIPTION:
+*       Blends one RGB565 pixel, red and blue moved 16 bits apart so
+*       they share a multiply
+*
+*********************************************************************/
+static inline uint32_t blendOne(uint32_t d, uint32_t color, uint8_t alpha)
+    {
+    uint32_t a = alpha + (alpha >> 7);
+    uint32_t s_rb = (color & 0x001Fu) | ((color & 0xF800u) << 5);
+    uint32_t d_rb = (d & 0x001Fu) | ((d & 0xF800u) << 5);
+    uint32_t rb = ((s_rb * a + d_rb * (256 - a) + 0x00800080u) >> 8) & 0x001F001Fu;
+    uint32_t g = (((color & 0x07E0u) * a + (d & 0x07E0u) * (256 - a) + (128u << 5)) >> 8) & 0x07E0u;
+    return (rb & 0x001Fu) | ((rb >> 5) & 0xF800u) | g;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       loadPair / storePair
+*
+*   DESCRIPTION:
+*       Two wire-order pixels to and from native 16-bit lanes
+*
+*********************************************************************/
+static inline uint32_t loadPair(const uint8_t* p)
+    {
+    uint32_t w;
+    memcpy(&w, p, 4);
+    return ((w >> 8) & 0x00FF00FFu) | ((w << 8) & 0xFF00FF00u);
+    }
+
+static inline void storePair(uint8_t* p, uint32_t w)
+    {
+    w = ((w >> 8) & 0x00FF00FFu) | ((w << 8) & 0xFF00FF00u);
+    memcpy(p, &w, 4);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       blend_wire565
+*
+*   DESCRIPTION:
+*       Fixed alpha blend, two pixels per word
+*
+*********************************************************************/
+void blend_wire565(uint8_t* dst, uint16_t color, uint8_t alpha, size_t count)
+    {
+    if (alpha == 0) {
+        return;
+    }
+
+    PairTerms terms = pairTerms(color, alpha);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        storePair(dst, blendPair(loadPair(dst), terms));
+        dst += 4;
+    }
+
+    blend_wire565_scalar(dst, color, alpha, count - i);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       blend_mask_wire565
+*
+*   DESCRIPTION:
+*       Per-pixel alpha blend, two pixels per word. Glyphs and icons
+*       are mostly clear or solid, so pairs that are both are skipped
+*       or stored without blending; pairs with one alpha use the lane
+*       blend.
+*
+*********************************************************************/
+void blend_mask_wire565(uint8_t* dst, uint16_t color, const uint8_t* alpha, size_t count)
+    {
+    uint32_t solid = (uint32_t)color | ((uint32_t)color << 16);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        uint8_t a0 = alpha[i];
+        uint8_t a1 = alpha[i + 1];
+        if ((a0 | a1) == 0) {
+            dst += 4;
+            continue;
+        }
+
+        if ((a0 & a1) == 0xFF) {
+            storePair(dst, solid);
+        } else if (a0 == a1) {
+            storePair(dst, blendPair(loadPair(dst), pairTerms(color, a0)));
+        } else {
+            uint32_t d = loadPair(dst);
+            storePair(dst, blendOne(d & 0xFFFFu, color, a0) | (blendOne(d >> 16, color, a1) << 16));
+        }
+        dst += 4;
+    }
+
+    blend_mask_wire565_scalar(dst, color, alpha + i, count - i);
+    }
+
+#else
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       blend_wire565
+*
+*   DESCRIPTION:
+*       Big-endian targets use the scalar blend
+*
+*********************************************************************/
+void blend_wire565(uint8_t* dst, uint16_t color, uint8_t alpha, size_t count)
+    {
+    blend_wire565_scalar(dst, color, alpha, count);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       blend_mask_wire565
+*
+*   DESCRIPTION:
+*       Big-endian targets use the scalar blend
+*
+*********************************************************************/
+void blend_mask_wire565(uint8_t* dst, uint16_t color, const uint8_t* alpha, size_t count)
+    {
+    blend_mask_wire565_scalar(dst, color, alpha, count);
+    }
+#endif
@@ -0,0 +1,64 @@
+#ifndef ALPHA_BLEND_HPP
+#define ALPHA_BLEND_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       alpha blending of a solid color over wire-order RGB565 rows,
+*       and alpha masks for icons
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+/* coverage of an icon, drawn in any color. Values are bpp (1, 2, 4 or
+   8) bits, MSB first, rows padded to a byte; 0 is transparent and the
+   largest value opaque. */
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint8_t bpp;
+    const uint8_t* data;
+} AlphaMask;
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/* one channel: s over d with alpha 0-255 (255 scaled to 256 so both
+   ends are exact), rounded */
+constexpr uint32_t blend_channel(uint32_t s, uint32_t d, uint8_t alpha)
+    {
+    uint32_t a = alpha + (alpha >> 7);
+    return (s * a + d * (256 - a) + 128) >> 8;
+    }
+
+/* fg over bg, RGB565 */
+constexpr uint16_t blend565(uint16_t fg, uint16_t bg, uint8_t alpha)
+    {
+    return (uint16_t)((blend_channel(fg >> 11, bg >> 11, alpha) << 11)
+                      | (blend_channel((fg >> 5) & 0x3F, (bg >> 5) & 0x3F, alpha) << 5)
+                      | blend_channel(fg & 0x1F, bg & 0x1F, alpha));
+    }
+
+/* alpha of mask pixel col of a row, 0-255 */
+uint8_t alpha_mask_value(const AlphaMask& mask, const uint8_t* row, uint16_t col);
+const uint8_t* alpha_mask_row(const AlphaMask& mask, uint16_t row);
+
+/* blend color over count wire-order pixels of dst, with one alpha for
+   the whole span (translucent fills) or one per pixel (masks, glyphs) */
+void blend_wire565(uint8_t* dst, uint16_t color, uint8_t alpha, size_t count);
+void blend_mask_wire565(uint8_t* dst, uint16_t color, const uint8_t* alpha, size_t count);
+
+/* one pixel at a time versions; the functions above give the same
+   output two pixels per 32-bit word */
+void blend_wire565_scalar(uint8_t* dst, uint16_t color, uint8_t alpha, size_t count);
+void blend_mask_wire565_scalar(uint8_t* dst, uint16_t color, const uint8_t* alpha, size_t count);
+
+#endif // ALPHA_BLEND_HPP
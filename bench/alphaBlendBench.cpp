@@ -0,0 +1,112 @@
+/*********************************************************************
+*
+*   NAME:
+*       alphaBlendBench.cpp
+*
+*   DESCRIPTION:
+*       Microbenchmark for the alpha blend kernels: blends a color
+*       into 240 pixel rows with one alpha and with a per-pixel mask,
+*       scalar and two-pixel versions, and prints pixels per second
+*       for each
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "alphaBlend.hpp"
+#include <chrono>
+#include <stdio.h>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef void (*FixedKernel)(uint8_t*, uint16_t, uint8_t, size_t);
+typedef void (*MaskKernel)(uint8_t*, uint16_t, const uint8_t*, size_t);
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr size_t ROW = 240;
+constexpr uint32_t ROWS = 200000;
+
+/*--------------------------------------------------------------------
+                              VARIABLES
+--------------------------------------------------------------------*/
+static uint8_t row_buf[ROW * 2];
+static uint8_t mask[ROW];
+static volatile uint32_t sink;
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       report
+*
+*   DESCRIPTION:
+*       Prints the rate of one run
+*
+*********************************************************************/
+static void report(const char* name, std::chrono::steady_clock::duration elapsed)
+    {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    printf("%-32s %8.1f Mpixel/s\n", name, (double)ROW * ROWS / seconds / 1e6);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       timeFixed / timeMask
+*
+*   DESCRIPTION:
+*       Blends ROWS rows with one kernel
+*
+*********************************************************************/
+static void timeFixed(const char* name, FixedKernel kernel)
+    {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t row = 0; row < ROWS; row++) {
+        kernel(row_buf, 0xA5C3, (uint8_t)(row | 1), ROW);
+        sink = sink + row_buf[row % sizeof(row_buf)];
+    }
+    report(name, std::chrono::steady_clock::now() - start);
+    }
+
+static void timeMask(const char* name, MaskKernel kernel)
+    {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t row = 0; row < ROWS; row++) {
+        kernel(row_buf, 0xA5C3, mask, ROW);
+        sink = sink + row_buf[row % sizeof(row_buf)];
+    }
+    report(name, std::chrono::steady_clock::now() - start);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Runs every kernel
+*
+*********************************************************************/
+int main()
+    {
+    for (size_t i = 0; i < sizeof(row_buf); i++) {
+        row_buf[i] = (uint8_t)(i * 37 + 11);
+    }
+    for (size_t i = 0; i < ROW; i++) {
+        mask[i] = (uint8_t)(i * 53 + 7);
+    }
+
+    timeFixed("fixed alpha scalar", blend_wire565_scalar);
+    timeFixed("fixed alpha pair", blend_wire565);
+    timeMask("mask alpha scalar", blend_mask_wire565_scalar);
+    timeMask("mask alpha pair", blend_mask_wire565);
+    return 0;
+    }
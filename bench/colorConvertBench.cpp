@@ -0,0 +1,116 @@
+/*********************************************************************
+*
+*   NAME:
+*       colorConvertBench.cpp
+*
+*   DESCRIPTION:
+*       Microbenchmark for the RGB888 / ARGB8888 to RGB565 kernels:
+*       converts 240 pixel rows with the scalar and word-parallel
+*       versions and prints pixels per second for each
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "colorConvert.hpp"
+#include <chrono>
+#include <stdio.h>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef void (*Rgb888Kernel)(uint8_t*, const uint8_t*, size_t, Dither, uint16_t, uint16_t);
+typedef void (*Argb8888Kernel)(uint8_t*, const uint32_t*, size_t, Dither, uint16_t, uint16_t);
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr size_t ROW = 240;
+constexpr uint32_t ROWS = 200000;
+
+/*--------------------------------------------------------------------
+                              VARIABLES
+--------------------------------------------------------------------*/
+static uint8_t rgb_src[ROW * 3];
+static uint32_t argb_src[ROW];
+static uint8_t out[ROW * 2];
+static volatile uint32_t sink;
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       report
+*
+*   DESCRIPTION:
+*       Prints the rate of one run
+*
+*********************************************************************/
+static void report(const char* name, std::chrono::steady_clock::duration elapsed)
+    {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    printf("%-32s %8.1f Mpixel/s\n", name, (double)ROW * ROWS / seconds / 1e6);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       timeRgb888 / timeArgb8888
+*
+*   DESCRIPTION:
+*       Converts ROWS rows with one kernel
+*
+*********************************************************************/
+static void timeRgb888(const char* name, Rgb888Kernel kernel, Dither dither)
+    {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t row = 0; row < ROWS; row++) {
+        kernel(out, rgb_src, ROW, dither, 0, (uint16_t)row);
+        sink = sink + out[row % sizeof(out)];
+    }
+    report(name, std::chrono::steady_clock::now() - start);
+    }
+
+static void timeArgb8888(const char* name, Argb8888Kernel kernel, Dither dither)
+    {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t row = 0; row < ROWS; row++) {
+        kernel(out, argb_src, ROW, dither, 0, (uint16_t)row);
+        sink = sink + out[row % sizeof(out)];
+    }
+    report(name, std::chrono::steady_clock::now() - start);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Runs every kernel with and without dithering
+*
+*********************************************************************/
+int main()
+    {
+    for (size_t i = 0; i < sizeof(rgb_src); i++) {
+        rgb_src[i] = (uint8_t)(i * 37 + 11);
+    }
+    for (size_t i = 0; i < ROW; i++) {
+        argb_src[i] = 0xFF000000u | ((uint32_t)i * 0x010307u);
+    }
+
+    timeRgb888("rgb888 scalar", rgb888_to_wire565_scalar, Dither::NONE);
+    timeRgb888("rgb888 word", rgb888_to_wire565, Dither::NONE);
+    timeRgb888("rgb888 scalar bayer4", rgb888_to_wire565_scalar, Dither::BAYER4);
+    timeRgb888("rgb888 word bayer4", rgb888_to_wire565, Dither::BAYER4);
+    timeArgb8888("argb8888 scalar", argb8888_to_wire565_scalar, Dither::NONE);
+    timeArgb8888("argb8888 word", argb8888_to_wire565, Dither::NONE);
+    timeArgb8888("argb8888 scalar bayer4", argb8888_to_wire565_scalar, Dither::BAYER4);
+    timeArgb8888("argb8888 word bayer4", argb8888_to_wire565, Dither::BAYER4);
+    return 0;
+    }
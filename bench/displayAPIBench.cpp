@@ -0,0 +1,381 @@
+/*********************************************************************
+*
+*   NAME:
+*       displayAPIBench.cpp
+*
+*   DESCRIPTION:
+*       displayAPI_bench: runs a fixed set of ST7789VW workloads
+*       against HostTransport, reports transactions, bytes, CS
+*       toggles and modelled wall time at each SPI clock as JSON, and
+*       fails when a counter regresses past the committed baseline.
+*
+*       displayAPI_bench [--json out.json] [--baseline base.json]
+*                        [--threshold percent] [--clock hz]...
+*
+*       The counters are deterministic, so the baseline is regenerated
+*       with --json whenever a change is meant to move them.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "graphics.hpp"
+#include "hostReport.hpp"
+#include "hostTransport.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    const char* name;
+    void (*run)(ST7789VW& display);
+} Workload;
+
+typedef struct {
+    const char* key;
+    uint32_t HostTransportStats::*field;
+} Metric;
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr DisplayProperties BENCH_PROPS = {240, 280, 240, 320, 0, 20};
+constexpr size_t MAX_CLOCKS = 8;
+constexpr double DEFAULT_THRESHOLD = 2.0;   /* percent */
+
+static const char PARAGRAPH[] =
+    "The quick brown fox jumps over the lazy dog while the display "
+    "streams every glyph through a single window per run. Word wrap "
+    "breaks lines at spaces so that no word is split across the edge "
+    "of the screen, and long paragraphs like this one exercise the "
+    "layout code as much as the pixel path.";
+
+/* compared against the baseline; transactions are the CS toggles */
+static const Metric METRICS[] = {
+    {"transactions", &HostTransportStats::transactions},
+    {"bytes",        &HostTransportStats::bytes},
+    {"dc_changes",   &HostTransportStats::dc_changes},
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       fullClear
+*
+*   DESCRIPTION:
+*       One full-screen fill
+*
+*********************************************************************/
+static void fullClear(ST7789VW& display)
+    {
+    display.fill((uint16_t)Colors::BLUE);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       glyphs1000
+*
+*   DESCRIPTION:
+*       1000 opaque 8x8 glyphs, a screen of full lines
+*
+*********************************************************************/
+static void glyphs1000(ST7789VW& display)
+    {
+    char line[31];
+    uint32_t drawn = 0;
+    for (uint16_t row = 0; drawn < 1000; row++) {
+        uint16_t n = (1000 - drawn < 30) ? (uint16_t)(1000 - drawn) : 30;
+        for (uint16_t i = 0; i < n; i++) {
+            line[i] = (char)('!' + (drawn + i) % 94);
+        }
+        line[n] = '\0';
+        display.write_string_pos(0, (uint16_t)(row * 8), line, (uint16_t)Colors::WHITE, (uint16_t)Colors::BLACK);
+        drawn += n;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       wrappedParagraph
+*
+*   DESCRIPTION:
+*       A paragraph laid out with word wrap, transparent and opaque
+*
+*********************************************************************/
+static void wrappedParagraph(ST7789VW& display)
+    {
+    display.write_string_pos(0, 0, PARAGRAPH, (uint16_t)Colors::YELLOW, true);
+    display.write_string_pos(0, 120, PARAGRAPH, (uint16_t)Colors::WHITE, (uint16_t)Colors::BLUE, true);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       rotations
+*
+*   DESCRIPTION:
+*       Every rotation in turn, each with a fill and a label
+*
+*********************************************************************/
+static void rotations(ST7789VW& display)
+    {
+    static const ST7789VW::Rotation order[] = {
+        ST7789VW::Rotation::ROTATION_90, ST7789VW::Rotation::ROTATION_180,
+        ST7789VW::Rotation::ROTATION_270, ST7789VW::Rotation::ROTATION_0,
+    };
+
+    for (ST7789VW::Rotation rotation : order) {
+        display.set_rotation(rotation);
+        display.fill_rect(0, 0, display.width(), 40, (uint16_t)Colors::ORANGE);
+        display.write_string_pos(8, 16, "ROTATED", (uint16_t)Colors::BLACK, (uint16_t)Colors::ORANGE);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       dashboard
+*
+*   DESCRIPTION:
+*       A mixed frame: background, title bar, gauges, bars and values
+*
+*********************************************************************/
+static void dashboard(ST7789VW& display)
+    {
+    Graphics gfx(display);
+    char value[16];
+
+    display.fill((uint16_t)Colors::BLACK);
+    display.fill_rect(0, 0, 240, 24, (uint16_t)Colors::BLUE);
+    display.write_string_pos(8, 8, "ENGINE STATUS", (uint16_t)Colors::WHITE, (uint16_t)Colors::BLUE);
+
+    for (uint16_t i = 0; i < 3; i++) {
+        int16_t cx = (int16_t)(40 + i * 80);
+        gfx.draw_circle(cx, 70, 32, (uint16_t)Colors::CYAN);
+        gfx.fill_circle(cx, 70, 4, (uint16_t)Colors::RED);
+        gfx.draw_line(cx, 70, (int16_t)(cx + 20 - i * 10), 48, (uint16_t)Colors::RED);
+        snprintf(value, sizeof(value), "%u%%", (unsigned)(35 + i * 20));
+        display.write_string_pos((uint16_t)(cx - 12), 110, value, (uint16_t)Colors::WHITE, (uint16_t)Colors::BLACK);
+    }
+
+    for (uint16_t i = 0; i < 6; i++) {
+        uint16_t y = (uint16_t)(130 + i * 22);
+        snprintf(value, sizeof(value), "CH%u", (unsigned)i);
+        display.write_string_pos(8, (uint16_t)(y + 4), value, (uint16_t)Colors::GREEN);
+        gfx.draw_round_rect(40, (int16_t)y, 190, 16, 4, (uint16_t)Colors::WHITE);
+        gfx.fill_round_rect(42, (int16_t)(y + 2), (int16_t)(30 + i * 25), 12, 3, (uint16_t)Colors::GREEN);
+    }
+    }
+
+static const Workload WORKLOADS[] = {
+    {"full_clear",        fullClear},
+    {"glyphs_1000",       glyphs1000},
+    {"wrapped_paragraph", wrappedParagraph},
+    {"rotations",         rotations},
+    {"dashboard",         dashboard},
+};
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       readFile
+*
+*   DESCRIPTION:
+*       Whole file as a terminated string, false if it can't be read
+*
+*********************************************************************/
+static bool readFile(const char* path, std::vector<char>& text)
+    {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        text.insert(text.end(), chunk, chunk + n);
+    }
+    fclose(f);
+    text.push_back('\0');
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       baselineValue
+*
+*   DESCRIPTION:
+*       Finds a counter of one workload in a report written by this
+*       program. Only the layout host_write_stats_json produces is
+*       understood, which is all a baseline ever holds.
+*
+*********************************************************************/
+static bool baselineValue(const char* json, const char* workload, const char* key, unsigned long& value)
+    {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"name\": \"%s\"", workload);
+    const char* object = strstr(json, pattern);
+    if (!object) {
+        return false;
+    }
+
+    const char* next = strstr(object + 1, "\"name\": ");
+    snprintf(pattern, sizeof(pattern), "\"%s\": ", key);
+    const char* field = strstr(object, pattern);
+    if (!field || (next && field > next)) {
+        return false;
+    }
+
+    value = strtoul(field + strlen(pattern), nullptr, 10);
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       writeReport
+*
+*   DESCRIPTION:
+*       All workload results as one JSON document
+*
+*********************************************************************/
+static void writeReport(FILE* f, const HostTransportStats* results, const HostBusModel* models, size_t model_count)
+    {
+    fprintf(f, "{\"bench\": \"displayAPI\", \"workloads\": [\n");
+    for (size_t i = 0; i < sizeof(WORKLOADS) / sizeof(WORKLOADS[0]); i++) {
+        fprintf(f, "  ");
+        host_write_stats_json(f, WORKLOADS[i].name, results[i], models, model_count);
+        fprintf(f, "%s\n", (i + 1 < sizeof(WORKLOADS) / sizeof(WORKLOADS[0])) ? "," : "");
+    }
+    fprintf(f, "]}\n");
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       compareBaseline
+*
+*   DESCRIPTION:
+*       Returns the number of counters more than threshold percent
+*       above the baseline; a workload or counter missing from the
+*       baseline counts as one
+*
+*********************************************************************/
+static int compareBaseline(const char* json, const HostTransportStats* results, double threshold)
+    {
+    int regressions = 0;
+    for (size_t i = 0; i < sizeof(WORKLOADS) / sizeof(WORKLOADS[0]); i++) {
+        for (const Metric& metric : METRICS) {
+            unsigned long base;
+            unsigned long now = results[i].*metric.field;
+            if (!baselineValue(json, WORKLOADS[i].name, metric.key, base)) {
+                fprintf(stderr, "%s.%s: not in baseline\n", WORKLOADS[i].name, metric.key);
+                regressions++;
+                continue;
+            }
+
+            double limit = base * (1.0 + threshold / 100.0);
+            if (now > limit) {
+                fprintf(stderr, "%s.%s: %lu, baseline %lu (+%.1f%%, limit %.1f%%)\n", WORKLOADS[i].name, metric.key,
+                        now, base, 100.0 * ((double)now - base) / (base ? base : 1), threshold);
+                regressions++;
+            } else if (now < base) {
+                printf("%s.%s: %lu, baseline %lu (improved; regenerate the baseline with --json)\n",
+                       WORKLOADS[i].name, metric.key, now, base);
+            }
+        }
+    }
+    return regressions;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Parses the options, runs every workload on a fresh display
+*       and transport, then reports and compares
+*
+*********************************************************************/
+int main(int argc, char** argv)
+    {
+    const char* json_path = nullptr;
+    const char* baseline_path = nullptr;
+    double threshold = DEFAULT_THRESHOLD;
+    HostBusModel models[MAX_CLOCKS];
+    size_t model_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = (i + 1 < argc);
+        if (has_value && strcmp(argv[i], "--json") == 0) {
+            json_path = argv[++i];
+        } else if (has_value && strcmp(argv[i], "--baseline") == 0) {
+            baseline_path = argv[++i];
+        } else if (has_value && strcmp(argv[i], "--threshold") == 0) {
+            threshold = atof(argv[++i]);
+        } else if (has_value && strcmp(argv[i], "--clock") == 0 && model_count < MAX_CLOCKS) {
+            models[model_count] = HOST_BUS_62_5MHZ;
+            models[model_count].clock_hz = (uint32_t)strtoul(argv[++i], nullptr, 10);
+            model_count++;
+        } else {
+            fprintf(stderr, "usage: %s [--json out.json] [--baseline base.json] [--threshold percent] [--clock hz]...\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (model_count == 0) {
+        models[model_count++] = HOST_BUS_31_25MHZ;
+        models[model_count++] = HOST_BUS_62_5MHZ;
+    }
+
+    HostTransportStats results[sizeof(WORKLOADS) / sizeof(WORKLOADS[0])];
+    for (size_t i = 0; i < sizeof(WORKLOADS) / sizeof(WORKLOADS[0]); i++) {
+        HostTransport transport;
+        ST7789VW display(transport, BENCH_PROPS);
+        display.init(false);
+        transport.reset_stats();
+
+        WORKLOADS[i].run(display);
+        results[i] = transport.stats();
+    }
+
+    writeReport(stdout, results, models, model_count);
+    if (json_path) {
+        FILE* f = fopen(json_path, "w");
+        if (!f) {
+            fprintf(stderr, "cannot write %s\n", json_path);
+            return 2;
+        }
+        writeReport(f, results, models, model_count);
+        fclose(f);
+    }
+
+    if (baseline_path) {
+        std::vector<char> baseline;
+        if (!readFile(baseline_path, baseline)) {
+            fprintf(stderr, "cannot read %s\n", baseline_path);
+            return 2;
+        }
+        int regressions = compareBaseline(baseline.data(), results, threshold);
+        if (regressions > 0) {
+            fprintf(stderr, "%d counter(s) regressed past %.1f%%\n", regressions, threshold);
+            return 1;
+        }
+    }
+    return 0;
+    }
@@ -0,0 +1,276 @@
+/*********************************************************************
+*
+*   NAME:
+*       graphicsBench.cpp
+*
+*   DESCRIPTION:
+*       Host benchmark for Graphics: draws each primitive once through
+*       the span engine and once as single-pixel writes, and reports
+*       the SPI transactions, bytes and modelled bus time of both
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "graphics.hpp"
+#include "hostReport.hpp"
+#include "hostTransport.hpp"
+#include <stdio.h>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+enum class Shape {
+    HLINE,
+    VLINE,
+    RECT,
+    FILL_RECT,
+    LINE,
+    CIRCLE,
+    FILL_CIRCLE,
+    ROUND_RECT,
+    FILL_ROUND_RECT
+};
+
+typedef struct {
+    const char* name;
+    Shape shape;
+} Workload;
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+static const Workload WORKLOADS[] = {
+    {"hline",           Shape::HLINE},
+    {"vline",           Shape::VLINE},
+    {"rect",            Shape::RECT},
+    {"fill_rect",       Shape::FILL_RECT},
+    {"line",            Shape::LINE},
+    {"circle",          Shape::CIRCLE},
+    {"fill_circle",     Shape::FILL_CIRCLE},
+    {"round_rect",      Shape::ROUND_RECT},
+    {"fill_round_rect", Shape::FILL_ROUND_RECT},
+};
+
+constexpr uint16_t COLOR = 0xF81F;
+
+/*--------------------------------------------------------------------
+                              CLASSES
+--------------------------------------------------------------------*/
+/* the same shapes drawn the way callers did before Graphics: one
+   1x1 fill_rect per pixel */
+class PixelPlotter {
+    public:
+        explicit PixelPlotter(ST7789VW& display) : _display(display) {}
+
+        void plot(int32_t x, int32_t y)
+            {
+            if (x >= 0 && y >= 0 && x < _display.width() && y < _display.height()) {
+                _display.fill_rect((uint16_t)x, (uint16_t)y, 1, 1, COLOR);
+            }
+            }
+
+        void run(int32_t x, int32_t y, int32_t width)
+            {
+            for (int32_t i = 0; i < width; i++) {
+                plot(x + i, y);
+            }
+            }
+
+        void column(int32_t x, int32_t y, int32_t height)
+            {
+            for (int32_t i = 0; i < height; i++) {
+                plot(x, y + i);
+            }
+            }
+
+        void line(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+            {
+            int32_t dx = (x1 > x0) ? x1 - x0 : x0 - x1;
+            int32_t dy = (y1 > y0) ? y0 - y1 : y1 - y0;
+            int32_t sx = (x0 < x1) ? 1 : -1;
+            int32_t sy = (y0 < y1) ? 1 : -1;
+            int32_t err = dx + dy;
+            for (;;) {
+                plot(x0, y0);
+                if (x0 == x1 && y0 == y1) {
+                    break;
+                }
+                int32_t e2 = 2 * err;
+                if (e2 >= dy) {
+                    err += dy;
+                    x0 += sx;
+                }
+                if (e2 <= dx) {
+                    err += dx;
+                    y0 += sy;
+                }
+            }
+            }
+
+        /* quarter arcs around the four corner centres */
+        void arcs(int32_t left, int32_t top, int32_t right, int32_t bottom, int32_t r)
+            {
+            int32_t x = r;
+            int32_t y = 0;
+            int32_t err = 1 - r;
+            while (x >= y) {
+                plot(right + x, bottom + y); plot(left - x, bottom + y);
+                plot(right + y, bottom + x); plot(left - y, bottom + x);
+                plot(right + x, top - y);    plot(left - x, top - y);
+                plot(right + y, top - x);    plot(left - y, top - x);
+                y++;
+                if (err < 0) {
+                    err += 2 * y + 1;
+                } else {
+                    x--;
+                    err += 2 * (y - x) + 1;
+                }
+            }
+            }
+
+        /* rows above top and below bottom, each drawn once */
+        void arcRows(int32_t left, int32_t top, int32_t right, int32_t bottom, int32_t r)
+            {
+            for (int32_t dy = (top == bottom) ? 0 : 1; dy <= r; dy++) {
+                int32_t dx = 0;
+                while ((dx + 1) * (dx + 1) + dy * dy <= r * r) {
+                    dx++;
+                }
+                run(left - dx, top - dy, right - left + 2 * dx + 1);
+                if (dy != 0) {
+                    run(left - dx, bottom + dy, right - left + 2 * dx + 1);
+                }
+            }
+            }
+
+    private:
+        ST7789VW& _display;
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       drawSpans
+*
+*   DESCRIPTION:
+*       One primitive through Graphics
+*
+*********************************************************************/
+static void drawSpans(Graphics& gfx, Shape shape)
+    {
+    switch (shape) {
+        case Shape::HLINE:           gfx.draw_hline(10, 100, 200, COLOR); break;
+        case Shape::VLINE:           gfx.draw_vline(120, 10, 250, COLOR); break;
+        case Shape::RECT:            gfx.draw_rect(20, 20, 200, 120, COLOR); break;
+        case Shape::FILL_RECT:       gfx.fill_rect(20, 20, 200, 120, COLOR); break;
+        case Shape::LINE:            gfx.draw_line(5, 10, 230, 200, COLOR); break;
+        case Shape::CIRCLE:          gfx.draw_circle(120, 140, 80, COLOR); break;
+        case Shape::FILL_CIRCLE:     gfx.fill_circle(120, 140, 80, COLOR); break;
+        case Shape::ROUND_RECT:      gfx.draw_round_rect(20, 40, 200, 160, 24, COLOR); break;
+        case Shape::FILL_ROUND_RECT: gfx.fill_round_rect(20, 40, 200, 160, 24, COLOR); break;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       drawPixels
+*
+*   DESCRIPTION:
+*       The same primitive one pixel per write
+*
+*********************************************************************/
+static void drawPixels(PixelPlotter& px, Shape shape)
+    {
+    switch (shape) {
+        case Shape::HLINE:
+            px.run(10, 100, 200);
+            break;
+        case Shape::VLINE:
+            px.column(120, 10, 250);
+            break;
+        case Shape::RECT:
+            px.run(20, 20, 200);
+            px.run(20, 139, 200);
+            px.column(20, 21, 118);
+            px.column(219, 21, 118);
+            break;
+        case Shape::FILL_RECT:
+            for (int32_t y = 20; y < 140; y++) {
+                px.run(20, y, 200);
+            }
+            break;
+        case Shape::LINE:
+            px.line(5, 10, 230, 200);
+            break;
+        case Shape::CIRCLE:
+            px.arcs(120, 140, 120, 140, 80);
+            break;
+        case Shape::FILL_CIRCLE:
+            px.arcRows(120, 140, 120, 140, 80);
+            break;
+        case Shape::ROUND_RECT:
+            px.run(44, 40, 152);
+            px.run(44, 199, 152);
+            px.column(20, 64, 112);
+            px.column(219, 64, 112);
+            px.arcs(44, 64, 195, 175, 24);
+            break;
+        case Shape::FILL_ROUND_RECT:
+            for (int32_t y = 64; y <= 175; y++) {
+                px.run(20, y, 200);
+            }
+            px.arcRows(44, 64, 195, 175, 24);
+            break;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Runs every workload both ways and prints one row each
+*
+*********************************************************************/
+int main()
+    {
+    HostTransport transport;
+    DisplayProperties props = {240, 280, 240, 320, 0, 20};
+    ST7789VW display(transport, props);
+    display.init(false);
+
+    Graphics gfx(display);
+    PixelPlotter px(display);
+
+    printf("%-16s %10s %10s %10s | %10s %10s %10s\n", "primitive",
+           "span tx", "span B", "span us", "pixel tx", "pixel B", "pixel us");
+
+    for (const Workload& w : WORKLOADS) {
+        transport.reset_stats();
+        drawSpans(gfx, w.shape);
+        HostTransportStats spans = transport.stats();
+
+        transport.reset_stats();
+        drawPixels(px, w.shape);
+        HostTransportStats pixels = transport.stats();
+
+        printf("%-16s %10lu %10lu %10.1f | %10lu %10lu %10.1f\n", w.name,
+               (unsigned long)spans.transactions, (unsigned long)spans.bytes,
+               host_modeled_ns(spans, HOST_BUS_62_5MHZ) / 1000.0,
+               (unsigned long)pixels.transactions, (unsigned long)pixels.bytes,
+               host_modeled_ns(pixels, HOST_BUS_62_5MHZ) / 1000.0);
+    }
+
+    printf("modelled at %lu Hz, %lu ns per transaction\n",
+           (unsigned long)HOST_BUS_62_5MHZ.clock_hz, (unsigned long)HOST_BUS_62_5MHZ.transaction_ns);
+    return 0;
+    }
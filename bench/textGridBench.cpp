@@ -0,0 +1,143 @@
+/*********************************************************************
+*
+*   NAME:
+*       textGridBench.cpp
+*
+*   DESCRIPTION:
+*       Host benchmark for TextGrid: a ticking clock and a block of
+*       counters redrawn once per update, first with write_string_pos
+*       and then through the grid, reporting SPI bytes, transactions
+*       and modelled bus time per update
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "hostReport.hpp"
+#include "hostTransport.hpp"
+#include "textGrid.hpp"
+#include <stdio.h>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    char text[32];
+    uint16_t col;
+    uint16_t row;
+} Field;
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint32_t UPDATES = 3600;          /* one hour of clock ticks */
+constexpr uint16_t COUNTERS = 6;
+constexpr uint16_t FG = 0xFFFF;
+constexpr uint16_t BG = 0x0000;
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       frameFields
+*
+*   DESCRIPTION:
+*       The screen at one tick: a clock, a label row that never
+*       changes, and counters that step at different rates
+*
+*********************************************************************/
+static uint16_t frameFields(uint32_t tick, Field* fields)
+    {
+    uint16_t n = 0;
+    snprintf(fields[n].text, sizeof(fields[n].text), "%02lu:%02lu:%02lu",
+             (unsigned long)(12 + tick / 3600), (unsigned long)((tick / 60) % 60), (unsigned long)(tick % 60));
+    fields[n].col = 8;
+    fields[n].row = 2;
+    n++;
+
+    snprintf(fields[n].text, sizeof(fields[n].text), "RPM   TEMP  VOLTS");
+    fields[n].col = 1;
+    fields[n].row = 5;
+    n++;
+
+    for (uint16_t i = 0; i < COUNTERS; i++) {
+        unsigned long value = (unsigned long)(tick * (i * i + 1) / (i + 1));
+        snprintf(fields[n].text, sizeof(fields[n].text), "CH%u %8lu", (unsigned)i, value);
+        fields[n].col = 1;
+        fields[n].row = (uint16_t)(8 + 2 * i);
+        n++;
+    }
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       report
+*
+*   DESCRIPTION:
+*       Prints per-update averages of one run
+*
+*********************************************************************/
+static void report(const char* name, const HostTransportStats& stats)
+    {
+    printf("%-18s %12.1f %12.1f %12.1f %12.1f\n", name,
+           (double)stats.bytes / UPDATES, (double)stats.transactions / UPDATES,
+           host_modeled_ns(stats, HOST_BUS_31_25MHZ) / 1000.0 / UPDATES,
+           host_modeled_ns(stats, HOST_BUS_62_5MHZ) / 1000.0 / UPDATES);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Runs the workload both ways and prints one row each
+*
+*********************************************************************/
+int main()
+    {
+    HostTransport transport;
+    DisplayProperties props = {240, 280, 240, 320, 0, 20};
+    ST7789VW display(transport, props);
+    display.init(false);
+
+    Field fields[2 + COUNTERS];
+    printf("%-18s %12s %12s %12s %12s\n", "per update", "bytes", "transactions", "us @31.25MHz", "us @62.5MHz");
+
+    display.fill(BG);
+    transport.reset_stats();
+    for (uint32_t tick = 0; tick < UPDATES; tick++) {
+        uint16_t n = frameFields(tick, fields);
+        for (uint16_t i = 0; i < n; i++) {
+            display.write_string_pos((uint16_t)(fields[i].col * 8), (uint16_t)(fields[i].row * 8),
+                                     fields[i].text, FG, BG);
+        }
+    }
+    HostTransportStats direct = transport.stats();
+    report("write_string_pos", direct);
+
+    StaticTextGrid<240, 280> grid(display);
+    grid.clear(BG);
+    transport.reset_stats();
+    for (uint32_t tick = 0; tick < UPDATES; tick++) {
+        uint16_t n = frameFields(tick, fields);
+        for (uint16_t i = 0; i < n; i++) {
+            grid.write(fields[i].col, fields[i].row, fields[i].text, FG, BG);
+        }
+    }
+    HostTransportStats cached = transport.stats();
+    report("TextGrid", cached);
+
+    const TextGridStats& cells = grid.stats();
+    printf("cells written %lu, drawn %lu in %lu runs; %.1fx fewer bytes\n",
+           (unsigned long)cells.cells_written, (unsigned long)cells.cells_drawn, (unsigned long)cells.runs,
+           (double)direct.bytes / (cached.bytes ? cached.bytes : 1));
+    return 0;
+    }
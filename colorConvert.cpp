@@ -0,0 +1,236 @@
+/*********************************************************************
+*
+*   NAME:
+*       colorConvert.cpp
+*
+*   DESCRIPTION:
+*       RGB888 / ARGB8888 to RGB565 row conversion. The fast path
+*       spreads a pixel's channels into 10-bit lanes of one word so the
+*       dither offset and its saturation are done for all three
+*       channels at once, and writes two wire-order pixels per store.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "colorConvert.hpp"
+#include <string.h>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+static const uint8_t BAYER4[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5}
+};
+
+#define LANE_OVERFLOW   0x10040100u     /* bit 8 of each 10-bit lane */
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ditheredPixel
+*
+*   DESCRIPTION:
+*       Reference conversion of one pixel. The Bayer value (0-15) is
+*       scaled to the bits each channel loses and added, saturating.
+*
+*********************************************************************/
+static uint16_t ditheredPixel(uint8_t r, uint8_t g, uint8_t b, Dither dither, uint16_t x, uint16_t y)
+    {
+    if (dither == Dither::BAYER4) {
+        uint8_t m = BAYER4[y & 3][x & 3];
+        r = (uint8_t)((r + (m >> 1) > 255) ? 255 : r + (m >> 1));
+        g = (uint8_t)((g + (m >> 2) > 255) ? 255 : g + (m >> 2));
+        b = (uint8_t)((b + (m >> 1) > 255) ? 255 : b + (m >> 1));
+    }
+    return rgb565(r, g, b);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       rgb888_to_wire565_scalar
+*
+*   DESCRIPTION:
+*       Portable RGB888 conversion, one pixel at a time
+*
+*********************************************************************/
+void rgb888_to_wire565_scalar(uint8_t* out, const uint8_t* src, size_t count, Dither dither, uint16_t x, uint16_t y)
+    {
+    for (size_t i = 0; i < count; i++) {
+        uint16_t color = ditheredPixel(src[0], src[1], src[2], dither, (uint16_t)(x + i), y);
+        *out++ = (uint8_t)(color >> 8);
+        *out++ = (uint8_t)color;
+        src += 3;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       argb8888_to_wire565_scalar
+*
+*   DESCRIPTION:
+*       Portable ARGB8888 conversion, one pixel at a time
+*
+*********************************************************************/
+void argb8888_to_wire565_scalar(uint8_t* out, const uint32_t* src, size_t count, Dither dither, uint16_t x, uint16_t y)
+    {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t p = src[i];
+        uint16_t color = ditheredPixel((uint8_t)(p >> 16), (uint8_t)(p >> 8), (uint8_t)p, dither, (uint16_t)(x + i), y);
+        *out++ = (uint8_t)(color >> 8);
+        *out++ = (uint8_t)color;
+    }
+    }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ditherOffsets
+*
+*   DESCRIPTION:
+*       Lane-spread dither offsets for the four column phases of row y
+*       (zero without dithering), rotated so entry 0 belongs to x
+*
+*********************************************************************/
+static void ditherOffsets(uint32_t offsets[4], Dither dither, uint16_t x, uint16_t y)
+    {
+    for (uint8_t i = 0; i < 4; i++) {
+        uint32_t m = (dither == Dither::BAYER4) ? BAYER4[y & 3][(x + i) & 3] : 0;
+        offsets[i] = ((m >> 1) << 20) | ((m >> 2) << 10) | (m >> 1);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       laneTo565
+*
+*   DESCRIPTION:
+*       0x00RRGGBB plus a lane offset to RGB565. Channels sit in
+*       10-bit lanes so each add can carry into bit 8 of its own lane;
+*       a carried lane is then forced to 0xFF.
+*
+*********************************************************************/
+static inline uint32_t laneTo565(uint32_t p, uint32_t offset)
+    {
+    uint32_t s = (p & 0xFFu) | ((p & 0xFF00u) << 2) | ((p & 0xFF0000u) << 4);
+    s += offset;
+    uint32_t carry = s & LANE_OVERFLOW;
+    s |= carry - (carry >> 8);
+    return ((s >> 12) & 0xF800u) | ((s >> 7) & 0x07E0u) | ((s >> 3) & 0x001Fu);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       storePair
+*
+*   DESCRIPTION:
+*       Writes two RGB565 pixels in wire order with one store
+*
+*********************************************************************/
+static inline void storePair(uint8_t* out, uint32_t c0, uint32_t c1)
+    {
+    uint32_t w = c0 | (c1 << 16);
+    w = ((w >> 8) & 0x00FF00FFu) | ((w << 8) & 0xFF00FF00u);
+    memcpy(out, &w, 4);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       rgb888_to_wire565
+*
+*   DESCRIPTION:
+*       RGB888 conversion, four pixels from three word loads
+*
+*********************************************************************/
+void rgb888_to_wire565(uint8_t* out, const uint8_t* src, size_t count, Dither dither, uint16_t x, uint16_t y)
+    {
+    uint32_t off[4];
+    ditherOffsets(off, dither, x, y);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32_t w[3];
+        memcpy(w, src, 12);
+        /* w0 = R0 G0 B0 R1, w1 = G1 B1 R2 G2, w2 = B2 R3 G3 B3 */
+        uint32_t p0 = ((w[0] & 0xFFu) << 16) | (w[0] & 0xFF00u) | ((w[0] >> 16) & 0xFFu);
+        uint32_t p1 = ((w[0] >> 8) & 0xFF0000u) | ((w[1] & 0xFFu) << 8) | ((w[1] >> 8) & 0xFFu);
+        uint32_t p2 = (w[1] & 0xFF0000u) | ((w[1] >> 16) & 0xFF00u) | (w[2] & 0xFFu);
+        uint32_t p3 = ((w[2] << 8) & 0xFF0000u) | ((w[2] >> 8) & 0xFF00u) | (w[2] >> 24);
+
+        storePair(out, laneTo565(p0, off[0]), laneTo565(p1, off[1]));
+        storePair(out + 4, laneTo565(p2, off[2]), laneTo565(p3, off[3]));
+        src += 12;
+        out += 8;
+    }
+
+    rgb888_to_wire565_scalar(out, src, count - i, dither, (uint16_t)(x + i), y);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       argb8888_to_wire565
+*
+*   DESCRIPTION:
+*       ARGB8888 conversion, two pixels per output store
+*
+*********************************************************************/
+void argb8888_to_wire565(uint8_t* out, const uint32_t* src, size_t count, Dither dither, uint16_t x, uint16_t y)
+    {
+    uint32_t off[4];
+    ditherOffsets(off, dither, x, y);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        storePair(out, laneTo565(src[i], off[0]), laneTo565(src[i + 1], off[1]));
+        storePair(out + 4, laneTo565(src[i + 2], off[2]), laneTo565(src[i + 3], off[3]));
+        out += 8;
+    }
+
+    argb8888_to_wire565_scalar(out, src + i, count - i, dither, (uint16_t)(x + i), y);
+    }
+
+#else
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       rgb888_to_wire565
+*
+*   DESCRIPTION:
+*       Big-endian targets use the scalar conversion
+*
+*********************************************************************/
+void rgb888_to_wire565(uint8_t* out, const uint8_t* src, size_t count, Dither dither, uint16_t x, uint16_t y)
+    {
+    rgb888_to_wire565_scalar(out, src, count, dither, x, y);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       argb8888_to_wire565
+*
+*   DESCRIPTION:
+*       Big-endian targets use the scalar conversion
+*
+*********************************************************************/
+void argb8888_to_wire565(uint8_t* out, const uint32_t* src, size_t count, Dither dither, uint16_t x, uint16_t y)
+    {
+    argb8888_to_wire565_scalar(out, src, count, dither, x, y);
+    }
+#endif
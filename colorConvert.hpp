@@ -0,0 +1,49 @@
+#ifndef COLOR_CONVERT_HPP
+#define COLOR_CONVERT_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       bulk RGB888 / ARGB8888 to wire-order RGB565 conversion with
+*       optional ordered dithering
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+enum class Dither : uint8_t {
+    NONE,           /* truncate to 5/6/5 bits                               */
+    BAYER4          /* 4x4 ordered dither, phase from the screen position   */
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+constexpr uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b)
+    {
+    return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+    }
+
+/* convert count pixels starting at screen position (x, y) into out
+   (2 bytes per pixel, big-endian). src is R, G, B bytes for RGB888 and
+   0xAARRGGBB words for ARGB8888; alpha is ignored. */
+void rgb888_to_wire565(uint8_t* out, const uint8_t* src, size_t count,
+                       Dither dither = Dither::NONE, uint16_t x = 0, uint16_t y = 0);
+void argb8888_to_wire565(uint8_t* out, const uint32_t* src, size_t count,
+                         Dither dither = Dither::NONE, uint16_t x = 0, uint16_t y = 0);
+
+/* one pixel at a time versions; the functions above give the same
+   output two to four pixels per 32-bit word */
+void rgb888_to_wire565_scalar(uint8_t* out, const uint8_t* src, size_t count,
+                              Dither dither = Dither::NONE, uint16_t x = 0, uint16_t y = 0);
+void argb8888_to_wire565_scalar(uint8_t* out, const uint32_t* src, size_t count,
+                                Dither dither = Dither::NONE, uint16_t x = 0, uint16_t y = 0);
+
+#endif // COLOR_CONVERT_HPP
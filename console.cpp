@@ -0,0 +1,253 @@
+/*********************************************************************
+*
+*   NAME:
+*       console.cpp
+*
+*   DESCRIPTION:
+*       Scrolling text console. Scrolling by a line moves the
+*       hardware scroll start (one VSCSAD command) and clears the
+*       line that comes into view, instead of redrawing the screen.
+*       Consecutive characters on a line are drawn as one run.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "console.hpp"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Console::Console (constructor)
+*
+*   DESCRIPTION:
+*       Console class constructor
+*
+*********************************************************************/
+Console::Console(ST7789VW& display, uint16_t color, uint16_t bg_color, uint16_t header_rows, uint16_t footer_rows)
+    : _display(display), _color(color), _bg_color(bg_color), _header_rows(header_rows), _footer_rows(footer_rows),
+      _active(false), _top_fixed(0), _scroll_rows(0), _scroll(0), _columns(0), _lines(0), _col(0), _line(0),
+      _run_len(0), _run_col(0)
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Console::begin
+*
+*   DESCRIPTION:
+*       Sets up the hardware scroll area and clears the text area.
+*       Returns false if the rotation or geometry cannot scroll.
+*
+*********************************************************************/
+bool Console::begin()
+    {
+    const DisplayProperties& props = _display.properties();
+    if (_display.rotation() != ST7789VW::Rotation::ROTATION_0 || _header_rows + _footer_rows + 8 > props.height) {
+        return false;
+    }
+
+    _scroll_rows = (uint16_t)(((props.height - _header_rows - _footer_rows) / 8) * 8);
+    _top_fixed = (uint16_t)(props.y_offset + _header_rows);
+    if (_top_fixed + _scroll_rows > props.map_height) {
+        return false;
+    }
+
+    _columns = props.width / 8;
+    _lines = _scroll_rows / 8;
+    _scroll = 0;
+    _active = true;
+
+    _display.set_scroll_area(_top_fixed, _scroll_rows, (uint16_t)(props.map_height - _top_fixed - _scroll_rows));
+    clear();
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Console::end
+*
+*   DESCRIPTION:
+*       Turns hardware scrolling off. The text area is left as it
+*       sits in memory, so callers normally redraw it afterwards.
+*
+*********************************************************************/
+void Console::end()
+    {
+    if (!_active) {
+        return;
+    }
+    flush();
+
+    uint16_t map_height = _display.properties().map_height;
+    _display.set_scroll_area(0, map_height, 0);
+    _display.set_scroll_start(0);
+    _active = false;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Console::clear
+*
+*   DESCRIPTION:
+*       Clears the text area and homes the cursor
+*
+*********************************************************************/
+void Console::clear()
+    {
+    if (!_active) {
+        return;
+    }
+
+    _run_len = 0;
+    _scroll = 0;
+    _col = 0;
+    _line = 0;
+    _display.set_scroll_start(_top_fixed);
+    _display.fill_rect(0, _header_rows, _display.width(), _scroll_rows, _bg_color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Console::set_colors
+*
+*   DESCRIPTION:
+*       Sets the colors used for text written from now on
+*
+*********************************************************************/
+void Console::set_colors(uint16_t color, uint16_t bg_color)
+    {
+    flush();
+    _color = color;
+    _bg_color = bg_color;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Console::write
+*
+*   DESCRIPTION:
+*       Writes a string to the console
+*
+*********************************************************************/
+void Console::write(const char* text)
+    {
+    while (*text) {
+        put_char(*text++);
+    }
+    flush();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Console::put_char
+*
+*   DESCRIPTION:
+*       Adds one character. Printable characters are held in a run
+*       that is drawn when the line changes, on flush(), or when
+*       write() returns.
+*
+*********************************************************************/
+void Console::put_char(char c)
+    {
+    if (!_active) {
+        return;
+    }
+
+    switch (c) {
+        case '\n':
+            flush();
+            newLine();
+            return;
+        case '\r':
+            flush();
+            _col = 0;
+            return;
+        case '\t':
+            do {
+                put_char(' ');
+            } while (_col % CONSOLE_TAB_COLUMNS != 0 && _col != 0);
+            return;
+        default:
+            break;
+    }
+
+    if (_col >= _columns) {
+        flush();
+        newLine();
+    }
+    if (_run_len == 0) {
+        _run_col = _col;
+    }
+    _run[_run_len++] = c;
+    _col++;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Console::lineY
+*
+*   DESCRIPTION:
+*       Screen y of a text line, accounting for the scroll offset
+*
+*********************************************************************/
+uint16_t Console::lineY(uint16_t line) const
+    {
+    return (uint16_t)(_header_rows + (_scroll + line * 8) % _scroll_rows);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Console::flush
+*
+*   DESCRIPTION:
+*       Draws the pending run of characters as one opaque text burst,
+*       so text added with put_char() shows without ending the line
+*
+*********************************************************************/
+void Console::flush()
+    {
+    if (_run_len == 0) {
+        return;
+    }
+    _run[_run_len] = '\0';
+    _display.write_string_pos((uint16_t)(_run_col * 8), lineY(_line), _run, _color, _bg_color);
+    _run_len = 0;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Console::newLine
+*
+*   DESCRIPTION:
+*       Moves to the next line. On the last line the scroll area is
+*       advanced by one text line and the line that appears is cleared.
+*
+*********************************************************************/
+void Console::newLine()
+    {
+    _col = 0;
+    if (_line + 1 < _lines) {
+        _line++;
+        return;
+    }
+
+    _scroll = (uint16_t)((_scroll + 8) % _scroll_rows);
+    _display.set_scroll_start((uint16_t)(_top_fixed + _scroll));
+    _display.fill_rect(0, lineY(_line), _display.width(), 8, _bg_color);
+    }
@@ -0,0 +1,77 @@
+#ifndef CONSOLE_HPP
+#define CONSOLE_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       scrolling text console using the ST7789 hardware vertical
+*       scroll (VSCRDEF/VSCSAD)
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t CONSOLE_TAB_COLUMNS = 4;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* The text area sits between header_rows at the top and footer_rows
+   at the bottom, which stay put and can be drawn with the normal API.
+   The text area height is rounded down to whole 8 pixel lines and the
+   remainder added to the footer. Hardware scrolling runs along the
+   panel's native rows, so begin() needs ROTATION_0. */
+class Console {
+    public:
+        Console(ST7789VW& display, uint16_t color, uint16_t bg_color, uint16_t header_rows = 0, uint16_t footer_rows = 0);
+
+        bool begin();
+        void end();
+
+        void clear();
+        void set_colors(uint16_t color, uint16_t bg_color);
+
+        /* handles '\n', '\r' and '\t'; long lines wrap. put_char()
+           holds characters until the line ends or flush() draws
+           them; write() flushes before it returns */
+        void write(const char* text);
+        void put_char(char c);
+        void flush();
+
+        uint16_t columns() const { return _columns; }
+        uint16_t lines() const { return _lines; }
+
+        Console (const Console&) = delete;
+        Console& operator= (const Console&) = delete;
+
+    private:
+        uint16_t lineY(uint16_t line) const;
+        void newLine();
+
+        ST7789VW& _display;
+        uint16_t _color;
+        uint16_t _bg_color;
+        uint16_t _header_rows;
+        uint16_t _footer_rows;
+
+        bool _active;
+        uint16_t _top_fixed;        /* panel memory rows above the scroll area */
+        uint16_t _scroll_rows;
+        uint16_t _scroll;           /* pixel offset of line 0 within the area */
+        uint16_t _columns;
+        uint16_t _lines;
+        uint16_t _col;
+        uint16_t _line;
+
+        char _run[DISPLAY_MAX_LINE_PIXELS / 8 + 1];
+        uint16_t _run_len;
+        uint16_t _run_col;
+};
+
+#endif // CONSOLE_HPP
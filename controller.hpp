@@ -0,0 +1,180 @@
+#ifndef CONTROLLER_HPP
+#define CONTROLLER_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       panel geometry and controller traits (init tables, MADCTL
+*       values, rotation offsets) for ST7789, ST7735 and ILI9341
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+/* init tables are a list of steps: command, parameter count (OR'd with
+   CTRL_DELAY when a delay in ms follows the parameters), parameters */
+constexpr uint8_t CTRL_DELAY = 0x80;
+constexpr uint8_t CTRL_FORMAT = 0x00;       /* NOP slot: COLMOD and MADCTL are sent here */
+
+constexpr uint8_t MADCTL_MY = 0x80;         /* row address order    */
+constexpr uint8_t MADCTL_MX = 0x40;         /* column address order */
+constexpr uint8_t MADCTL_MV = 0x20;         /* row/column exchange  */
+constexpr uint8_t MADCTL_BGR = 0x08;
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint16_t map_width;
+    uint16_t map_height;
+    uint16_t x_offset;
+    uint16_t y_offset;
+} DisplayProperties;
+
+/* runtime view of a controller's traits, see ST7789Controller */
+typedef struct {
+    const uint8_t* init;
+    uint16_t init_len;
+    uint8_t madctl[4];              /* per rotation, 0/90/180/270       */
+    uint8_t colmod_rgb565;
+    uint8_t colmod_rgb444;          /* 0 when 12-bit is not supported   */
+    DisplayProperties (*rotate)(const DisplayProperties& props, uint8_t rotation);
+} ControllerInfo;
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/* screen geometry for a MADCTL value, given the geometry at madctl0.
+   Each address order that differs from madctl0 mirrors the offset
+   within the controller memory, and MV swaps the screen axes (the
+   map stays in memory rows and columns). */
+constexpr DisplayProperties rotate_by_madctl(const DisplayProperties& props, uint8_t madctl0, uint8_t madctl)
+    {
+    uint8_t flip = madctl0 ^ madctl;
+    uint16_t col_offset = (flip & MADCTL_MX) ? (uint16_t)(props.map_width - props.width - props.x_offset) : props.x_offset;
+    uint16_t row_offset = (flip & MADCTL_MY) ? (uint16_t)(props.map_height - props.height - props.y_offset) : props.y_offset;
+
+    if (madctl & MADCTL_MV) {
+        return {props.height, props.width, props.map_width, props.map_height, row_offset, col_offset};
+    }
+    return {props.width, props.height, props.map_width, props.map_height, col_offset, row_offset};
+    }
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* Controller traits: everything that differs between controllers is
+   constexpr data here; the drawing code is shared. All three use the
+   MIPI DCS CASET/RASET/RAMWR/MADCTL/COLMOD/VSCRDEF/VSCSAD/TE opcodes. */
+struct ST7789Controller {
+    static constexpr uint8_t init[] = {
+        0x01, CTRL_DELAY | 0, 150,          /* SWRESET  */
+        0x11, CTRL_DELAY | 0, 50,           /* SLPOUT   */
+        CTRL_FORMAT, 0,
+        0x13, 0,                            /* NORON    */
+        0x21, 0,                            /* INVON    */
+    };
+
+    /* rotated offsets carry the +1 column/row the 240x280 module needs */
+    static constexpr DisplayProperties rotate(const DisplayProperties& props, uint8_t rotation)
+        {
+        switch (rotation & 3) {
+            case 1:
+                return {props.height, props.width, props.map_width, props.map_height, props.y_offset, (uint16_t)(props.x_offset + 1)};
+            case 2:
+                return {props.width, props.height, props.map_width, props.map_height, (uint16_t)(props.x_offset + 1), props.y_offset};
+            case 3:
+                return {props.height, props.width, props.map_width, props.map_height, props.y_offset, props.x_offset};
+            default:
+                return props;
+        }
+        }
+
+    static constexpr ControllerInfo info = {init, sizeof(init), {0x00, 0x60, 0xC0, 0xA0}, 0x55, 0x53, rotate};
+};
+
+struct ST7735Controller {
+    static constexpr uint8_t init[] = {
+        0x01, CTRL_DELAY | 0, 150,          /* SWRESET  */
+        0x11, CTRL_DELAY | 0, 120,          /* SLPOUT   */
+        0xB1, 3, 0x01, 0x2C, 0x2D,          /* FRMCTR1  */
+        0xB2, 3, 0x01, 0x2C, 0x2D,          /* FRMCTR2  */
+        0xB3, 6, 0x01, 0x2C, 0x2D, 0x01, 0x2C, 0x2D,
+        0xB4, 1, 0x07,                      /* INVCTR   */
+        0xC0, 3, 0xA2, 0x02, 0x84,          /* PWCTR1-5 */
+        0xC1, 1, 0xC5,
+        0xC2, 2, 0x0A, 0x00,
+        0xC3, 2, 0x8A, 0x2A,
+        0xC4, 2, 0x8A, 0xEE,
+        0xC5, 1, 0x0E,                      /* VMCTR1   */
+        0x20, 0,                            /* INVOFF   */
+        CTRL_FORMAT, 0,
+        0xE0, 16, 0x02, 0x1C, 0x07, 0x12, 0x37, 0x32, 0x29, 0x2D,
+                  0x29, 0x25, 0x2B, 0x39, 0x00, 0x01, 0x03, 0x10,
+        0xE1, 16, 0x03, 0x1D, 0x07, 0x06, 0x2E, 0x2C, 0x29, 0x2D,
+                  0x2E, 0x2E, 0x37, 0x3F, 0x00, 0x00, 0x02, 0x10,
+        0x13, CTRL_DELAY | 0, 10,           /* NORON    */
+    };
+
+    static constexpr uint8_t madctl[4] = {
+        MADCTL_MX | MADCTL_MY, MADCTL_MY | MADCTL_MV, 0x00, MADCTL_MX | MADCTL_MV
+    };
+
+    static constexpr DisplayProperties rotate(const DisplayProperties& props, uint8_t rotation)
+        {
+        return rotate_by_madctl(props, madctl[0], madctl[rotation & 3]);
+        }
+
+    static constexpr ControllerInfo info = {init, sizeof(init), {madctl[0], madctl[1], madctl[2], madctl[3]}, 0x05, 0x03, rotate};
+};
+
+struct ILI9341Controller {
+    static constexpr uint8_t init[] = {
+        0x01, CTRL_DELAY | 0, 150,          /* SWRESET              */
+        0xEF, 3, 0x03, 0x80, 0x02,
+        0xCF, 3, 0x00, 0xC1, 0x30,          /* power control B      */
+        0xED, 4, 0x64, 0x03, 0x12, 0x81,    /* power on sequence    */
+        0xE8, 3, 0x85, 0x00, 0x78,          /* driver timing A      */
+        0xCB, 5, 0x39, 0x2C, 0x00, 0x34, 0x02,
+        0xF7, 1, 0x20,                      /* pump ratio           */
+        0xEA, 2, 0x00, 0x00,                /* driver timing B      */
+        0xC0, 1, 0x23,                      /* PWCTR1               */
+        0xC1, 1, 0x10,                      /* PWCTR2               */
+        0xC5, 2, 0x3E, 0x28,                /* VMCTR1               */
+        0xC7, 1, 0x86,                      /* VMCTR2               */
+        CTRL_FORMAT, 0,
+        0xB1, 2, 0x00, 0x18,                /* FRMCTR1, 79 Hz       */
+        0xB6, 3, 0x08, 0x82, 0x27,          /* display function     */
+        0xF2, 1, 0x00,                      /* 3-gamma off          */
+        0x26, 1, 0x01,                      /* gamma curve 1        */
+        0xE0, 15, 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
+                  0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,
+        0xE1, 15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
+                  0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,
+        0x11, CTRL_DELAY | 0, 150,          /* SLPOUT               */
+    };
+
+    static constexpr uint8_t madctl[4] = {
+        MADCTL_MX | MADCTL_BGR, MADCTL_MV | MADCTL_BGR,
+        MADCTL_MY | MADCTL_BGR, MADCTL_MX | MADCTL_MY | MADCTL_MV | MADCTL_BGR
+    };
+
+    static constexpr DisplayProperties rotate(const DisplayProperties& props, uint8_t rotation)
+        {
+        return rotate_by_madctl(props, madctl[0], madctl[rotation & 3]);
+        }
+
+    /* no 12-bit interface format; RGB444 requests are ignored */
+    static constexpr ControllerInfo info = {init, sizeof(init), {madctl[0], madctl[1], madctl[2], madctl[3]}, 0x55, 0x00, rotate};
+};
+
+#endif // CONTROLLER_HPP
@@ -15,8 +15,8 @@
 --------------------------------------------------------------------*/
 #include "displayAPI.hpp"
 #include "font.hpp"
-#include "hardware/gpio.h"
 #include <stdio.h>
+#include <string.h>
 
 /*--------------------------------------------------------------------
                           GLOBAL NAMESPACES
@@ -25,6 +25,10 @@
 /*--------------------------------------------------------------------
                           LITERAL CONSTANTS
 --------------------------------------------------------------------*/
+constexpr uint32_t RESET_PULSE_MS = 10;
+constexpr uint32_t RESET_RECOVERY_MS = 120;
+constexpr uint32_t DISPLAY_ON_MS = 50;
+constexpr uint32_t INIT_DONE = 0xFFFFFFFF;     /* initStep(): nothing left to wait for */
 
 /*--------------------------------------------------------------------
                                 TYPES
@@ -45,6 +49,31 @@
 /*--------------------------------------------------------------------
                               PROCEDURES
 --------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       supportedProps
+*
+*   DESCRIPTION:
+*       Clamps the panel to the sides the line buffer and the dirty
+*       tracker hold. Either side can become the height once rotated,
+*       so both are held to the smaller limit; pixels past it are
+*       never drawn rather than drawn untracked or overrunning a
+*       buffer.
+*
+*********************************************************************/
+static DisplayProperties supportedProps(DisplayProperties props)
+    {
+    const uint16_t max_side = (DISPLAY_MAX_LINE_PIXELS < FRAMEBUFFER_MAX_ROWS) ? DISPLAY_MAX_LINE_PIXELS : FRAMEBUFFER_MAX_ROWS;
+    if (props.width > max_side) {
+        props.width = max_side;
+    }
+    if (props.height > max_side) {
+        props.height = max_side;
+    }
+    return props;
+    }
+
 /*********************************************************************
 *
 *   PROCEDURE NAME:
@@ -54,9 +83,43 @@
 *       ST7789VW class constructor
 *
 *********************************************************************/
-ST7789VW::ST7789VW(spi_inst_t* spi, DisplayProperties props, uint cs_pin, uint dc_pin, uint rst_pin, uint bl_pin)
-    : _spi(spi), _props(props), _default_props(props), _cs_pin(cs_pin), _dc_pin(dc_pin), _rst_pin(rst_pin), _bl_pin(bl_pin), _last_x(0), _last_y(0)
+#if !defined(DISPLAYAPI_HOST)
+ST7789VW::ST7789VW(spi_inst_t* spi, DisplayProperties props, uint cs_pin, uint dc_pin, uint rst_pin, uint bl_pin,
+                   const ControllerInfo& controller)
+    : _pico_transport(spi, cs_pin, dc_pin, rst_pin, bl_pin), _transport(_pico_transport), _controller(controller), _props(supportedProps(props)), _default_props(supportedProps(props)), _rotation(Rotation::ROTATION_0), _last_x(0), _last_y(0), _async(false), _burst_open(false), _line_index(0), _color_mode(ColorMode::RGB565), _pack_carry(false), _pack_pixel(0), _pack_index(0), _fb(nullptr), _fb_y(0), _fb_rows(0), _fb_pixels(0), _fb_tracked(false), _saved_fb(nullptr), _saved_fb_tracked(false), _glyph_cache(nullptr), _dither(Dither::NONE), _font(&font_8x8), _font_scale(1), _win(), _win_col(0), _win_row(0),
+      _view(), _view_stack(), _view_depth(0), _clipping(false), _src_width(0), _src_col(0), _src_row(0), _keep(), _shadow(), _command_stats(),
+      _init_phase(InitPhase::IDLE), _init_pos(0), _init_clock_started(false), _init_start_us(0), _init_deadline_us(0), _init_time_us(0)
+#if defined(DISPLAYAPI_INSTRUMENTATION)
+      , _instr(_transport)
+#endif
+    {
+    reset_clip();
+    }
+#endif
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::ST7789VW (constructor)
+*
+*   DESCRIPTION:
+*       ST7789VW class constructor for an externally owned transport
+*
+*********************************************************************/
+ST7789VW::ST7789VW(DisplayTransport& transport, DisplayProperties props, const ControllerInfo& controller)
+#if !defined(DISPLAYAPI_HOST)
+    : _pico_transport(nullptr, 0, 0, 0, 0), _transport(transport), _controller(controller),
+#else
+    : _transport(transport), _controller(controller),
+#endif
+      _props(supportedProps(props)), _default_props(supportedProps(props)), _rotation(Rotation::ROTATION_0), _last_x(0), _last_y(0), _async(false), _burst_open(false), _line_index(0), _color_mode(ColorMode::RGB565), _pack_carry(false), _pack_pixel(0), _pack_index(0), _fb(nullptr), _fb_y(0), _fb_rows(0), _fb_pixels(0), _fb_tracked(false), _saved_fb(nullptr), _saved_fb_tracked(false), _glyph_cache(nullptr), _dither(Dither::NONE), _font(&font_8x8), _font_scale(1), _win(), _win_col(0), _win_row(0),
+      _view(), _view_stack(), _view_depth(0), _clipping(false), _src_width(0), _src_col(0), _src_row(0), _keep(), _shadow(), _command_stats(),
+      _init_phase(InitPhase::IDLE), _init_pos(0), _init_clock_started(false), _init_start_us(0), _init_deadline_us(0), _init_time_us(0)
+#if defined(DISPLAYAPI_INSTRUMENTATION)
+      , _instr(_transport)
+#endif
     {
+    reset_clip();
     }
 
 /*********************************************************************
@@ -70,6 +133,7 @@ ST7789VW::ST7789VW(spi_inst_t* spi, DisplayProperties props, uint cs_pin, uint d
 *********************************************************************/
 ST7789VW::~ST7789VW( void )
     {
+    finishBurst();
     }
 
 /*********************************************************************
@@ -78,49 +142,140 @@ ST7789VW::~ST7789VW( void )
 *       ST7789VW::init
 *
 *   DESCRIPTION:
-*       Initializes the display
+*       Initializes the display, sleeping through the sequence's
+*       delays
+*
+*********************************************************************/
+void ST7789VW::init(bool hardware_reset)
+    {
+    uint64_t start = _transport.now_us();
+    begin_init(hardware_reset);
+    for (uint32_t ms = initStep(); ms != INIT_DONE; ms = initStep()) {
+        _transport.delay_ms(ms);
+    }
+    _init_time_us = (uint32_t)(_transport.now_us() - start);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::begin_init
+*
+*   DESCRIPTION:
+*       Starts the init sequence for poll() (or init()) to run
 *
 *********************************************************************/
-void ST7789VW::init()
+void ST7789VW::begin_init(bool hardware_reset)
     {
-    gpio_init(_cs_pin);
-    gpio_set_dir(_cs_pin, GPIO_OUT);
-    gpio_put(_cs_pin, 1);
+    _transport.init();
+    _init_phase = hardware_reset ? InitPhase::RESET : InitPhase::TABLE;
+    _init_pos = 0;
+    _init_clock_started = false;
+    }
 
-    gpio_init(_dc_pin);
-    gpio_set_dir(_dc_pin, GPIO_OUT);
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::poll
+*
+*   DESCRIPTION:
+*       Advances the init sequence on the transport's clock
+*
+*********************************************************************/
+bool ST7789VW::poll()
+    {
+    return poll(_transport.now_us());
+    }
 
-    gpio_init(_rst_pin);
-    gpio_set_dir(_rst_pin, GPIO_OUT);
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::poll (clock)
+*
+*   DESCRIPTION:
+*       Sends every init step that is due at now_us. Returns true
+*       once the sequence has finished (or none was started).
+*
+*********************************************************************/
+bool ST7789VW::poll(uint64_t now_us)
+    {
+    if (_init_phase == InitPhase::IDLE) {
+        return true;
+    }
+    if (!_init_clock_started) {
+        _init_clock_started = true;
+        _init_start_us = now_us;
+        _init_deadline_us = now_us;
+    }
 
-    if( _bl_pin != 0 )
-        {
-        gpio_init(_bl_pin);
-        gpio_set_dir(_bl_pin, GPIO_OUT);
-        gpio_put(_bl_pin, 1);
+    while (now_us >= _init_deadline_us) {
+        uint32_t ms = initStep();
+        if (ms == INIT_DONE) {
+            _init_time_us = (uint32_t)(now_us - _init_start_us);
+            return true;
         }
+        _init_deadline_us = now_us + (uint64_t)ms * 1000u;
+    }
+    return false;
+    }
 
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::initStep
+*
+*   DESCRIPTION:
+*       Runs the init sequence up to its next delay and returns that
+*       delay in ms, or INIT_DONE once the display is on. The table
+*       is the controller's (see controller.hpp); around it sit the
+*       reset pulse and DISPON.
+*
+*********************************************************************/
+uint32_t ST7789VW::initStep()
+    {
+    switch (_init_phase) {
+        case InitPhase::RESET:
+            _transport.set_reset(false);
+            _init_phase = InitPhase::RESET_RELEASE;
+            return RESET_PULSE_MS;
 
-    reset();
+        case InitPhase::RESET_RELEASE:
+            _transport.set_reset(true);
+            _init_phase = InitPhase::TABLE;
+            return RESET_RECOVERY_MS;
 
-    sendCommand(ST7789VW_CMD::SWRESET);
-    sleep_ms(150);
+        case InitPhase::TABLE:
+            while (_init_pos < _controller.init_len) {
+                const uint8_t* step = &_controller.init[_init_pos];
+                uint8_t cmd = step[0];
+                uint8_t len = (uint8_t)(step[1] & ~CTRL_DELAY);
+                _init_pos += 2 + len;
 
-    sendCommand(ST7789VW_CMD::SLPOUT);
-    sleep_ms(50);
+                if (cmd == CTRL_FORMAT) {
+                    uint8_t colmod_data[] = {colmodValue(_color_mode)};
+                    sendCachedCommand(ST7789VW_CMD::COLMOD, colmod_data, sizeof(colmod_data), _shadow.colmod, _shadow.colmod_valid);
 
-    sendCommand(ST7789VW_CMD::COLMOD);
-    uint8_t colmod_data[] = {0x55}; // 16-bit/pixel
-    sendData(colmod_data, sizeof(colmod_data));
+                    uint8_t madctl_data[] = {_controller.madctl[(uint8_t)_rotation]};
+                    sendCachedCommand(ST7789VW_CMD::MADCTL, madctl_data, sizeof(madctl_data), _shadow.madctl, _shadow.madctl_valid);
+                } else {
+                    sendCommand((ST7789VW_CMD)cmd, &step[2], len);
+                    if (cmd == (uint8_t)ST7789VW_CMD::SWRESET) {
+                        _shadow = ControllerShadow();
+                    }
+                }
 
-    sendCommand(ST7789VW_CMD::MADCTL);
-    uint8_t madctl_data[] = {0x00};
-    sendData(madctl_data, sizeof(madctl_data));
+                if (step[1] & CTRL_DELAY) {
+                    return _controller.init[_init_pos++];
+                }
+            }
+            toggleDisplay(true);
+            _init_phase = InitPhase::DISPLAY_ON;
+            return DISPLAY_ON_MS;
 
-    sendCommand(ST7789VW_CMD::NORON);
-    sendCommand(ST7789VW_CMD::INVON);
-    sendCommand(ST7789VW_CMD::DISPON);
-    sleep_ms(50);
+        default:
+            _init_phase = InitPhase::IDLE;
+            return INIT_DONE;
+    }
     }
 
 /*********************************************************************
@@ -129,7 +284,10 @@ void ST7789VW::init()
 *       ST7789VW::setWindow
 *
 *   DESCRIPTION:
-*       Sets the drawing window
+*       Sets the drawing window and opens the RAMWR data burst.
+*       CASET/RASET are skipped when the controller already holds
+*       the same addresses; RAMWR is always needed to restart the
+*       write pointer and shares its CS assertion with the pixels.
 *
 *********************************************************************/
 void ST7789VW::setWindow(uint16_t x, uint16_t y, uint16_t width, uint16_t height)
@@ -139,15 +297,22 @@ void ST7789VW::setWindow(uint16_t x, uint16_t y, uint16_t width, uint16_t height
     uint16_t x_end = x + width - 1 + _props.x_offset;
     uint16_t y_end = y + height - 1 + _props.y_offset;
 
-    sendCommand(ST7789VW_CMD::CASET);
     uint8_t caset_data[] = {(uint8_t)(x_start >> 8), (uint8_t)x_start, (uint8_t)(x_end >> 8), (uint8_t)x_end};
-    sendData(caset_data, sizeof(caset_data));
+    sendCachedCommand(ST7789VW_CMD::CASET, caset_data, sizeof(caset_data), _shadow.caset, _shadow.caset_valid);
 
-    sendCommand(ST7789VW_CMD::RASET);
     uint8_t raset_data[] = {(uint8_t)(y_start >> 8), (uint8_t)y_start, (uint8_t)(y_end >> 8), (uint8_t)y_end};
-    sendData(raset_data, sizeof(raset_data));
+    sendCachedCommand(ST7789VW_CMD::RASET, raset_data, sizeof(raset_data), _shadow.raset, _shadow.raset_valid);
 
-    sendCommand(ST7789VW_CMD::RAMWR);
+    uint8_t cmd_val = static_cast<uint8_t>(ST7789VW_CMD::RAMWR);
+    finishBurst();
+    _transport.select();
+    DISPLAY_INSTR(_instr, on_select());
+    _transport.set_dc(false);
+    DISPLAY_INSTR_TIME(_instr, start);
+    _transport.write(&cmd_val, 1);
+    DISPLAY_INSTR(_instr, on_command(start));
+    _transport.set_dc(true);
+    _command_stats.sent++;
     }
 
 /*********************************************************************
@@ -159,11 +324,17 @@ void ST7789VW::setWindow(uint16_t x, uint16_t y, uint16_t width, uint16_t height
 *       Draws a single pixel
 *
 *********************************************************************/
-void ST7789VW::drawPixel(uint16_t x, uint16_t y, uint16_t color)
+void ST7789VW::drawPixel(int16_t x, int16_t y, uint16_t color)
     {
-    setWindow(x, y, 1, 1);
-    uint8_t pixel_data[] = {(uint8_t)(color >> 8), (uint8_t)color};
-    sendData(pixel_data, sizeof(pixel_data));
+    uint8_t* buf = nextLineBuffer();
+    buf[0] = (uint8_t)(color >> 8);
+    buf[1] = (uint8_t)color;
+
+    if (!beginPixels(screenX(x), screenY(y), 1, 1)) {
+        return;
+    }
+    pushPixels(buf, 1);
+    endPixels();
     }
 
 /*********************************************************************
@@ -172,41 +343,107 @@ void ST7789VW::drawPixel(uint16_t x, uint16_t y, uint16_t color)
 *       ST7789VW::fill
 *
 *   DESCRIPTION:
-*       Fills the screen with a color
+*       Fills the current viewport (the screen by default) with a
+*       color
 *
 *********************************************************************/
 void ST7789VW::fill(uint16_t color)
     {
-    setWindow(0, 0, _props.width, _props.height);
-    uint32_t num_pixels = _props.width * _props.height;
-    uint8_t pixel_data[] = {(uint8_t)(color >> 8), (uint8_t)color};
+    fill_rect(0, 0, _view.width, _view.height, color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::fill_rect
+*
+*   DESCRIPTION:
+*       Fills a rectangle of the current viewport with a color
+*
+*********************************************************************/
+void ST7789VW::fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color)
+    {
+    DISPLAY_INSTR_OP(_instr, DisplayOp::FILL_RECT, x, y, width, height);
+    fillRect(screenX(x), screenY(y), width, height, color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::fillRect
+*
+*   DESCRIPTION:
+*       Fills a rectangle given in screen coordinates, trimmed to the
+*       clip. The color is expanded into the line buffer once and
+*       streamed under a single CS assertion.
+*
+*********************************************************************/
+void ST7789VW::fillRect(int x, int y, int width, int height, uint16_t color)
+    {
+    DisplayRect vis;
+    if (!clipRect(x, y, width, height, vis)) {
+        return;
+    }
+
+    if (!trimToTarget(vis)) {
+        return;
+    }
+
+    uint32_t num_pixels = (uint32_t)vis.width * vis.height;
+    uint32_t buf_pixels = DISPLAY_MAX_LINE_PIXELS;
+    if (buf_pixels > num_pixels) {
+        buf_pixels = num_pixels;
+    }
 
-    for (uint32_t i = 0; i < num_pixels; ++i) {
-        sendData(pixel_data, sizeof(pixel_data));
+    /* the buffer is only read while streaming, so one copy serves every chunk */
+    uint8_t* buf = nextLineBuffer();
+    for (uint32_t i = 0; i < buf_pixels; ++i) {
+        buf[2 * i] = (uint8_t)(color >> 8);
+        buf[2 * i + 1] = (uint8_t)color;
     }
+
+    beginPixels(vis.x, vis.y, vis.width, vis.height);
+    while (num_pixels > 0) {
+        uint32_t chunk = (num_pixels < buf_pixels) ? num_pixels : buf_pixels;
+        pushPixels(buf, chunk);
+        num_pixels -= chunk;
+    }
+    endPixels();
     }
 
 /*********************************************************************
 *
 *   PROCEDURE NAME:
-*       ST7789VW::drawChar
+*       ST7789VW::fill_rect_alpha
 *
 *   DESCRIPTION:
-*       Draws a single character
+*       Blends a color over a rectangle of the RAM target, two pixels
+*       per word. On the panel the fill is solid when alpha is at
+*       least half and skipped otherwise.
 *
 *********************************************************************/
-void ST7789VW::drawChar(uint16_t x, uint16_t y, char c, uint16_t color)
+void ST7789VW::fill_rect_alpha(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color, uint8_t alpha)
     {
-    if (x > _props.width - 8 || y > _props.height - 8) {
+    DISPLAY_INSTR_OP(_instr, DisplayOp::FILL_RECT, x, y, width, height);
+
+    if (_fb == nullptr || alpha == 0xFF) {
+        if (alpha >= 0x80) {
+            fillRect(screenX(x), screenY(y), width, height, color);
+        }
         return;
     }
 
-    for (int i = 0; i < 8; i++) {
-        uint8_t line = font[(int)c][i];
-        for (int j = 0; j < 8; j++) {
-            if ((line >> (7 - j)) & 1) {
-                drawPixel(x + j, y + i, color);
-            }
+    DisplayRect vis;
+    if (alpha == 0 || !clipRect(screenX(x), screenY(y), width, height, vis) || !trimToTarget(vis)) {
+        return;
+    }
+
+    for (uint16_t row = 0; row < vis.height; row++) {
+        uint16_t skip;
+        uint16_t count;
+        uint8_t* dst = ramSpan(vis.x, vis.y + row, vis.width, skip, count);
+        if (dst != nullptr) {
+            blend_wire565(dst, color, alpha, count);
         }
     }
     }
@@ -214,226 +451,1704 @@ void ST7789VW::drawChar(uint16_t x, uint16_t y, char c, uint16_t color)
 /*********************************************************************
 *
 *   PROCEDURE NAME:
-*       ST7789VW::drawText
+*       ST7789VW::draw_mask
 *
 *   DESCRIPTION:
-*       Draws a string of text
+*       Draws an alpha mask in a color over what is already there:
+*       blended into the RAM target, or as solid runs of the pixels
+*       at least half opaque on the panel
 *
 *********************************************************************/
-void ST7789VW::drawText(uint16_t x, uint16_t y, const char* text, uint16_t color)
+void ST7789VW::draw_mask(int16_t x, int16_t y, const AlphaMask& mask, uint16_t color)
     {
-    int i = 0;
-    while (text[i]) {
-        drawChar(x + (i * 8), y, text[i], color);
-        i++;
+    DISPLAY_INSTR_OP(_instr, DisplayOp::BLIT, x, y, mask.width, mask.height);
+
+    int sx = screenX(x);
+    int sy = screenY(y);
+    DisplayRect vis;
+    if (!clipRect(sx, sy, mask.width, mask.height, vis) || !trimToTarget(vis)) {
+        return;
+    }
+
+    uint16_t first_col = (uint16_t)(vis.x - sx);
+    uint16_t first_row = (uint16_t)(vis.y - sy);
+    uint8_t alpha[DISPLAY_MAX_LINE_PIXELS];
+
+    for (uint16_t row = 0; row < vis.height; row++) {
+        const uint8_t* src = alpha_mask_row(mask, first_row + row);
+        for (uint16_t i = 0; i < vis.width; i++) {
+            alpha[i] = alpha_mask_value(mask, src, first_col + i);
+        }
+
+        int py = vis.y + row;
+        if (_fb != nullptr) {
+            uint16_t skip;
+            uint16_t count;
+            uint8_t* dst = ramSpan(vis.x, py, vis.width, skip, count);
+            if (dst != nullptr) {
+                blend_mask_wire565(dst, color, alpha + skip, count);
+            }
+            continue;
+        }
+
+        uint16_t i = 0;
+        while (i < vis.width) {
+            if (alpha[i] < 0x80) {
+                i++;
+                continue;
+            }
+            uint16_t start = i;
+            while (i < vis.width && alpha[i] >= 0x80) {
+                i++;
+            }
+            fillRect(vis.x + start, py, i - start, 1, color);
+        }
     }
     }
 
 /*********************************************************************
 *
 *   PROCEDURE NAME:
-*       ST7789VW::sendCommand
+*       ST7789VW::draw_mask (opaque)
 *
 *   DESCRIPTION:
-*       Sends a command to the display
+*       Draws an alpha mask in a color over a background color. Each
+*       row is composited in the line buffer and streamed, so edges
+*       are smooth on the panel too.
 *
 *********************************************************************/
-void ST7789VW::sendCommand(ST7789VW_CMD cmd)
+void ST7789VW::draw_mask(int16_t x, int16_t y, const AlphaMask& mask, uint16_t color, uint16_t bg_color)
     {
-    uint8_t cmd_val = static_cast<uint8_t>(cmd);
-    gpio_put(_cs_pin, 0);
-    gpio_put(_dc_pin, 0);
-    spi_write_blocking(_spi, &cmd_val, 1);
-    gpio_put(_cs_pin, 1);
+    DISPLAY_INSTR_OP(_instr, DisplayOp::BLIT, x, y, mask.width, mask.height);
+
+    int sx = screenX(x);
+    int sy = screenY(y);
+    DisplayRect vis;
+    if (!clipRect(sx, sy, mask.width, mask.height, vis)) {
+        return;
+    }
+
+    uint16_t first_col = (uint16_t)(vis.x - sx);
+    uint16_t first_row = (uint16_t)(vis.y - sy);
+    uint8_t alpha[DISPLAY_MAX_LINE_PIXELS];
+
+    beginPixels(vis.x, vis.y, vis.width, vis.height);
+    for (uint16_t row = 0; row < vis.height; row++) {
+        const uint8_t* src = alpha_mask_row(mask, first_row + row);
+        uint8_t* buf = nextLineBuffer();
+        for (uint16_t i = 0; i < vis.width; i++) {
+            alpha[i] = alpha_mask_value(mask, src, first_col + i);
+            buf[2 * i] = (uint8_t)(bg_color >> 8);
+            buf[2 * i + 1] = (uint8_t)bg_color;
+        }
+        blend_mask_wire565(buf, color, alpha, vis.width);
+        pushPixels(buf, vis.width);
+    }
+    endPixels();
     }
 
 /*********************************************************************
 *
 *   PROCEDURE NAME:
-*       ST7789VW::sendData
+*       ST7789VW::blit
 *
 *   DESCRIPTION:
-*       Sends data to the display
+*       Draws an image with its top left corner at x, y, clipped to
+*       the clip rectangle. RGB565 data is streamed straight from where
+*       it lives (flash/XIP included) without a RAM copy; packed formats
+*       are decoded row by row into the line buffers, skipping the
+*       clipped columns.
 *
 *********************************************************************/
-void ST7789VW::sendData(const uint8_t* data, size_t len)
+void ST7789VW::blit(int16_t x, int16_t y, const Image& image)
     {
-    gpio_put(_cs_pin, 0);
-    gpio_put(_dc_pin, 1);
-    spi_write_blocking(_spi, data, len);
-    gpio_put(_cs_pin, 1);
+    DISPLAY_INSTR_OP(_instr, DisplayOp::BLIT, x, y, image.width, image.height);
+
+    int sx = screenX(x);
+    int sy = screenY(y);
+    DisplayRect vis;
+    if (!clipRect(sx, sy, image.width, image.height, vis)) {
+        return;
+    }
+
+    uint16_t first_col = (uint16_t)(vis.x - sx);
+    uint16_t first_row = (uint16_t)(vis.y - sy);
+    ImageRowDecoder decoder(image, _dither, (uint16_t)sx, (uint16_t)sy);
+
+    beginPixels(vis.x, vis.y, vis.width, vis.height);
+    if (image.format == ImageFormat::RGB565 && vis.width == image.width) {
+        pushPixels(decoder.raw_row(first_row), (size_t)vis.width * vis.height);
+    } else if (image.format == ImageFormat::RGB565) {
+        for (uint16_t row = 0; row < vis.height; row++) {
+            pushPixels(decoder.raw_row(first_row + row) + first_col * 2, vis.width);
+        }
+    } else {
+        uint8_t* buf = nextLineBuffer();
+        for (uint16_t row = 0; row < first_row; row++) {
+            decoder.decode_row(buf, 0);
+        }
+        for (uint16_t row = 0; row < vis.height; row++) {
+            buf = nextLineBuffer();
+            decoder.decode_row(buf, vis.width, first_col);
+            pushPixels(buf, vis.width);
+        }
+    }
+    endPixels();
     }
 
 /*********************************************************************
 *
 *   PROCEDURE NAME:
-*       ST7789VW::reset
+*       ST7789VW::blit_qoi
 *
 *   DESCRIPTION:
-*       Resets the display
+*       Draws a QOI image as it decodes, one row per line buffer so
+*       the next row decodes while the last one is on the bus. Rows
+*       above the clip are decoded and dropped, rows below it are
+*       never read. A stream that ends early still fills the window
+*       (with black) and returns false.
 *
 *********************************************************************/
-void ST7789VW::reset()
+bool ST7789VW::blit_qoi(int16_t x, int16_t y, QoiDecoder& decoder)
     {
-    gpio_put(_rst_pin, 0);
-    sleep_ms(10);
-    gpio_put(_rst_pin, 1);
-    sleep_ms(120);
+    if (decoder.width() == 0 && !decoder.read_header()) {
+        return false;
+    }
+
+    DISPLAY_INSTR_OP(_instr, DisplayOp::BLIT, x, y, decoder.width(), decoder.height());
+
+    int sx = screenX(x);
+    int sy = screenY(y);
+    DisplayRect vis;
+    if (!clipRect(sx, sy, decoder.width(), decoder.height(), vis)) {
+        return true;
+    }
+
+    uint16_t first_col = (uint16_t)(vis.x - sx);
+    uint16_t first_row = (uint16_t)(vis.y - sy);
+    bool ok = true;
+
+    uint8_t* buf = nextLineBuffer();
+    for (uint16_t row = 0; row < first_row; row++) {
+        ok = decoder.decode_row(buf, 0) && ok;
+    }
+
+    beginPixels(vis.x, vis.y, vis.width, vis.height);
+    for (uint16_t row = 0; row < vis.height; row++) {
+        buf = nextLineBuffer();
+        ok = decoder.decode_row(buf, vis.width, first_col) && ok;
+        pushPixels(buf, vis.width);
+    }
+    endPixels();
+    return ok;
     }
 
 /*********************************************************************
 *
 *   PROCEDURE NAME:
-*       ST7789VW::clear_screen
+*       ST7789VW::drawChar
 *
 *   DESCRIPTION:
-*       Clears the screen
+*       Draws a single character in the current font without a
+*       background. Each run of set pixels in a glyph row goes out as
+*       one burst, scale pixels tall.
 *
 *********************************************************************/
-void ST7789VW::clear_screen()
+void ST7789VW::drawChar(int16_t x, int16_t y, char c, uint16_t color)
     {
-    fill(0x0000); //black color
+    int sx = screenX(x);
+    int sy = screenY(y);
+    DisplayRect vis;
+    if (!clipRect(sx, sy, charAdvance(c), line_height(), vis)) {
+        return;
+    }
+
+    if (_font->bpp > 1 && _fb != nullptr) {
+        drawCharBlended(sx, sy, c, color);
+        return;
+    }
+
+    const FontGlyph& glyph = font_glyph(*_font, c);
+    uint16_t scale = _font_scale;
+
+    for (uint16_t row = 0; row < glyph.height; row++) {
+        int py = sy + (glyph.y_offset + row) * scale;
+        uint16_t col = 0;
+        while (col < glyph.width) {
+            if (!font_glyph_bit(*_font, glyph, col, row)) {
+                col++;
+                continue;
+            }
+            uint16_t start = col;
+            while (col < glyph.width && font_glyph_bit(*_font, glyph, col, row)) {
+                col++;
+            }
+
+            int px = sx + (glyph.x_offset + start) * scale;
+            fillRect(px, py, (col - start) * scale, scale, color);
+        }
+    }
     }
 
 /*********************************************************************
 *
 *   PROCEDURE NAME:
-*       ST7789VW::write_string_pos
+*       ST7789VW::drawCharBlended
 *
 *   DESCRIPTION:
-*       Writes a string at a specific position
+*       Blends an anti-aliased glyph at screen position x, y into the
+*       RAM target, one coverage row at a time
 *
 *********************************************************************/
-bool ST7789VW::write_string_pos(uint16_t x, uint16_t y, const char* text, uint16_t color, bool word_wrap)
+void ST7789VW::drawCharBlended(int x, int y, char c, uint16_t color)
     {
-    uint16_t current_x = x;
-    uint16_t current_y = y;
-    int i = 0;
-    while (text[i]) {
-        if (word_wrap) {
-            const char* word_start = &text[i];
-            int word_len = 0;
-            while (text[i] && text[i] != ' ') {
-                word_len++;
-                i++;
-            }
+    const FontGlyph& glyph = font_glyph(*_font, c);
+    uint16_t scale = _font_scale;
+    int width = glyph.width * scale;
+    if (width > DISPLAY_MAX_LINE_PIXELS) {
+        width = DISPLAY_MAX_LINE_PIXELS;
+    }
 
-            if (current_x + (word_len * 8) > _props.width) {
-                current_x = x;
-                current_y += 8;
-            }
+    int px = x + glyph.x_offset * scale;
+    uint8_t alpha[DISPLAY_MAX_LINE_PIXELS];
+    for (uint16_t row = 0; row < glyph.height; row++) {
+        int py = y + (glyph.y_offset + row) * scale;
+        for (int i = 0; i < width; i++) {
+            alpha[i] = font_glyph_alpha(*_font, glyph, (uint16_t)(i / scale), row);
+        }
 
-            for (int j = 0; j < word_len; j++) {
-                drawChar(current_x, current_y, word_start[j], color);
-                current_x += 8;
+        for (uint16_t s = 0; s < scale; s++) {
+            uint16_t skip;
+            uint16_t count;
+            uint8_t* dst = ramSpan(px, py + s, width, skip, count);
+            if (dst != nullptr) {
+                blend_mask_wire565(dst, color, alpha + skip, count);
             }
+        }
+    }
+    }
 
-            if (text[i] == ' ') {
-                drawChar(current_x, current_y, ' ', color);
-                current_x += 8;
-                i++;
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::drawChar (opaque)
+*
+*   DESCRIPTION:
+*       Draws a single character with a background color as one 8x8
+*       windowed burst
+*
+*********************************************************************/
+void ST7789VW::drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg_color)
+    {
+    drawTextRun(x, y, &c, 1, color, bg_color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::drawTextRun
+*
+*   DESCRIPTION:
+*       Draws a run of characters on one text line with a background
+*       color. One window covers the visible part of the run (up to a
+*       line buffer of characters) and each of the 8 glyph rows is
+*       expanded into the line buffer (or copied from the glyph cache)
+*       and streamed in the same burst. Characters outside the clip are
+*       never expanded; ones cut by its edge are clipped per pixel.
+*
+*********************************************************************/
+void ST7789VW::drawTextRun(int16_t x, int16_t y, const char* text, size_t len, uint16_t color, uint16_t bg_color)
+    {
+    if (_font != &font_8x8 || _font_scale != 1) {
+        drawFontRun(x, y, text, len, color, bg_color);
+        return;
+    }
+
+    const size_t max_chunk = DISPLAY_MAX_LINE_PIXELS / 8;
+    int sx = screenX(x);
+    int sy = screenY(y);
+    if (len > UINT16_MAX / 8) {
+        len = UINT16_MAX / 8;
+    }
+
+    DisplayRect vis;
+    if (!clipRect(sx, sy, (int)len * 8, 8, vis)) {
+        return;
+    }
+
+    size_t first = (size_t)(vis.x - sx) / 8;
+    size_t end = (size_t)(vis.x + vis.width - sx + 7) / 8;
+
+    for (size_t start = first; start < end; start += max_chunk) {
+        size_t n = end - start;
+        if (n > max_chunk) {
+            n = max_chunk;
+        }
+        const char* run = text + start;
+
+        const uint8_t* glyphs[max_chunk] = {};
+        if (_glyph_cache) {
+            _glyph_cache->begin_run();
+            for (size_t k = 0; k < n; k++) {
+                glyphs[k] = _glyph_cache->lookup(run[k], color, bg_color);
             }
+        }
 
-        } else {
-            if (current_x + 8 > _props.width) {
-                current_x = x;
-                current_y += 8;
+        beginPixels(sx + (int)start * 8, sy, (uint16_t)(n * 8), 8);
+        for (int i = 0; i < 8; i++) {
+            uint8_t* buf = nextLineBuffer();
+            uint8_t* out = buf;
+            for (size_t k = 0; k < n; k++) {
+                if (glyphs[k]) {
+                    memcpy(out, glyphs[k] + i * 16, 16);
+                } else {
+                    expand_glyph_row(out, font[(uint8_t)run[k]][i], color, bg_color);
+                }
+                out += 16;
             }
-            drawChar(current_x, current_y, text[i], color);
-            current_x += 8;
-            i++;
+            pushPixels(buf, n * 8);
         }
+        endPixels();
     }
-    _last_x = current_x;
-    _last_y = current_y;
-    return true;
     }
 
 /*********************************************************************
 *
 *   PROCEDURE NAME:
-*       ST7789VW::write_string
+*       ST7789VW::drawFontRun
 *
 *   DESCRIPTION:
-*       Writes a string
+*       drawTextRun for any font and scale. Each font row is expanded
+*       once across the run, every source pixel repeated scale times,
+*       and the buffer is sent scale times. Anti-aliased coverage
+*       picks from a ramp of colors blended over the background.
+*       Glyph pixels outside their advance cell are clipped, as is
+*       everything outside the clip rectangle; runs wider than a line
+*       buffer go out in pieces.
 *
 *********************************************************************/
-bool ST7789VW::write_string(const char* text, uint16_t color, bool newline, bool word_wrap)
+void ST7789VW::drawFontRun(int16_t x, int16_t y, const char* text, size_t len, uint16_t color, uint16_t bg_color)
     {
-    uint16_t start_x = _last_x;
-    uint16_t start_y = _last_y;
+    uint16_t height = line_height();
+    int sx = screenX(x);
+    int sy = screenY(y);
+    int clip_right = _view.clip.x + _view.clip.width;
 
-    if (newline) {
-        start_x = 0;
-        start_y += 8;
+    if (sy >= _view.clip.y + _view.clip.height || sy + height <= _view.clip.y) {
+        return;
+    }
+
+    /* characters wholly left of the clip are skipped without expanding */
+    size_t k = 0;
+    while (k < len && sx + charAdvance(text[k]) <= _view.clip.x) {
+        sx += charAdvance(text[k]);
+        k++;
+    }
+
+    uint8_t max_value = font_max_value(*_font);
+    uint16_t ramp[16];
+    for (uint8_t v = 0; v <= max_value; v++) {
+        ramp[v] = blend565(color, bg_color, (uint8_t)(v * 255 / max_value));
     }
+    uint16_t scale = _font_scale;
+
+    while (k < len && sx < clip_right) {
+        uint16_t width = 0;
+        size_t fit = k;
+        while (fit < len && sx + width < clip_right && width + charAdvance(text[fit]) <= DISPLAY_MAX_LINE_PIXELS) {
+            width += charAdvance(text[fit]);
+            fit++;
+        }
+        if (width == 0) {
+            return;
+        }
+
+        beginPixels(sx, sy, width, height);
+        for (int line = 0; line < _font->line_height; line++) {
+            uint8_t* buf = nextLineBuffer();
+            uint8_t* out = buf;
+
+            for (size_t c = k; c < fit; c++) {
+                const FontGlyph& glyph = font_glyph(*_font, text[c]);
+                int row = line - glyph.y_offset;
+
+                for (int cx = 0; cx < glyph.advance; cx++) {
+                    int col = cx - glyph.x_offset;
+                    uint16_t pixel = bg_color;
+                    if (row >= 0 && row < glyph.height && col >= 0 && col < glyph.width) {
+                        pixel = ramp[font_glyph_value(*_font, glyph, (uint16_t)col, (uint16_t)row)];
+                    }
+                    for (uint16_t s = 0; s < scale; s++) {
+                        *out++ = (uint8_t)(pixel >> 8);
+                        *out++ = (uint8_t)pixel;
+                    }
+                }
+            }
 
-    return write_string_pos(start_x, start_y, text, color, word_wrap);
+            for (uint16_t s = 0; s < scale; s++) {
+                pushPixels(buf, width);
+            }
+        }
+        endPixels();
+
+        sx += width;
+        k = fit;
+    }
     }
 
 /*********************************************************************
 *
 *   PROCEDURE NAME:
-*       ST7789VW::set_rotation
+*       ST7789VW::drawText
 *
 *   DESCRIPTION:
-*       Sets the display rotation
+*       Draws a string of text on one line, stepping by each glyph's
+*       advance at the current font and scale
 *
 *********************************************************************/
-void ST7789VW::set_rotation(Rotation rotation)
+void ST7789VW::drawText(int16_t x, int16_t y, const char* text, uint16_t color)
     {
-    _rotation = rotation;
-    uint8_t madctl_data;
-
-    switch (rotation) {
-        case Rotation::ROTATION_0:
-            madctl_data = 0x00;
-            _props.width = _default_props.width;
-            _props.height =_default_props.height;
-            _props.x_offset = _default_props.x_offset;
-            _props.y_offset = _default_props.y_offset;
-            break;
-        case Rotation::ROTATION_90:
-            madctl_data = 0x60;
-            _props.width = _default_props.height;
-            _props.height = _default_props.width;
-            _props.x_offset = _default_props.y_offset;
-            _props.y_offset = (_default_props.x_offset + 1);
-            break;
-        case Rotation::ROTATION_180:
-            madctl_data = 0xC0;
-            _props.width = _default_props.width;
-            _props.height = _default_props.height;
-            _props.x_offset = (_default_props.x_offset + 1);
-            _props.y_offset = _default_props.y_offset;
-            break;
-        case Rotation::ROTATION_270:
-            madctl_data = 0xA0;
-            _props.width = _default_props.height;
-            _props.height = _default_props.width;
-            _props.x_offset = _default_props.y_offset;
-            _props.y_offset = _default_props.x_offset;
-            break;
-    }
-
-    sendCommand(ST7789VW_CMD::MADCTL);
-    sendData(&madctl_data, 1);
+    for (int i = 0; text[i]; i++) {
+        drawChar(x, y, text[i], color);
+        x = (int16_t)(x + charAdvance(text[i]));
+    }
     }
 
 /*********************************************************************
 *
 *   PROCEDURE NAME:
-*       ST7789VW::toggleDisplay
+*       ST7789VW::sendCommand
 *
 *   DESCRIPTION:
-*       Toggles the display on or off
+*       Sends a command and its parameters under one CS assertion,
+*       toggling only D/C between them
 *
 *********************************************************************/
-void ST7789VW::toggleDisplay(bool on)
+void ST7789VW::sendCommand(ST7789VW_CMD cmd, const uint8_t* params, size_t len)
     {
-    if (on) {
-        sendCommand(ST7789VW_CMD::DISPON);
-    } else {
+    uint8_t cmd_val = static_cast<uint8_t>(cmd);
+    finishBurst();
+    _transport.select();
+    DISPLAY_INSTR(_instr, on_select());
+    _transport.set_dc(false);
+    DISPLAY_INSTR_TIME(_instr, start);
+    _transport.write(&cmd_val, 1);
+    DISPLAY_INSTR(_instr, on_command(start));
+    if (len > 0) {
+        _transport.set_dc(true);
+        DISPLAY_INSTR_TIME(_instr, data_start);
+        _transport.write(params, len);
+        DISPLAY_INSTR(_instr, on_data(len, data_start));
+    }
+    _transport.deselect();
+    _command_stats.sent++;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::sendCachedCommand
+*
+*   DESCRIPTION:
+*       Sends a register write unless the shadow copy shows the
+*       controller already holds those parameters
+*
+*********************************************************************/
+void ST7789VW::sendCachedCommand(ST7789VW_CMD cmd, const uint8_t* params, size_t len, uint8_t* shadow, bool& shadow_valid)
+    {
+    if (shadow_valid && memcmp(shadow, params, len) == 0) {
+        _command_stats.skipped++;
+        return;
+    }
+
+    sendCommand(cmd, params, len);
+    memcpy(shadow, params, len);
+    shadow_valid = true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::streamData
+*
+*   DESCRIPTION:
+*       Sends part of a burst opened by setWindow. In async mode the
+*       transfer is only started; the data must come from the buffer
+*       most recently returned by nextLineBuffer (or stay untouched
+*       until wait()).
+*
+*********************************************************************/
+void ST7789VW::streamData(const uint8_t* data, size_t len)
+    {
+    DISPLAY_INSTR_TIME(_instr, start);
+    if (_async) {
+        _transport.write_async(data, len);
+    } else {
+        _transport.write(data, len);
+    }
+    DISPLAY_INSTR(_instr, on_data(len, start));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       rgb444
+*
+*   DESCRIPTION:
+*       Converts one wire-order RGB565 pixel to 12-bit RGB444
+*
+*********************************************************************/
+static inline uint16_t rgb444(const uint8_t* pixel)
+    {
+    uint16_t p = (uint16_t)((pixel[0] << 8) | pixel[1]);
+    return (uint16_t)(((p >> 4) & 0xF00) | ((p >> 3) & 0x0F0) | ((p >> 1) & 0x00F));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       packRgb444Pair
+*
+*   DESCRIPTION:
+*       Converts two wire-order RGB565 pixels to RGB444 as one 32-bit
+*       word (the masks keep the two halves apart) and packs them
+*       into 3 bytes
+*
+*********************************************************************/
+static inline void packRgb444Pair(const uint8_t* in, uint8_t* out)
+    {
+    uint32_t w = ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 8) | in[3];
+    uint32_t t = ((w >> 4) & 0x0F000F00u) | ((w >> 3) & 0x00F000F0u) | ((w >> 1) & 0x000F000Fu);
+    uint32_t packed = ((t >> 4) & 0x00FFF000u) | (t & 0x00000FFFu);
+
+    out[0] = (uint8_t)(packed >> 16);
+    out[1] = (uint8_t)(packed >> 8);
+    out[2] = (uint8_t)packed;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::streamPixels
+*
+*   DESCRIPTION:
+*       Sends wire-order RGB565 pixels in the current color mode. In
+*       RGB444 mode pixels are packed two to three bytes into the pack
+*       buffers, which alternate like the line buffers, so the source
+*       is free as soon as this returns. An odd pixel is held until
+*       the next call or endData().
+*
+*********************************************************************/
+void ST7789VW::streamPixels(const uint8_t* pixels, size_t count)
+    {
+    if (_color_mode == ColorMode::RGB565) {
+        streamData(pixels, count * 2);
+        return;
+    }
+
+    while (count > 0) {
+        size_t n = (count < DISPLAY_MAX_LINE_PIXELS) ? count : DISPLAY_MAX_LINE_PIXELS;
+        const uint8_t* src = pixels;
+        size_t left = n;
+
+        _pack_index ^= 1;
+        uint8_t* out = _pack_buf[_pack_index];
+        uint8_t* p = out;
+
+        if (_pack_carry) {
+            uint32_t packed = ((uint32_t)_pack_pixel << 12) | rgb444(src);
+            *p++ = (uint8_t)(packed >> 16);
+            *p++ = (uint8_t)(packed >> 8);
+            *p++ = (uint8_t)packed;
+            _pack_carry = false;
+            src += 2;
+            left--;
+        }
+        for (; left >= 2; left -= 2) {
+            packRgb444Pair(src, p);
+            src += 4;
+            p += 3;
+        }
+        if (left) {
+            _pack_pixel = rgb444(src);
+            _pack_carry = true;
+        }
+
+        if (p > out) {
+            streamData(out, (size_t)(p - out));
+        }
+        pixels += n * 2;
+        count -= n;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::endData
+*
+*   DESCRIPTION:
+*       Ends a burst. An RGB444 pixel still waiting for a pair goes
+*       out as two bytes (the controller ignores the spare nibble). In
+*       async mode CS stays asserted until the last transfer drains,
+*       which happens on the next command or wait(), unless the
+*       transport can't hold CS between calls; then the last transfer
+*       is drained here.
+*
+*********************************************************************/
+void ST7789VW::endData()
+    {
+    if (_pack_carry) {
+        _pack_index ^= 1;
+        uint8_t* out = _pack_buf[_pack_index];
+        out[0] = (uint8_t)(_pack_pixel >> 4);
+        out[1] = (uint8_t)(_pack_pixel << 4);
+        streamData(out, 2);
+        _pack_carry = false;
+    }
+
+    if (_async) {
+        if (_transport.can_hold_select()) {
+            _burst_open = true;
+            return;
+        }
+        _transport.wait();
+    }
+    _transport.deselect();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::finishBurst
+*
+*   DESCRIPTION:
+*       Waits for an async burst to drain and releases CS so D/C can
+*       safely change
+*
+*********************************************************************/
+void ST7789VW::finishBurst()
+    {
+    if (!_burst_open) {
+        return;
+    }
+    _transport.wait();
+    _transport.deselect();
+    _burst_open = false;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::nextLineBuffer
+*
+*   DESCRIPTION:
+*       Returns the line buffer not used by the previous transfer.
+*       The transport runs one async transfer at a time, so the
+*       returned buffer is never still in flight.
+*
+*********************************************************************/
+uint8_t* ST7789VW::nextLineBuffer()
+    {
+    _line_index ^= 1;
+    return _line_buf[_line_index];
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::beginPixels
+*
+*   DESCRIPTION:
+*       Opens a pixel window in screen coordinates for the draw
+*       routines. Only the part inside the clip is opened, on the panel
+*       (setWindow + data burst) or, in framebuffer mode, in RAM; the
+*       caller still pushes the whole window and pushPixels drops what
+*       falls outside. Returns false, opening nothing, when no pixel of
+*       the window is visible.
+*
+*********************************************************************/
+bool ST7789VW::beginPixels(int x, int y, uint16_t width, uint16_t height)
+    {
+    DisplayRect vis;
+    if (!clipRect(x, y, width, height, vis)) {
+        return false;
+    }
+
+    _clipping = vis.width != width || vis.height != height;
+    if (_clipping) {
+        _src_width = width;
+        _src_col = 0;
+        _src_row = 0;
+        _keep.x = (uint16_t)(vis.x - x);
+        _keep.y = (uint16_t)(vis.y - y);
+        _keep.width = vis.width;
+        _keep.height = vis.height;
+    }
+
+    if (_fb == nullptr) {
+        setWindow(vis.x, vis.y, vis.width, vis.height);
+        return true;
+    }
+
+    _win = vis;
+    _win_col = 0;
+    _win_row = 0;
+    if (_fb_tracked) {
+        _dirty.mark(vis.x, vis.y, vis.width, vis.height);
+    }
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::pushPixels
+*
+*   DESCRIPTION:
+*       Feeds count wire-order pixels of the window opened by
+*       beginPixels, row by row. When the clip cut the window, only the
+*       pieces of each row inside it are written.
+*
+*********************************************************************/
+void ST7789VW::pushPixels(const uint8_t* pixels, size_t count)
+    {
+    if (!_clipping) {
+        writeWindow(pixels, count);
+        return;
+    }
+
+    uint16_t keep_right = _keep.x + _keep.width;
+    while (count > 0 && _src_row < _keep.y + _keep.height) {
+        size_t n = _src_width - _src_col;
+        if (n > count) {
+            n = count;
+        }
+
+        if (_src_row >= _keep.y) {
+            uint16_t lo = (_src_col > _keep.x) ? _src_col : _keep.x;
+            uint16_t hi = (_src_col + n < keep_right) ? (uint16_t)(_src_col + n) : keep_right;
+            if (lo < hi) {
+                writeWindow(pixels + (size_t)(lo - _src_col) * 2, hi - lo);
+            }
+        }
+
+        pixels += n * 2;
+        count -= n;
+        _src_col += (uint16_t)n;
+        if (_src_col >= _src_width) {
+            _src_col = 0;
+            _src_row++;
+        }
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::writeWindow
+*
+*   DESCRIPTION:
+*       Writes count wire-order pixels into the open window, filling
+*       it row by row. In RAM, rows outside the target are skipped.
+*
+*********************************************************************/
+void ST7789VW::writeWindow(const uint8_t* pixels, size_t count)
+    {
+    DISPLAY_INSTR(_instr, on_pixels(count));
+    if (_fb == nullptr) {
+        streamPixels(pixels, count);
+        return;
+    }
+
+    while (count > 0 && _win_row < _win.height) {
+        size_t n = _win.width - _win_col;
+        if (n > count) {
+            n = count;
+        }
+
+        uint16_t row = _win.y + _win_row;
+        if (row >= _fb_y && row < _fb_y + _fb_rows) {
+            size_t offset = (size_t)(row - _fb_y) * _props.width + _win.x + _win_col;
+            memcpy(&_fb[offset * 2], pixels, n * 2);
+        }
+
+        pixels += n * 2;
+        count -= n;
+        _win_col += (uint16_t)n;
+        if (_win_col >= _win.width) {
+            _win_col = 0;
+            _win_row++;
+        }
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::ramSpan
+*
+*   DESCRIPTION:
+*       Locates the visible part of a one row span in the RAM target
+*       for drawing in place. skip is the span's first visible pixel;
+*       returns null when none is visible.
+*
+*********************************************************************/
+uint8_t* ST7789VW::ramSpan(int x, int y, int width, uint16_t& skip, uint16_t& count)
+    {
+    DisplayRect vis;
+    if (!clipRect(x, y, width, 1, vis) || vis.y < _fb_y || vis.y >= _fb_y + _fb_rows) {
+        return nullptr;
+    }
+
+    skip = (uint16_t)(vis.x - x);
+    count = vis.width;
+    DISPLAY_INSTR(_instr, on_pixels(count));
+    if (_fb_tracked) {
+        _dirty.mark(vis.x, vis.y, vis.width, 1);
+    }
+    return &_fb[((size_t)(vis.y - _fb_y) * _props.width + vis.x) * 2];
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::trimToTarget
+*
+*   DESCRIPTION:
+*       Cuts a visible rectangle to the rows of a RAM strip, whose
+*       other rows would be skipped anyway. False when none are left.
+*
+*********************************************************************/
+bool ST7789VW::trimToTarget(DisplayRect& vis) const
+    {
+    if (_fb == nullptr) {
+        return true;
+    }
+
+    uint16_t y_end = vis.y + vis.height;
+    if (vis.y < _fb_y) {
+        vis.y = _fb_y;
+    }
+    if (y_end > _fb_y + _fb_rows) {
+        y_end = _fb_y + _fb_rows;
+    }
+    if (vis.y >= y_end) {
+        return false;
+    }
+    vis.height = y_end - vis.y;
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::endPixels
+*
+*   DESCRIPTION:
+*       Closes the pixel window
+*
+*********************************************************************/
+void ST7789VW::endPixels()
+    {
+    if (_fb == nullptr) {
+        endData();
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::clipRect
+*
+*   DESCRIPTION:
+*       Intersects a screen rectangle with the clip. Returns false when
+*       nothing of it is visible.
+*
+*********************************************************************/
+bool ST7789VW::clipRect(int x, int y, int width, int height, DisplayRect& visible) const
+    {
+    int x0 = (x > _view.clip.x) ? x : _view.clip.x;
+    int y0 = (y > _view.clip.y) ? y : _view.clip.y;
+    int x1 = x + width;
+    int y1 = y + height;
+    if (x1 > _view.clip.x + _view.clip.width) {
+        x1 = _view.clip.x + _view.clip.width;
+    }
+    if (y1 > _view.clip.y + _view.clip.height) {
+        y1 = _view.clip.y + _view.clip.height;
+    }
+    if (x0 >= x1 || y0 >= y1) {
+        return false;
+    }
+
+    visible.x = (uint16_t)x0;
+    visible.y = (uint16_t)y0;
+    visible.width = (uint16_t)(x1 - x0);
+    visible.height = (uint16_t)(y1 - y0);
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::narrowClip
+*
+*   DESCRIPTION:
+*       Intersects the clip with a screen rectangle; an empty result
+*       leaves a zero sized clip that hides everything
+*
+*********************************************************************/
+void ST7789VW::narrowClip(int x, int y, uint16_t width, uint16_t height)
+    {
+    DisplayRect vis;
+    if (!clipRect(x, y, width, height, vis)) {
+        vis.x = _view.clip.x;
+        vis.y = _view.clip.y;
+        vis.width = 0;
+        vis.height = 0;
+    }
+    _view.clip = vis;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::push_viewport
+*
+*   DESCRIPTION:
+*       Saves the current viewport and clip, then moves the origin to
+*       x, y of the current viewport and clips to width x height there
+*
+*********************************************************************/
+bool ST7789VW::push_viewport(int16_t x, int16_t y, uint16_t width, uint16_t height)
+    {
+    if (_view_depth >= DISPLAY_CLIP_DEPTH) {
+        return false;
+    }
+    _view_stack[_view_depth++] = _view;
+
+    _view.origin_x = (int16_t)(_view.origin_x + x);
+    _view.origin_y = (int16_t)(_view.origin_y + y);
+    _view.width = width;
+    _view.height = height;
+    narrowClip(_view.origin_x, _view.origin_y, width, height);
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::push_clip
+*
+*   DESCRIPTION:
+*       Saves the current viewport and clip, then narrows the clip to
+*       a rectangle of the current viewport
+*
+*********************************************************************/
+bool ST7789VW::push_clip(int16_t x, int16_t y, uint16_t width, uint16_t height)
+    {
+    if (_view_depth >= DISPLAY_CLIP_DEPTH) {
+        return false;
+    }
+    _view_stack[_view_depth++] = _view;
+
+    narrowClip(_view.origin_x + x, _view.origin_y + y, width, height);
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::push_screen
+*
+*   DESCRIPTION:
+*       Saves the current viewport and clip, then makes the whole
+*       screen both
+*
+*********************************************************************/
+bool ST7789VW::push_screen()
+    {
+    if (_view_depth >= DISPLAY_CLIP_DEPTH) {
+        return false;
+    }
+    _view_stack[_view_depth++] = _view;
+
+    _view.origin_x = 0;
+    _view.origin_y = 0;
+    _view.width = _props.width;
+    _view.height = _props.height;
+    _view.clip = {0, 0, _props.width, _props.height};
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::pop_clip
+*
+*   DESCRIPTION:
+*       Restores the viewport and clip saved by the last push
+*
+*********************************************************************/
+void ST7789VW::pop_clip()
+    {
+    if (_view_depth > 0) {
+        _view = _view_stack[--_view_depth];
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::reset_clip
+*
+*   DESCRIPTION:
+*       Empties the stack and makes the whole screen the viewport
+*
+*********************************************************************/
+void ST7789VW::reset_clip()
+    {
+    _view_depth = 0;
+    _view.origin_x = 0;
+    _view.origin_y = 0;
+    _view.width = _props.width;
+    _view.height = _props.height;
+    _view.clip.x = 0;
+    _view.clip.y = 0;
+    _view.clip.width = _props.width;
+    _view.clip.height = _props.height;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::clear_screen
+*
+*   DESCRIPTION:
+*       Clears the screen
+*
+*********************************************************************/
+void ST7789VW::clear_screen()
+    {
+    fill(0x0000); //black color
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::write_string_pos
+*
+*   DESCRIPTION:
+*       Writes a string at a specific position
+*
+*********************************************************************/
+bool ST7789VW::write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, bool word_wrap)
+    {
+    return writeString(x, y, text, color, 0x0000, false, word_wrap);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::write_string_pos (opaque)
+*
+*   DESCRIPTION:
+*       Writes a string at a specific position over a background
+*       color. Characters on the same line are sent as one burst.
+*
+*********************************************************************/
+bool ST7789VW::write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool word_wrap)
+    {
+    return writeString(x, y, text, color, bg_color, true, word_wrap);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::write_string
+*
+*   DESCRIPTION:
+*       Writes a string
+*
+*********************************************************************/
+bool ST7789VW::write_string(const char* text, uint16_t color, bool newline, bool word_wrap)
+    {
+    int16_t start_x = _last_x;
+    int16_t start_y = _last_y;
+
+    if (newline) {
+        start_x = 0;
+        start_y += line_height();
+    }
+
+    return writeString(start_x, start_y, text, color, 0x0000, false, word_wrap);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::write_string (opaque)
+*
+*   DESCRIPTION:
+*       Writes a string over a background color
+*
+*********************************************************************/
+bool ST7789VW::write_string(const char* text, uint16_t color, uint16_t bg_color, bool newline, bool word_wrap)
+    {
+    int16_t start_x = _last_x;
+    int16_t start_y = _last_y;
+
+    if (newline) {
+        start_x = 0;
+        start_y += line_height();
+    }
+
+    return writeString(start_x, start_y, text, color, bg_color, true, word_wrap);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::layoutString
+*
+*   DESCRIPTION:
+*       Walks a string through the text layout (current font
+*       advances with optional word wrap), calling put(c, x, y) for
+*       each character and leaving the end position in end_x/end_y
+*
+*********************************************************************/
+template <typename PutChar>
+void ST7789VW::layoutString(int16_t x, int16_t y, const char* text, bool word_wrap, PutChar&& put, int16_t& end_x, int16_t& end_y)
+    {
+    int16_t current_x = x;
+    int16_t current_y = y;
+    uint16_t height = line_height();
+
+    int i = 0;
+    while (text[i]) {
+        if (word_wrap) {
+            const char* word_start = &text[i];
+            int word_len = 0;
+            uint16_t word_width = 0;
+            while (text[i] && text[i] != ' ') {
+                word_width += charAdvance(text[i]);
+                word_len++;
+                i++;
+            }
+
+            if (current_x + word_width > _view.width) {
+                current_x = x;
+                current_y += height;
+            }
+
+            for (int j = 0; j < word_len; j++) {
+                put(&word_start[j], current_x, current_y);
+                current_x += charAdvance(word_start[j]);
+            }
+
+            if (text[i] == ' ') {
+                put(&text[i], current_x, current_y);
+                current_x += charAdvance(' ');
+                i++;
+            }
+
+        } else {
+            if (current_x + charAdvance(text[i]) > _view.width) {
+                current_x = x;
+                current_y += height;
+            }
+            put(&text[i], current_x, current_y);
+            current_x += charAdvance(text[i]);
+            i++;
+        }
+    }
+
+    end_x = current_x;
+    end_y = current_y;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::writeString
+*
+*   DESCRIPTION:
+*       Draws a laid out string. Transparent text is drawn glyph by
+*       glyph; opaque text is collected into runs of consecutive
+*       characters on the same line and drawn with drawTextRun.
+*
+*********************************************************************/
+bool ST7789VW::writeString(int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool opaque, bool word_wrap)
+    {
+    DISPLAY_INSTR_OP(_instr, DisplayOp::TEXT, x, y, 0, 0);
+
+    const char* run_start = nullptr;
+    size_t run_len = 0;
+    int16_t run_x = 0;
+    int16_t run_y = 0;
+    int16_t run_end = 0;
+
+    auto flush_run = [&]() {
+        if (run_len > 0) {
+            drawTextRun(run_x, run_y, run_start, run_len, color, bg_color);
+            run_len = 0;
+        }
+    };
+
+    auto put_char = [&](const char* c, int16_t cx, int16_t cy) {
+        if (!opaque) {
+            drawChar(cx, cy, *c, color);
+        } else if (run_len > 0 && run_y == cy && run_end == cx) {
+            run_len++;
+            run_end += charAdvance(*c);
+        } else {
+            flush_run();
+            run_start = c;
+            run_len = 1;
+            run_x = cx;
+            run_y = cy;
+            run_end = cx + charAdvance(*c);
+        }
+    };
+
+    layoutString(x, y, text, word_wrap, put_char, _last_x, _last_y);
+    flush_run();
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::measure_string
+*
+*   DESCRIPTION:
+*       Returns the area write_string_pos would cover, without drawing
+*
+*********************************************************************/
+DisplayRect ST7789VW::measure_string(int16_t x, int16_t y, const char* text, bool word_wrap)
+    {
+    int max_x = x;
+    int max_y = y;
+    bool any = false;
+
+    uint16_t height = line_height();
+    auto put_char = [&](const char* c, int16_t cx, int16_t cy) {
+        any = true;
+        if (cx + charAdvance(*c) > max_x) {
+            max_x = cx + charAdvance(*c);
+        }
+        if (cy + height > max_y) {
+            max_y = cy + height;
+        }
+    };
+
+    int16_t end_x;
+    int16_t end_y;
+    layoutString(x, y, text, word_wrap, put_char, end_x, end_y);
+
+    DisplayRect rect = {(uint16_t)x, (uint16_t)y, 0, 0};
+    if (any) {
+        rect.width = (uint16_t)(max_x - x);
+        rect.height = (uint16_t)(max_y - y);
+    }
+    return rect;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::set_font
+*
+*   DESCRIPTION:
+*       Selects the font and integer scale for text
+*
+*********************************************************************/
+void ST7789VW::set_font(const Font* font, uint8_t scale)
+    {
+    _font = (font != nullptr) ? font : &font_8x8;
+
+    if (scale < 1) {
+        scale = 1;
+    } else if (scale > FONT_MAX_SCALE) {
+        scale = FONT_MAX_SCALE;
+    }
+    _font_scale = scale;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::set_color_mode
+*
+*   DESCRIPTION:
+*       Selects the wire pixel format. RGB444 cuts pixel traffic by a
+*       quarter; colors lose their lowest bits (1 red/blue, 2 green).
+*       Controllers without a 12-bit format stay in RGB565.
+*
+*********************************************************************/
+void ST7789VW::set_color_mode(ColorMode mode)
+    {
+    if (mode == ColorMode::RGB444 && _controller.colmod_rgb444 == 0) {
+        return;
+    }
+    _color_mode = mode;
+
+    uint8_t colmod_data[] = {colmodValue(mode)};
+    sendCachedCommand(ST7789VW_CMD::COLMOD, colmod_data, sizeof(colmod_data), _shadow.colmod, _shadow.colmod_valid);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::set_rotation
+*
+*   DESCRIPTION:
+*       Sets the display rotation. An attached framebuffer is flushed
+*       first and comes back clean in the new orientation, to be
+*       redrawn; if it no longer holds width * height pixels it is
+*       detached.
+*
+*********************************************************************/
+void ST7789VW::set_rotation(Rotation rotation)
+    {
+    if (_fb_tracked) {
+        flush();
+    }
+
+    _rotation = rotation;
+    _props = _controller.rotate(_default_props, (uint8_t)rotation);
+    reset_clip();
+
+    uint8_t madctl_data = _controller.madctl[(uint8_t)rotation];
+    sendCachedCommand(ST7789VW_CMD::MADCTL, &madctl_data, 1, _shadow.madctl, _shadow.madctl_valid);
+
+    /* the framebuffer is laid out in the new orientation from here on:
+       its old contents are flushed and mean nothing in the new layout,
+       so it starts clean rather than resending them, and a buffer too
+       small for the new size is let go */
+    if (_fb_tracked) {
+        if ((uint32_t)_props.width * _props.height > _fb_pixels) {
+            _fb = nullptr;
+            _fb_tracked = false;
+            _fb_pixels = 0;
+            return;
+        }
+        _fb_y = 0;
+        _fb_rows = _props.height;
+        _dirty.reset(_props.width, _props.height);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::toggleDisplay
+*
+*   DESCRIPTION:
+*       Toggles the display on or off
+*
+*********************************************************************/
+void ST7789VW::toggleDisplay(bool on)
+    {
+    if (_shadow.display_valid && _shadow.display_on == on) {
+        _command_stats.skipped++;
+        return;
+    }
+    _shadow.display_on = on;
+    _shadow.display_valid = true;
+
+    if (on) {
+        sendCommand(ST7789VW_CMD::DISPON);
+    } else {
         sendCommand(ST7789VW_CMD::DISPOFF);
     }
     }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::set_async
+*
+*   DESCRIPTION:
+*       Enables or disables async pixel transfers. When enabled, fills
+*       and text return while the last line is still being sent and
+*       the next line is prepared while the previous one transmits.
+*
+*********************************************************************/
+void ST7789VW::set_async(bool enable)
+    {
+    finishBurst();
+    _async = enable;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::busy
+*
+*   DESCRIPTION:
+*       Returns true while an async transfer is still in flight
+*
+*********************************************************************/
+bool ST7789VW::busy()
+    {
+    return _burst_open && _transport.busy();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::wait
+*
+*   DESCRIPTION:
+*       Blocks until all async transfers have completed
+*
+*********************************************************************/
+void ST7789VW::wait()
+    {
+    finishBurst();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::attach_framebuffer
+*
+*   DESCRIPTION:
+*       Redirects all drawing into a RAM framebuffer of width * height
+*       pixels for the current rotation. Nothing reaches the panel
+*       until flush(), which sends only the regions that changed. The
+*       buffer contents are taken as-is and flushed in full once.
+*
+*********************************************************************/
+void ST7789VW::attach_framebuffer(uint16_t* pixels)
+    {
+    finishBurst();
+    _fb = reinterpret_cast<uint8_t*>(pixels);
+    _fb_y = 0;
+    _fb_rows = _props.height;
+    _fb_pixels = (uint32_t)_props.width * _props.height;
+    _fb_tracked = true;
+    _dirty.reset(_props.width, _props.height);
+    _dirty.mark_all();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::detach_framebuffer
+*
+*   DESCRIPTION:
+*       Flushes outstanding changes and returns to drawing straight
+*       to the panel
+*
+*********************************************************************/
+void ST7789VW::detach_framebuffer()
+    {
+    flush();
+    _fb = nullptr;
+    _fb_tracked = false;
+    _fb_pixels = 0;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::flush
+*
+*   DESCRIPTION:
+*       Sends the dirty regions of the framebuffer to the panel, one
+*       setWindow + RAMWR burst per merged rectangle
+*
+*********************************************************************/
+void ST7789VW::flush()
+    {
+    DISPLAY_INSTR_OP(_instr, DisplayOp::FLUSH, 0, 0, _props.width, _props.height);
+
+    if (!_fb_tracked) {
+        return;
+    }
+
+    uint16_t row = 0;
+    DisplayRect rect;
+    while (_dirty.next_rect(row, rect)) {
+        flushRect(rect);
+    }
+    _dirty.clear();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::flushRect
+*
+*   DESCRIPTION:
+*       Streams one rectangle of the RAM target. Full-width
+*       rectangles are contiguous in RAM and go out in a single write;
+*       in async mode rows are copied into the line buffers so
+*       drawing can resume while they transmit.
+*
+*********************************************************************/
+void ST7789VW::flushRect(const DisplayRect& rect)
+    {
+    size_t stride = (size_t)_props.width * 2;
+    size_t row_bytes = (size_t)rect.width * 2;
+    const uint8_t* src = &_fb[(size_t)(rect.y - _fb_y) * stride + (size_t)rect.x * 2];
+
+    /* RGB444 packs into its own buffers, so only RGB565 async sends
+       need the copy out of the framebuffer */
+    bool copy_rows = _async && _color_mode == ColorMode::RGB565;
+
+    setWindow(rect.x, rect.y, rect.width, rect.height);
+    if (!copy_rows && rect.width == _props.width) {
+        streamPixels(src, (size_t)rect.width * rect.height);
+    } else {
+        for (uint16_t i = 0; i < rect.height; i++) {
+            if (copy_rows) {
+                uint8_t* buf = nextLineBuffer();
+                memcpy(buf, src, row_bytes);
+                streamPixels(buf, rect.width);
+            } else {
+                streamPixels(src, rect.width);
+            }
+            src += stride;
+        }
+    }
+    endData();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::begin_strip
+*
+*   DESCRIPTION:
+*       Redirects drawing into a RAM strip holding rows [y, y + rows)
+*       at full width. Draws outside the strip are dropped. Used by
+*       StripRenderer to replay a display list band by band.
+*
+*********************************************************************/
+void ST7789VW::begin_strip(uint16_t* pixels, uint16_t y, uint16_t rows)
+    {
+    finishBurst();
+    _saved_fb = _fb;
+    _saved_fb_tracked = _fb_tracked;
+
+    _fb = reinterpret_cast<uint8_t*>(pixels);
+    _fb_y = y;
+    _fb_rows = rows;
+    _fb_tracked = false;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::end_strip
+*
+*   DESCRIPTION:
+*       Sends the strip to the panel with one setWindow + RAMWR and
+*       restores the previous draw target
+*
+*********************************************************************/
+void ST7789VW::end_strip()
+    {
+    DISPLAY_INSTR_OP(_instr, DisplayOp::STRIP, 0, _fb_y, _props.width, _fb_rows);
+
+    if (_fb_rows > _props.height - _fb_y) {
+        _fb_rows = _props.height - _fb_y;
+    }
+    DisplayRect rect = {0, _fb_y, _props.width, _fb_rows};
+    flushRect(rect);
+
+    _fb = _saved_fb;
+    _fb_tracked = _saved_fb_tracked;
+    _fb_y = 0;
+    _fb_rows = _props.height;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::command_stats
+*
+*   DESCRIPTION:
+*       Returns how many commands were sent and how many redundant
+*       ones were skipped
+*
+*********************************************************************/
+CommandStats ST7789VW::command_stats() const
+    {
+    return _command_stats;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::reset_command_stats
+*
+*   DESCRIPTION:
+*       Clears the command counters
+*
+*********************************************************************/
+void ST7789VW::reset_command_stats()
+    {
+    _command_stats = CommandStats();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::set_scroll_area
+*
+*   DESCRIPTION:
+*       Defines the vertical scroll area (VSCRDEF): top_fixed rows,
+*       then scroll_rows that wrap around, then bottom_fixed rows
+*
+*********************************************************************/
+void ST7789VW::set_scroll_area(uint16_t top_fixed, uint16_t scroll_rows, uint16_t bottom_fixed)
+    {
+    DISPLAY_INSTR_OP(_instr, DisplayOp::SCROLL, 0, top_fixed, 0, scroll_rows);
+
+    uint8_t vscrdef_data[] = {(uint8_t)(top_fixed >> 8), (uint8_t)top_fixed,
+                              (uint8_t)(scroll_rows >> 8), (uint8_t)scroll_rows,
+                              (uint8_t)(bottom_fixed >> 8), (uint8_t)bottom_fixed};
+    sendCommand(ST7789VW_CMD::VSCRDEF, vscrdef_data, sizeof(vscrdef_data));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::set_scroll_start
+*
+*   DESCRIPTION:
+*       Sets which memory row is shown at the top of the scroll area
+*       (VSCSAD)
+*
+*********************************************************************/
+void ST7789VW::set_scroll_start(uint16_t row)
+    {
+    DISPLAY_INSTR_OP(_instr, DisplayOp::SCROLL, 0, row, 0, 0);
+
+    uint8_t vscsad_data[] = {(uint8_t)(row >> 8), (uint8_t)row};
+    sendCommand(ST7789VW_CMD::VSCSAD, vscsad_data, sizeof(vscsad_data));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ST7789VW::set_tearing_effect
+*
+*   DESCRIPTION:
+*       Turns the TE output on (V-blank only, TEON mode 0) or off
+*
+*********************************************************************/
+void ST7789VW::set_tearing_effect(bool on)
+    {
+    if (on) {
+        uint8_t teon_data[] = {0x00};
+        sendCommand(ST7789VW_CMD::TEON, teon_data, sizeof(teon_data));
+    } else {
+        sendCommand(ST7789VW_CMD::TEOFF);
+    }
+    }
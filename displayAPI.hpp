@@ -11,8 +11,18 @@
 /*--------------------------------------------------------------------
                               INCLUDES
 --------------------------------------------------------------------*/
-#include "pico/stdlib.h"
-#include "hardware/spi.h"
+#include "alphaBlend.hpp"
+#include "controller.hpp"
+#include "displayTransport.hpp"
+#include "framebuffer.hpp"
+#include "glyphCache.hpp"
+#include "image.hpp"
+#include "instrumentation.hpp"
+#include "qoiDecoder.hpp"
+
+#if !defined(DISPLAYAPI_HOST)
+#include "picoTransport.hpp"
+#endif
 
 /*--------------------------------------------------------------------
                           GLOBAL NAMESPACES
@@ -21,6 +31,8 @@
 /*--------------------------------------------------------------------
                           LITERAL CONSTANTS
 --------------------------------------------------------------------*/
+constexpr uint16_t DISPLAY_MAX_LINE_PIXELS = 320;   /* longest panel side supported by the line buffer */
+constexpr uint8_t DISPLAY_CLIP_DEPTH = 8;           /* nested push_viewport/push_clip calls */
 
 /*--------------------------------------------------------------------
                             TYPES/ENUMS
@@ -48,18 +60,18 @@ enum class ST7789VW_CMD : uint8_t {
     CASET = 0x2A,
     RASET = 0x2B,
     RAMWR = 0x2C,
+    VSCRDEF = 0x33,
+    TEOFF = 0x34,
+    TEON = 0x35,
+    VSCSAD = 0x37,
     COLMOD = 0x3A,
     MADCTL = 0x36,
 };
 
 typedef struct {
-    uint16_t width;
-    uint16_t height;
-    uint16_t map_width;
-    uint16_t map_height;
-    uint16_t x_offset;
-    uint16_t y_offset;
-} DisplayProperties;
+    uint32_t sent;              /* commands put on the bus         */
+    uint32_t skipped;           /* redundant commands not sent     */
+} CommandStats;
 
 /*--------------------------------------------------------------------
                            MEMORY CONSTANTS
@@ -82,15 +94,64 @@ typedef struct {
 --------------------------------------------------------------------*/
 class ST7789VW {
     public:
-        ST7789VW(spi_inst_t* spi, DisplayProperties props, uint cs_pin, uint dc_pin, uint rst_pin, uint bl_pin);
+        /* width and height past DISPLAY_MAX_LINE_PIXELS or
+           FRAMEBUFFER_MAX_ROWS are clamped to them; width() and
+           height() report the size actually driven */
+#if !defined(DISPLAYAPI_HOST)
+        ST7789VW(spi_inst_t* spi, DisplayProperties props, uint cs_pin, uint dc_pin, uint rst_pin, uint bl_pin,
+                 const ControllerInfo& controller = ST7789Controller::info);
+#endif
+        ST7789VW(DisplayTransport& transport, DisplayProperties props, const ControllerInfo& controller = ST7789Controller::info);
         ~ST7789VW( void );
 
-        void init();
+        /* runs the controller's init table, blocking through its
+           delays. hardware_reset = false skips the 130 ms reset pin
+           pulse and relies on the table's SWRESET. */
+        void init(bool hardware_reset = true);
+
+        /* non-blocking init: begin_init() starts the same sequence and
+           poll() sends whatever is due, returning true once the panel is
+           on. Nothing else may use the display until then. poll(now_us)
+           runs on a caller-supplied microsecond clock. */
+        void begin_init(bool hardware_reset = true);
+        bool poll();
+        bool poll(uint64_t now_us);
+        /* duration of the last completed init */
+        uint32_t init_time_us() const { return _init_time_us; }
+
         void fill(uint16_t color);
+        void fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color);
         void clear_screen(void);
         void toggleDisplay(bool on);
-        bool write_string_pos(uint16_t x, uint16_t y, const char* text, uint16_t color, bool word_wrap = false);
+        bool write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, bool word_wrap = false);
         bool write_string(const char* text, uint16_t color, bool newline = false, bool word_wrap = false);
+        bool write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool word_wrap = false);
+        bool write_string(const char* text, uint16_t color, uint16_t bg_color, bool newline = false, bool word_wrap = false);
+        DisplayRect measure_string(int16_t x, int16_t y, const char* text, bool word_wrap = false);
+
+        /* font used by the write_string functions, drawn at 1 to
+           FONT_MAX_SCALE times its size (nullptr for the 8x8 font).
+           Console and TextGrid expect the 8x8 font at scale 1. */
+        void set_font(const Font* font, uint8_t scale = 1);
+        uint16_t line_height() const { return (uint16_t)(_font->line_height * _font_scale); }
+        void blit(int16_t x, int16_t y, const Image& image);
+        /* dithering for RGB888 and ARGB8888 images */
+        void set_dither(Dither dither) { _dither = dither; }
+        /* streams a QOI image from its reader a row at a time (reads
+           the header if the caller has not), false on a bad stream */
+        bool blit_qoi(int16_t x, int16_t y, QoiDecoder& decoder);
+
+        /* alpha blended drawing. Translucent fills and masks blend into
+           an attached framebuffer or strip; the panel can't be read
+           back, so drawn straight to it pixels at least half opaque
+           are drawn solid. The bg_color form composites over that
+           color in the line buffer and is smooth either way. Anti-
+           aliased fonts (Font::bpp 2 or 4) follow the same rules:
+           text with a background is always smooth, transparent text
+           needs a RAM target. */
+        void fill_rect_alpha(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color, uint8_t alpha);
+        void draw_mask(int16_t x, int16_t y, const AlphaMask& mask, uint16_t color);
+        void draw_mask(int16_t x, int16_t y, const AlphaMask& mask, uint16_t color, uint16_t bg_color);
 
         enum class Rotation {
             ROTATION_0,
@@ -98,31 +159,212 @@ class ST7789VW {
             ROTATION_180,
             ROTATION_270
         };
+        /* pixel format on the wire; RAM buffers stay RGB565 and are
+           converted while streaming */
+        enum class ColorMode {
+            RGB565,         /* 2 bytes per pixel                */
+            RGB444          /* 3 bytes per 2 pixels (ST7789/ST7735 only) */
+        };
+        void set_color_mode(ColorMode mode);
+        ColorMode color_mode() const { return _color_mode; }
+
+        /* viewports and clipping. Draw coordinates are relative to the
+           current viewport and everything is clipped to the current
+           clip rectangle, so text and images may hang off any edge
+           (coordinates are signed; left of or above the origin is
+           negative). push_viewport moves the origin to x, y of
+           the current viewport and clips to width x height there; text
+           wraps at the viewport's width. push_clip only narrows the
+           clip. push_screen makes the whole screen the viewport and
+           clip again, for code that draws in screen coordinates. All
+           three return false when the stack is full. set_rotation
+           resets the stack to the whole screen. */
+        bool push_viewport(int16_t x, int16_t y, uint16_t width, uint16_t height);
+        bool push_clip(int16_t x, int16_t y, uint16_t width, uint16_t height);
+        bool push_screen();
+        void pop_clip();
+        void reset_clip();
+        DisplayRect clip_rect() const { return _view.clip; }      /* in screen coordinates */
+        uint16_t viewport_width() const { return _view.width; }
+        uint16_t viewport_height() const { return _view.height; }
+
         void set_rotation(Rotation rotation);
+        Rotation rotation() const { return _rotation; }
+        const DisplayProperties& properties() const { return _props; }
+
+        /* hardware vertical scrolling, in panel memory rows (sum of the
+           three areas must equal map_height) */
+        void set_scroll_area(uint16_t top_fixed, uint16_t scroll_rows, uint16_t bottom_fixed);
+        void set_scroll_start(uint16_t row);
+
+        /* drive the TE pin high during vertical blanking (see
+           FrameScheduler) */
+        void set_tearing_effect(bool on);
+
+        DisplayTransport& transport() { return _transport; }
+
+        void set_async(bool enable);
+        bool busy();
+        void wait();
+
+        /* framebuffer mode: draws go to pixels (width * height RGB565
+           values in wire byte order) until flush() sends what changed.
+           set_rotation leaves it clean for a redraw, or detaches it
+           if the new size doesn't fit */
+        void attach_framebuffer(uint16_t* pixels);
+        void detach_framebuffer();
+        bool framebuffer_attached() const { return _fb_pixels != 0; }
+        void flush();
+
+        /* band rendering: draws go to a full-width strip of rows until
+           end_strip() sends it (see StripRenderer) */
+        void begin_strip(uint16_t* pixels, uint16_t y, uint16_t rows);
+        void end_strip();
+
+        /* opaque text takes expanded glyphs from the cache (nullptr
+           to expand from the font bitmap every time) */
+        void set_glyph_cache(GlyphCache* cache) { _glyph_cache = cache; }
+
+        CommandStats command_stats() const;
+        void reset_command_stats();
+
+#if defined(DISPLAYAPI_INSTRUMENTATION)
+        DisplayInstrumentation& instrumentation() { return _instr; }
+#endif
+
+        uint16_t width() const { return _props.width; }
+        uint16_t height() const { return _props.height; }
 
         ST7789VW (const ST7789VW&) = delete;
         ST7789VW& operator= (const ST7789VW&) = delete;
 
     private:
         void setWindow(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
-        void drawPixel(uint16_t x, uint16_t y, uint16_t color);
-        void drawChar(uint16_t x, uint16_t y, char c, uint16_t color);
-        void drawText(uint16_t x, uint16_t y, const char* text, uint16_t color);
-        void sendCommand(ST7789VW_CMD cmd);
-        void sendData(const uint8_t* data, size_t len);
-        void reset();
-
-        spi_inst_t* _spi;
-        uint _cs_pin;
-        uint _dc_pin;
-        uint _rst_pin;
-        uint _bl_pin;
+        int screenX(int16_t x) const { return _view.origin_x + x; }
+        int screenY(int16_t y) const { return _view.origin_y + y; }
+        bool clipRect(int x, int y, int width, int height, DisplayRect& visible) const;
+        void narrowClip(int x, int y, uint16_t width, uint16_t height);
+        void fillRect(int x, int y, int width, int height, uint16_t color);
+        void drawPixel(int16_t x, int16_t y, uint16_t color);
+        void drawChar(int16_t x, int16_t y, char c, uint16_t color);
+        void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg_color);
+        void drawTextRun(int16_t x, int16_t y, const char* text, size_t len, uint16_t color, uint16_t bg_color);
+        void drawFontRun(int16_t x, int16_t y, const char* text, size_t len, uint16_t color, uint16_t bg_color);
+        uint16_t charAdvance(char c) const { return (uint16_t)(font_glyph(*_font, c).advance * _font_scale); }
+        void drawText(int16_t x, int16_t y, const char* text, uint16_t color);
+        bool writeString(int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool opaque, bool word_wrap);
+        template <typename PutChar>
+        void layoutString(int16_t x, int16_t y, const char* text, bool word_wrap, PutChar&& put, int16_t& end_x, int16_t& end_y);
+        uint8_t colmodValue(ColorMode mode) const { return (mode == ColorMode::RGB444) ? _controller.colmod_rgb444 : _controller.colmod_rgb565; }
+        void sendCommand(ST7789VW_CMD cmd, const uint8_t* params = nullptr, size_t len = 0);
+        void sendCachedCommand(ST7789VW_CMD cmd, const uint8_t* params, size_t len, uint8_t* shadow, bool& shadow_valid);
+        void streamData(const uint8_t* data, size_t len);
+        void streamPixels(const uint8_t* pixels, size_t count);
+        void endData();
+        void finishBurst();
+        uint8_t* nextLineBuffer();
+        bool beginPixels(int x, int y, uint16_t width, uint16_t height);
+        void pushPixels(const uint8_t* pixels, size_t count);
+        void writeWindow(const uint8_t* pixels, size_t count);
+        uint8_t* ramSpan(int x, int y, int width, uint16_t& skip, uint16_t& count);
+        bool trimToTarget(DisplayRect& visible) const;
+        void drawCharBlended(int x, int y, char c, uint16_t color);
+        void endPixels();
+        void flushRect(const DisplayRect& rect);
+        uint32_t initStep();
+
+#if !defined(DISPLAYAPI_HOST)
+        PicoSPITransport _pico_transport;   /* backs the pin-based constructor */
+#endif
+        DisplayTransport& _transport;
+        const ControllerInfo& _controller;
 
         DisplayProperties _props;
         DisplayProperties _default_props;
         Rotation _rotation;
-        uint16_t _last_x;
-        uint16_t _last_y;
+        int16_t _last_x;
+        int16_t _last_y;
+
+        bool _async;
+        bool _burst_open;
+        uint8_t _line_index;
+        uint8_t _line_buf[2][DISPLAY_MAX_LINE_PIXELS * 2];
+
+        ColorMode _color_mode;
+        bool _pack_carry;           /* RGB444: odd pixel waiting for its pair */
+        uint16_t _pack_pixel;
+        uint8_t _pack_index;
+        uint8_t _pack_buf[2][DISPLAY_MAX_LINE_PIXELS * 3 / 2 + 3];
+
+        uint8_t* _fb;               /* current RAM target, null when drawing to the panel */
+        uint16_t _fb_y;             /* first screen row held by _fb */
+        uint16_t _fb_rows;
+        uint32_t _fb_pixels;        /* size of the attached framebuffer, 0 when none */
+        bool _fb_tracked;           /* true for an attached framebuffer, false for a strip */
+        uint8_t* _saved_fb;
+        bool _saved_fb_tracked;
+        DirtyTracker _dirty;
+        GlyphCache* _glyph_cache;
+        Dither _dither;
+        const Font* _font;
+        uint8_t _font_scale;
+        DisplayRect _win;
+        uint16_t _win_col;
+        uint16_t _win_row;
+
+        /* viewport and clip, with the states push_* saved */
+        struct ViewState {
+            int16_t origin_x;       /* screen position of local 0, 0    */
+            int16_t origin_y;
+            uint16_t width;         /* viewport size, text wraps here   */
+            uint16_t height;
+            DisplayRect clip;       /* screen pixels drawing may touch  */
+        };
+        ViewState _view;
+        ViewState _view_stack[DISPLAY_CLIP_DEPTH];
+        uint8_t _view_depth;
+
+        /* a pixel window cut by the clip: the caller streams the whole
+           src_width wide window and only the _keep part is sent */
+        bool _clipping;
+        uint16_t _src_width;
+        uint16_t _src_col;
+        uint16_t _src_row;
+        DisplayRect _keep;
+
+        /* last values written to the controller, to skip redundant writes */
+        struct ControllerShadow {
+            uint8_t caset[4];
+            uint8_t raset[4];
+            uint8_t madctl[1];
+            uint8_t colmod[1];
+            bool display_on;
+            bool caset_valid;
+            bool raset_valid;
+            bool madctl_valid;
+            bool colmod_valid;
+            bool display_valid;
+        } _shadow;
+        CommandStats _command_stats;
+
+        /* init sequence, run by init() or poll() */
+        enum class InitPhase : uint8_t {
+            IDLE,
+            RESET,              /* pull the reset pin low           */
+            RESET_RELEASE,      /* release it after the pulse       */
+            TABLE,              /* controller init table            */
+            DISPLAY_ON          /* DISPON sent, waiting to settle   */
+        };
+        InitPhase _init_phase;
+        uint16_t _init_pos;         /* next step in the init table */
+        bool _init_clock_started;
+        uint64_t _init_start_us;
+        uint64_t _init_deadline_us;
+        uint32_t _init_time_us;
+
+#if defined(DISPLAYAPI_INSTRUMENTATION)
+        DisplayInstrumentation _instr;
+#endif
 };
 
 #endif // DISPLAY_API_HPP
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef DISPLAY_TRANSPORT_HPP
+#define DISPLAY_TRANSPORT_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       transport interface between the display drivers and the bus
+*       (SPI + CS/DC/RST/BL lines) they talk over
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+class DisplayTransport {
+    public:
+        virtual ~DisplayTransport( void ) {}
+
+        /* configure pins, leaving CS released and the backlight on */
+        virtual void init() = 0;
+
+        /* chip select: asserted for the duration of a transaction */
+        virtual void select() = 0;
+        virtual void deselect() = 0;
+
+        /* D/C line: false for command bytes, true for parameters/pixels */
+        virtual void set_dc(bool data) = 0;
+
+        /* write bytes while selected, returns once they are on the wire */
+        virtual void write(const uint8_t* data, size_t len) = 0;
+
+        /* start a write and return while it is in flight. Only one
+           transfer runs at a time: a new one first waits for the last.
+           data must stay untouched until busy() is false. Backends
+           without async support send it synchronously. */
+        virtual void write_async(const uint8_t* data, size_t len) { write(data, len); }
+        virtual bool busy() { return false; }
+        virtual void wait() {}
+
+        /* false when CS must not stay asserted between draw calls, as
+           on a shared bus where the other panels would be locked out.
+           An async ST7789VW then drains each burst before returning. */
+        virtual bool can_hold_select() { return true; }
+
+        virtual void set_reset(bool level) = 0;
+        virtual void delay_ms(uint32_t ms) = 0;
+
+        /* microsecond clock and delay for frame pacing. Backends
+           without a clock report 0, which turns pacing off. */
+        virtual uint64_t now_us() { return 0; }
+        virtual void delay_us(uint32_t us) { delay_ms((us + 999) / 1000); }
+
+        /* SPI clock for this panel, for buses shared by panels with
+           different limits. Backends without clock control ignore it. */
+        virtual void set_bus_clock(uint32_t hz) { (void)hz; }
+};
+
+#endif // DISPLAY_TRANSPORT_HPP
@@ -3,7 +3,215 @@
 
 #include <cstdint>
 
-// Basic 8x8 font
-extern const uint8_t font[256][8];
+// Font descriptor. Glyph bitmaps are packed as one bitstream, MSB
+// first, each glyph's rows following each other with no padding.
+// Fixed and proportional fonts only differ in their advances.
+// Anti-aliased fonts store 2 or 4 bits of coverage per pixel.
+typedef struct {
+    uint32_t offset;            // first bit of the glyph in Font::bitmap
+    uint8_t width;              // bitmap size in pixels
+    uint8_t height;
+    uint8_t advance;            // pen movement to the next character
+    int8_t x_offset;            // bitmap position from the pen
+    int8_t y_offset;            // bitmap position from the top of the line
+} FontGlyph;
+
+typedef struct {
+    const uint8_t* bitmap;
+    const FontGlyph* glyphs;    // one per code from first to last
+    uint8_t first;              // codes outside first..last draw as first
+    uint8_t last;
+    uint8_t line_height;
+    uint8_t bpp;                // bits per pixel: 2 or 4, 0 or 1 for 1-bit fonts
+} Font;
+
+constexpr uint8_t FONT_MAX_SCALE = 4;
+
+// Basic 8x8 font. Defined in the header as constexpr so glyphs can be
+// expanded at compile time (see prerender_text in glyphCache.hpp)
+inline constexpr uint8_t font[256][8] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x00
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x01
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x02
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x03
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x04
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x05
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x06
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x07
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x08
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x09
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x0A
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x0B
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x0C
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x0D
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x0E
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x0F
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x10
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x11
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x12
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x13
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x14
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x15
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x16
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x17
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x18
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x19
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x1A
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x1B
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x1C
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x1D
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x1E
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x1F
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+    {0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00}, // '!'
+    {0x66, 0x66, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00}, // '"'
+    {0x6C, 0x6C, 0xFE, 0x6C, 0xFE, 0x6C, 0x6C, 0x00}, // '#'
+    {0x18, 0x3E, 0x60, 0x3C, 0x06, 0x7C, 0x18, 0x00}, // '$'
+    {0x00, 0x63, 0x66, 0x0C, 0x18, 0x33, 0x63, 0x00}, // '%'
+    {0x38, 0x6C, 0x38, 0x76, 0xDC, 0xCC, 0x76, 0x00}, // '&'
+    {0x18, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00}, // '''
+    {0x0C, 0x18, 0x30, 0x60, 0x60, 0x30, 0x18, 0x0C}, // '('
+    {0x60, 0x30, 0x18, 0x0C, 0x0C, 0x18, 0x30, 0x60}, // ')'
+    {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00}, // '*'
+    {0x00, 0x18, 0x18, 0x7E, 0x18, 0x18, 0x00, 0x00}, // '+'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x30}, // ','
+    {0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x00}, // '-'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00}, // '.'
+    {0x00, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00}, // '/'
+    {0x3C, 0x66, 0x6E, 0x76, 0x66, 0x66, 0x3C, 0x00}, // '0'
+    {0x18, 0x38, 0x18, 0x18, 0x18, 0x18, 0x3C, 0x00}, // '1'
+    {0x3C, 0x66, 0x06, 0x0C, 0x18, 0x30, 0x7E, 0x00}, // '2'
+    {0x3C, 0x66, 0x06, 0x3C, 0x06, 0x66, 0x3C, 0x00}, // '3'
+    {0x0C, 0x1C, 0x3C, 0x6C, 0x7E, 0x0C, 0x0C, 0x00}, // '4'
+    {0x7E, 0x60, 0x7C, 0x06, 0x06, 0x66, 0x3C, 0x00}, // '5'
+    {0x3C, 0x60, 0x60, 0x7C, 0x66, 0x66, 0x3C, 0x00}, // '6'
+    {0x7E, 0x06, 0x0C, 0x18, 0x30, 0x30, 0x30, 0x00}, // '7'
+    {0x3C, 0x66, 0x66, 0x3C, 0x66, 0x66, 0x3C, 0x00}, // '8'
+    {0x3C, 0x66, 0x66, 0x3E, 0x06, 0x0C, 0x38, 0x00}, // '9'
+    {0x00, 0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x00}, // ':'
+    {0x00, 0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x30}, // ';'
+    {0x0C, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0C, 0x00}, // '<'
+    {0x00, 0x00, 0x7E, 0x00, 0x7E, 0x00, 0x00, 0x00}, // '='
+    {0x60, 0x30, 0x18, 0x0C, 0x18, 0x30, 0x60, 0x00}, // '>'
+    {0x3C, 0x66, 0x06, 0x0C, 0x18, 0x00, 0x18, 0x00}, // '?'
+    {0x3C, 0x66, 0x66, 0x7E, 0x6E, 0x60, 0x3C, 0x00}, // '@'
+    {0x18, 0x3C, 0x66, 0x66, 0x7E, 0x66, 0x66, 0x00}, // 'A'
+    {0x7C, 0x66, 0x66, 0x7C, 0x66, 0x66, 0x7C, 0x00}, // 'B'
+    {0x3C, 0x66, 0x60, 0x60, 0x60, 0x66, 0x3C, 0x00}, // 'C'
+    {0x78, 0x6C, 0x66, 0x66, 0x66, 0x6C, 0x78, 0x00}, // 'D'
+    {0x7E, 0x60, 0x60, 0x7C, 0x60, 0x60, 0x7E, 0x00}, // 'E'
+    {0x7E, 0x60, 0x60, 0x7C, 0x60, 0x60, 0x60, 0x00}, // 'F'
+    {0x3C, 0x66, 0x60, 0x60, 0x6E, 0x66, 0x3E, 0x00}, // 'G'
+    {0x66, 0x66, 0x66, 0x7E, 0x66, 0x66, 0x66, 0x00}, // 'H'
+    {0x3C, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C, 0x00}, // 'I'
+    {0x0E, 0x06, 0x06, 0x06, 0x06, 0x66, 0x3C, 0x00}, // 'J'
+    {0x66, 0x6C, 0x78, 0x70, 0x78, 0x6C, 0x66, 0x00}, // 'K'
+    {0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x7E, 0x00}, // 'L'
+    {0xC6, 0xEE, 0xFE, 0xD6, 0xC6, 0xC6, 0xC6, 0x00}, // 'M'
+    {0x66, 0xE6, 0xF6, 0xDE, 0xCE, 0x66, 0x66, 0x00}, // 'N'
+    {0x3C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C, 0x00}, // 'O'
+    {0x7C, 0x66, 0x66, 0x7C, 0x60, 0x60, 0x60, 0x00}, // 'P'
+    {0x3C, 0x66, 0x66, 0x66, 0x6E, 0x3C, 0x0E, 0x00}, // 'Q'
+    {0x7C, 0x66, 0x66, 0x7C, 0x78, 0x6C, 0x66, 0x00}, // 'R'
+    {0x3C, 0x66, 0x60, 0x3C, 0x06, 0x66, 0x3C, 0x00}, // 'S'
+    {0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00}, // 'T'
+    {0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3E, 0x00}, // 'U'
+    {0x66, 0x66, 0x66, 0x66, 0x66, 0x3C, 0x18, 0x00}, // 'V'
+    {0xC6, 0xC6, 0xC6, 0xD6, 0xFE, 0xEE, 0xC6, 0x00}, // 'W'
+    {0x66, 0x66, 0x3C, 0x18, 0x3C, 0x66, 0x66, 0x00}, // 'X'
+    {0x66, 0x66, 0x66, 0x3C, 0x18, 0x18, 0x18, 0x00}, // 'Y'
+    {0x7E, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x7E, 0x00}, // 'Z'
+    {0x3C, 0x30, 0x30, 0x30, 0x30, 0x30, 0x3C, 0x00}, // '['
+    {0x40, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x00, 0x00}, // ''
+    {0x3C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x3C, 0x00}, // ']'
+    {0x24, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // '^'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF}, // '_'
+    {0x30, 0x18, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00}, // '`'
+    {0x00, 0x00, 0x3C, 0x06, 0x3E, 0x66, 0x3E, 0x00}, // 'a'
+    {0x60, 0x60, 0x7C, 0x66, 0x66, 0x66, 0x7C, 0x00}, // 'b'
+    {0x00, 0x00, 0x3C, 0x66, 0x60, 0x66, 0x3C, 0x00}, // 'c'
+    {0x06, 0x06, 0x3E, 0x66, 0x66, 0x66, 0x3E, 0x00}, // 'd'
+    {0x00, 0x00, 0x3C, 0x66, 0x7E, 0x60, 0x3C, 0x00}, // 'e'
+    {0x1C, 0x36, 0x30, 0x7C, 0x30, 0x30, 0x30, 0x00}, // 'f'
+    {0x00, 0x00, 0x3E, 0x66, 0x66, 0x3E, 0x06, 0x7C}, // 'g'
+    {0x60, 0x60, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x00}, // 'h'
+    {0x18, 0x00, 0x38, 0x18, 0x18, 0x18, 0x3C, 0x00}, // 'i'
+    {0x0C, 0x00, 0x1C, 0x0C, 0x0C, 0x0C, 0x0C, 0x78}, // 'j'
+    {0x60, 0x60, 0x6C, 0x78, 0x70, 0x6C, 0x66, 0x00}, // 'k'
+    {0x38, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C, 0x00}, // 'l'
+    {0x00, 0x00, 0xCC, 0xFE, 0xD6, 0xD6, 0xC6, 0x00}, // 'm'
+    {0x00, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x00}, // 'n'
+    {0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x3C, 0x00}, // 'o'
+    {0x00, 0x00, 0x7C, 0x66, 0x66, 0x7C, 0x60, 0x60}, // 'p'
+    {0x00, 0x00, 0x3E, 0x66, 0x66, 0x3E, 0x06, 0x0E}, // 'q'
+    {0x00, 0x00, 0x7C, 0x6E, 0x60, 0x60, 0x60, 0x00}, // 'r'
+    {0x00, 0x00, 0x3E, 0x60, 0x3C, 0x06, 0x7C, 0x00}, // 's'
+    {0x30, 0x30, 0x7C, 0x30, 0x30, 0x36, 0x1C, 0x00}, // 't'
+    {0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x3E, 0x00}, // 'u'
+    {0x00, 0x00, 0x66, 0x66, 0x66, 0x3C, 0x18, 0x00}, // 'v'
+    {0x00, 0x00, 0xC6, 0xD6, 0xFE, 0xEE, 0xC6, 0x00}, // 'w'
+    {0x00, 0x00, 0x66, 0x3C, 0x18, 0x3C, 0x66, 0x00}, // 'x'
+    {0x00, 0x00, 0x66, 0x66, 0x66, 0x3E, 0x06, 0x7C}, // 'y'
+    {0x00, 0x00, 0x7E, 0x0C, 0x18, 0x30, 0x7E, 0x00}, // 'z'
+    {0x0E, 0x18, 0x18, 0x70, 0x18, 0x18, 0x0E, 0x00}, // '{'
+    {0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00}, // '|'
+    {0x70, 0x18, 0x18, 0x0E, 0x18, 0x18, 0x70, 0x00}, // '}'
+    {0x76, 0xDC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // '~'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}  // 0x7F-0xFF
+};
+
+// font[][] as a Font descriptor: 8x8 cells, every row one byte
+struct Font8x8Glyphs {
+    FontGlyph glyphs[256];
+};
+
+constexpr Font8x8Glyphs makeFont8x8Glyphs()
+    {
+    Font8x8Glyphs table = {};
+    for (uint32_t c = 0; c < 256; c++) {
+        table.glyphs[c] = {c * 64, 8, 8, 8, 0, 0};
+    }
+    return table;
+    }
+
+inline constexpr Font8x8Glyphs font_8x8_glyphs = makeFont8x8Glyphs();
+inline constexpr Font font_8x8 = {&font[0][0], font_8x8_glyphs.glyphs, 0, 255, 8, 1};
+
+constexpr const FontGlyph& font_glyph(const Font& f, char c)
+    {
+    uint8_t code = (uint8_t)c;
+    if (code < f.first || code > f.last) {
+        code = f.first;
+    }
+    return f.glyphs[code - f.first];
+    }
+
+constexpr uint8_t font_max_value(const Font& f)
+    {
+    return (f.bpp > 1) ? (uint8_t)((1 << f.bpp) - 1) : 1;
+    }
+
+// coverage of a glyph pixel, 0 to font_max_value()
+constexpr uint8_t font_glyph_value(const Font& f, const FontGlyph& g, uint16_t col, uint16_t row)
+    {
+    if (f.bpp <= 1) {
+        uint32_t bit = g.offset + (uint32_t)row * g.width + col;
+        return (f.bitmap[bit >> 3] >> (7 - (bit & 7))) & 1;
+    }
+    uint32_t bit = g.offset + ((uint32_t)row * g.width + col) * f.bpp;
+    return (f.bitmap[bit >> 3] >> (8 - f.bpp - (bit & 7))) & font_max_value(f);
+    }
+
+// coverage scaled to 0-255
+constexpr uint8_t font_glyph_alpha(const Font& f, const FontGlyph& g, uint16_t col, uint16_t row)
+    {
+    return (uint8_t)(font_glyph_value(f, g, col, row) * 255 / font_max_value(f));
+    }
+
+// set pixels; anti-aliased pixels count when at least half covered
+constexpr bool font_glyph_bit(const Font& f, const FontGlyph& g, uint16_t col, uint16_t row)
+    {
+    return font_glyph_value(f, g, col, row) * 2 > font_max_value(f);
+    }
 
 #endif // FONT_HPP
@@ -0,0 +1,222 @@
+/*********************************************************************
+*
+*   NAME:
+*       frameScheduler.cpp
+*
+*   DESCRIPTION:
+*       Frame pacing. Each frame has a deadline one period after it
+*       begins. end_frame() optionally waits for the vertical blank,
+*       flushes the framebuffer and records how long rendering and
+*       the transfer took. A late frame moves the schedule instead of
+*       trying to catch up with back-to-back frames.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "frameScheduler.hpp"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+#if !defined(DISPLAYAPI_HOST)
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       GpioTearingEffect::GpioTearingEffect (constructor)
+*
+*   DESCRIPTION:
+*       GpioTearingEffect class constructor, sets the pin as input
+*
+*********************************************************************/
+GpioTearingEffect::GpioTearingEffect(uint te_pin)
+    : _te_pin(te_pin)
+    {
+    gpio_init(_te_pin);
+    gpio_set_dir(_te_pin, GPIO_IN);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       GpioTearingEffect::wait_vblank
+*
+*   DESCRIPTION:
+*       Waits for a rising edge on TE. A blank already in progress is
+*       skipped since it may be nearly over.
+*
+*********************************************************************/
+bool GpioTearingEffect::wait_vblank(uint32_t timeout_us)
+    {
+    uint64_t end = time_us_64() + timeout_us;
+
+    while (gpio_get(_te_pin)) {
+        if (time_us_64() >= end) {
+            return false;
+        }
+    }
+    while (!gpio_get(_te_pin)) {
+        if (time_us_64() >= end) {
+            return false;
+        }
+    }
+    return true;
+    }
+#endif
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       FrameScheduler::FrameScheduler (constructor)
+*
+*   DESCRIPTION:
+*       FrameScheduler class constructor
+*
+*********************************************************************/
+FrameScheduler::FrameScheduler(ST7789VW& display, uint16_t target_fps, TearingEffectSource* te)
+    : _display(display), _clock(display.transport()), _te(nullptr), _period_us(0),
+      _frame_start(0), _next_start(0), _first_start(0), _last_end(0), _stats()
+    {
+    set_target_fps(target_fps);
+    if (te != nullptr) {
+        set_tearing_source(te);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       FrameScheduler::set_target_fps
+*
+*   DESCRIPTION:
+*       Sets the frame rate; 0 runs frames as fast as they complete
+*
+*********************************************************************/
+void FrameScheduler::set_target_fps(uint16_t fps)
+    {
+    _period_us = (fps != 0) ? 1000000u / fps : 0;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       FrameScheduler::set_tearing_source
+*
+*   DESCRIPTION:
+*       Enables TE on the panel and uses te to time the flushes
+*
+*********************************************************************/
+void FrameScheduler::set_tearing_source(TearingEffectSource* te)
+    {
+    _te = te;
+    _display.set_tearing_effect(te != nullptr);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       FrameScheduler::begin_frame
+*
+*   DESCRIPTION:
+*       Waits until the frame's slot starts and begins timing it
+*
+*********************************************************************/
+void FrameScheduler::begin_frame()
+    {
+    uint64_t now = _clock.now_us();
+    if (_next_start > now) {
+        _clock.delay_us((uint32_t)(_next_start - now));
+        now = _clock.now_us();
+    }
+
+    _frame_start = now;
+    if (_stats.frames == 0) {
+        _first_start = now;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       FrameScheduler::end_frame
+*
+*   DESCRIPTION:
+*       Waits for the vertical blank if syncing, flushes the frame
+*       and updates the stats
+*
+*********************************************************************/
+void FrameScheduler::end_frame()
+    {
+    uint64_t render_end = _clock.now_us();
+
+    if (_te != nullptr) {
+        /* a blank comes at least once per refresh, ~16.7 ms at 60 Hz */
+        uint32_t timeout = (_period_us > 20000) ? _period_us : 20000;
+        if (!_te->wait_vblank(timeout)) {
+            _stats.vblank_timeouts++;
+        }
+    }
+
+    uint64_t transfer_start = _clock.now_us();
+    _display.flush();
+    _display.wait();
+    uint64_t end = _clock.now_us();
+
+    uint32_t render_us = (uint32_t)(render_end - _frame_start);
+    uint32_t transfer_us = (uint32_t)(end - transfer_start);
+    _stats.frames++;
+    _stats.last_render_us = render_us;
+    _stats.last_transfer_us = transfer_us;
+    _stats.total_render_us += render_us;
+    _stats.total_transfer_us += transfer_us;
+    if (render_us > _stats.max_render_us) {
+        _stats.max_render_us = render_us;
+    }
+    if (transfer_us > _stats.max_transfer_us) {
+        _stats.max_transfer_us = transfer_us;
+    }
+
+    uint64_t deadline = _frame_start + _period_us;
+    if (_period_us != 0 && end > deadline) {
+        _stats.missed_deadlines++;
+        _next_start = end;
+    } else {
+        _next_start = deadline;
+    }
+    _last_end = end;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       FrameScheduler::reset_stats
+*
+*   DESCRIPTION:
+*       Clears the stats; the next frame starts the FPS measurement
+*
+*********************************************************************/
+void FrameScheduler::reset_stats()
+    {
+    _stats = FrameStats();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       FrameScheduler::achieved_fps_x100
+*
+*   DESCRIPTION:
+*       Average frame rate from the first frame's start to the last
+*       frame's end
+*
+*********************************************************************/
+uint32_t FrameScheduler::achieved_fps_x100() const
+    {
+    if (_stats.frames == 0 || _last_end <= _first_start) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)_stats.frames * 100000000u / (_last_end - _first_start));
+    }
@@ -0,0 +1,97 @@
+#ifndef FRAME_SCHEDULER_HPP
+#define FRAME_SCHEDULER_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       frame pacing: fixed frame rate, optional sync to the panel's
+*       tearing effect (TE) output and per-frame timing stats
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    uint32_t frames;
+    uint32_t missed_deadlines;      /* frames whose transfer ended late     */
+    uint32_t vblank_timeouts;       /* TE waits that gave up                */
+    uint32_t last_render_us;        /* begin_frame() to end_frame()         */
+    uint32_t last_transfer_us;      /* flush until the last byte was out    */
+    uint32_t max_render_us;
+    uint32_t max_transfer_us;
+    uint64_t total_render_us;
+    uint64_t total_transfer_us;
+} FrameStats;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* Source of the panel's vertical blanking signal */
+class TearingEffectSource {
+    public:
+        virtual ~TearingEffectSource( void ) {}
+
+        /* returns at the start of the next vertical blank, or false
+           after timeout_us */
+        virtual bool wait_vblank(uint32_t timeout_us) = 0;
+};
+
+#if !defined(DISPLAYAPI_HOST)
+/* TE wired to a GPIO (high during vertical blanking) */
+class GpioTearingEffect : public TearingEffectSource {
+    public:
+        explicit GpioTearingEffect(uint te_pin);
+
+        bool wait_vblank(uint32_t timeout_us) override;
+
+    private:
+        uint _te_pin;
+};
+#endif
+
+/* Paces frames to a target rate. Draw between begin_frame() and
+   end_frame() with a framebuffer attached: end_frame() waits for the
+   vertical blank (when a TE source is given) and then flushes. Dirty
+   regions go out top to bottom, behind the panel scan for ROTATION_0. */
+class FrameScheduler {
+    public:
+        FrameScheduler(ST7789VW& display, uint16_t target_fps, TearingEffectSource* te = nullptr);
+
+        void set_target_fps(uint16_t fps);
+
+        /* turns the panel's TE output on and syncs to te (nullptr to
+           stop syncing) */
+        void set_tearing_source(TearingEffectSource* te);
+
+        void begin_frame();
+        void end_frame();
+
+        const FrameStats& stats() const { return _stats; }
+        void reset_stats();
+
+        /* frames per second since the first frame, times 100 */
+        uint32_t achieved_fps_x100() const;
+
+        FrameScheduler (const FrameScheduler&) = delete;
+        FrameScheduler& operator= (const FrameScheduler&) = delete;
+
+    private:
+        ST7789VW& _display;
+        DisplayTransport& _clock;
+        TearingEffectSource* _te;
+        uint32_t _period_us;
+
+        uint64_t _frame_start;
+        uint64_t _next_start;
+        uint64_t _first_start;
+        uint64_t _last_end;
+        FrameStats _stats;
+};
+
+#endif // FRAME_SCHEDULER_HPP
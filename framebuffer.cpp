@@ -0,0 +1,170 @@
+/*********************************************************************
+*
+*   NAME:
+*       framebuffer.cpp
+*
+*   DESCRIPTION:
+*       Dirty-region tracking for the optional RAM framebuffer. Each
+*       row keeps one dirty span; flushing merges runs of rows into
+*       rectangles.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "framebuffer.hpp"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DirtyTracker::DirtyTracker (constructor)
+*
+*   DESCRIPTION:
+*       DirtyTracker class constructor
+*
+*********************************************************************/
+DirtyTracker::DirtyTracker()
+    : _width(0), _height(0), _first_row(0), _end_row(0)
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DirtyTracker::reset
+*
+*   DESCRIPTION:
+*       Sets the tracked area and marks it clean
+*
+*********************************************************************/
+void DirtyTracker::reset(uint16_t width, uint16_t height)
+    {
+    _width = width;
+    _height = (height > FRAMEBUFFER_MAX_ROWS) ? FRAMEBUFFER_MAX_ROWS : height;
+    clear();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DirtyTracker::clear
+*
+*   DESCRIPTION:
+*       Marks everything clean
+*
+*********************************************************************/
+void DirtyTracker::clear()
+    {
+    for (uint16_t row = 0; row < _height; row++) {
+        _x_start[row] = _width;
+        _x_end[row] = 0;
+    }
+    _first_row = _height;
+    _end_row = 0;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DirtyTracker::mark
+*
+*   DESCRIPTION:
+*       Adds a rectangle to the dirty region
+*
+*********************************************************************/
+void DirtyTracker::mark(uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+    {
+    if (x >= _width || y >= _height || width == 0 || height == 0) {
+        return;
+    }
+
+    uint16_t x_end = (width > _width - x) ? _width : (uint16_t)(x + width);
+    uint16_t y_end = (height > _height - y) ? _height : (uint16_t)(y + height);
+
+    for (uint16_t row = y; row < y_end; row++) {
+        if (x < _x_start[row]) {
+            _x_start[row] = x;
+        }
+        if (x_end > _x_end[row]) {
+            _x_end[row] = x_end;
+        }
+    }
+
+    if (y < _first_row) {
+        _first_row = y;
+    }
+    if (y_end > _end_row) {
+        _end_row = y_end;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DirtyTracker::mark_all
+*
+*   DESCRIPTION:
+*       Marks the whole area dirty
+*
+*********************************************************************/
+void DirtyTracker::mark_all()
+    {
+    mark(0, 0, _width, _height);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DirtyTracker::next_rect
+*
+*   DESCRIPTION:
+*       Finds the next dirty rectangle starting at row and advances
+*       row past it. A following row is merged in while the clean
+*       pixels it adds to the rectangle stay under
+*       FLUSH_MERGE_SLACK_PIXELS.
+*
+*********************************************************************/
+bool DirtyTracker::next_rect(uint16_t& row, DisplayRect& rect) const
+    {
+    if (row < _first_row) {
+        row = _first_row;
+    }
+    while (row < _end_row && clean(row)) {
+        row++;
+    }
+    if (row >= _end_row) {
+        return false;
+    }
+
+    uint16_t x_start = _x_start[row];
+    uint16_t x_end = _x_end[row];
+    uint16_t y = row;
+    row++;
+
+    while (row < _end_row && !clean(row)) {
+        uint16_t new_start = (_x_start[row] < x_start) ? _x_start[row] : x_start;
+        uint16_t new_end = (_x_end[row] > x_end) ? _x_end[row] : x_end;
+        uint32_t rows = (uint32_t)(row - y);
+        uint32_t added = (uint32_t)(new_end - new_start) * (rows + 1) - (uint32_t)(x_end - x_start) * rows;
+        uint32_t useful = (uint32_t)(_x_end[row] - _x_start[row]);
+
+        if (added - useful > FLUSH_MERGE_SLACK_PIXELS) {
+            break;
+        }
+        x_start = new_start;
+        x_end = new_end;
+        row++;
+    }
+
+    rect.x = x_start;
+    rect.y = y;
+    rect.width = (uint16_t)(x_end - x_start);
+    rect.height = (uint16_t)(row - y);
+    return true;
+    }
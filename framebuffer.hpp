@@ -0,0 +1,63 @@
+#ifndef FRAMEBUFFER_HPP
+#define FRAMEBUFFER_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       dirty-region tracking for the optional RAM framebuffer
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t FRAMEBUFFER_MAX_ROWS = 320;
+
+/* clean pixels worth streaming to save one extra window (CASET + RASET
+   + RAMWR is ~11 bytes in 6 transactions, each costing CS/DC setup) */
+constexpr uint32_t FLUSH_MERGE_SLACK_PIXELS = 32;
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+} DisplayRect;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+class DirtyTracker {
+    public:
+        DirtyTracker();
+
+        void reset(uint16_t width, uint16_t height);
+        void mark(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+        void mark_all();
+        void clear();
+        bool empty() const { return _first_row >= _end_row; }
+
+        /* returns the next rectangle to flush at or after row, merging
+           neighbouring row spans while that is cheaper than a new window */
+        bool next_rect(uint16_t& row, DisplayRect& rect) const;
+
+    private:
+        bool clean(uint16_t row) const { return _x_start[row] >= _x_end[row]; }
+
+        uint16_t _width;
+        uint16_t _height;
+        uint16_t _first_row;
+        uint16_t _end_row;
+        uint16_t _x_start[FRAMEBUFFER_MAX_ROWS];
+        uint16_t _x_end[FRAMEBUFFER_MAX_ROWS];
+};
+
+#endif // FRAMEBUFFER_HPP
@@ -0,0 +1,133 @@
+/*********************************************************************
+*
+*   NAME:
+*       glyphCache.cpp
+*
+*   DESCRIPTION:
+*       Cache of expanded glyphs. A (char, fg, bg) key hashes to a
+*       set of GLYPH_CACHE_WAYS entries; a miss expands the glyph
+*       into the least recently used entry of that set. With the
+*       cache attached, opaque text copies 16 byte glyph rows instead
+*       of testing 64 font bits per character.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "glyphCache.hpp"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       GlyphCache::GlyphCache (constructor)
+*
+*   DESCRIPTION:
+*       GlyphCache class constructor. Entries beyond a whole number
+*       of sets are left unused.
+*
+*********************************************************************/
+GlyphCache::GlyphCache(GlyphCacheEntry* entries, uint16_t entry_count)
+    : _entries(entries), _sets(0), _ways(GLYPH_CACHE_WAYS), _tick(0), _run_start(0), _stats()
+    {
+    if (entry_count < GLYPH_CACHE_WAYS) {
+        _ways = (uint8_t)entry_count;
+        _sets = entry_count ? 1 : 0;
+    } else {
+        _sets = (uint16_t)(entry_count / GLYPH_CACHE_WAYS);
+    }
+    clear();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       GlyphCache::clear
+*
+*   DESCRIPTION:
+*       Empties the cache
+*
+*********************************************************************/
+void GlyphCache::clear()
+    {
+    for (uint16_t i = 0; i < _sets * _ways; i++) {
+        _entries[i].last_use = 0;
+    }
+    _tick = 0;
+    _run_start = 0;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       GlyphCache::begin_run
+*
+*   DESCRIPTION:
+*       Starts a new run; entries used before this may be evicted.
+*       The use counter is restarted long before it can wrap.
+*
+*********************************************************************/
+void GlyphCache::begin_run()
+    {
+    if (_tick > 0xF0000000u) {
+        clear();
+    }
+    _run_start = ++_tick;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       GlyphCache::lookup
+*
+*   DESCRIPTION:
+*       Finds or expands a glyph
+*
+*********************************************************************/
+const uint8_t* GlyphCache::lookup(char c, uint16_t color, uint16_t bg_color)
+    {
+    if (_sets == 0) {
+        return nullptr;
+    }
+
+    uint32_t hash = (uint8_t)c * 0x9E3779B1u ^ color * 0x85EBCA6Bu ^ bg_color * 0xC2B2AE35u;
+    GlyphCacheEntry* set = &_entries[((hash >> 16) % _sets) * _ways];
+    GlyphCacheEntry* victim = nullptr;
+    uint32_t now = ++_tick;
+
+    for (uint8_t way = 0; way < _ways; way++) {
+        GlyphCacheEntry& entry = set[way];
+        if (entry.last_use != 0 && entry.c == c && entry.color == color && entry.bg_color == bg_color) {
+            entry.last_use = now;
+            _stats.hits++;
+            return entry.pixels;
+        }
+        if (entry.last_use < _run_start && (victim == nullptr || entry.last_use < victim->last_use)) {
+            victim = &entry;
+        }
+    }
+
+    if (victim == nullptr) {
+        _stats.bypasses++;
+        return nullptr;
+    }
+
+    if (victim->last_use != 0) {
+        _stats.evictions++;
+    }
+    _stats.misses++;
+
+    victim->last_use = now;
+    victim->c = c;
+    victim->color = color;
+    victim->bg_color = bg_color;
+    for (int i = 0; i < 8; i++) {
+        expand_glyph_row(&victim->pixels[i * 16], font[(uint8_t)c][i], color, bg_color);
+    }
+    return victim->pixels;
+    }
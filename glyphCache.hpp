@@ -0,0 +1,137 @@
+#ifndef GLYPH_CACHE_HPP
+#define GLYPH_CACHE_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       pre-expanded 8x8 glyphs: an LRU cache for (char, fg, bg)
+*       combinations used at run time, and compile-time expansion
+*       of fixed-color strings into flash
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+#include "font.hpp"
+#include "image.hpp"
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t GLYPH_BYTES = 8 * 8 * 2;    /* one 8x8 glyph in wire-order RGB565 */
+constexpr uint8_t GLYPH_CACHE_WAYS = 4;         /* entries per set */
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    uint32_t last_use;          /* 0 when the entry is empty */
+    uint16_t color;
+    uint16_t bg_color;
+    char c;
+    uint8_t pixels[GLYPH_BYTES];
+} GlyphCacheEntry;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;            /* expanded into the cache              */
+    uint32_t evictions;         /* misses that replaced a valid entry   */
+    uint32_t bypasses;          /* misses with every way in use by the
+                                   current run, drawn from the bitmap   */
+} GlyphCacheStats;
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/* expands one font row (MSB = leftmost pixel) into 8 wire-order pixels */
+constexpr void expand_glyph_row(uint8_t* out, uint8_t bits, uint16_t color, uint16_t bg_color)
+    {
+    for (int j = 0; j < 8; j++) {
+        uint16_t pixel = ((bits >> (7 - j)) & 1) ? color : bg_color;
+        out[j * 2] = (uint8_t)(pixel >> 8);
+        out[j * 2 + 1] = (uint8_t)pixel;
+    }
+    }
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* Set-associative cache of expanded glyphs with LRU replacement in
+   each set. Entries handed out since the last begin_run() are never
+   evicted, so a caller can hold every glyph of one text run. */
+class GlyphCache {
+    public:
+        GlyphCache(GlyphCacheEntry* entries, uint16_t entry_count);
+
+        /* entries that fit in a memory budget */
+        static constexpr uint16_t entries_for_budget(size_t bytes) { return (uint16_t)(bytes / sizeof(GlyphCacheEntry)); }
+
+        void begin_run();
+
+        /* returns the 8 rows of 16 bytes for the glyph, or nullptr if
+           it could not be cached without evicting part of this run */
+        const uint8_t* lookup(char c, uint16_t color, uint16_t bg_color);
+
+        void clear();
+
+        uint16_t capacity() const { return (uint16_t)(_sets * _ways); }
+        const GlyphCacheStats& stats() const { return _stats; }
+        void reset_stats() { _stats = GlyphCacheStats(); }
+
+        GlyphCache (const GlyphCache&) = delete;
+        GlyphCache& operator= (const GlyphCache&) = delete;
+
+    private:
+        GlyphCacheEntry* _entries;
+        uint16_t _sets;
+        uint8_t _ways;
+        uint32_t _tick;
+        uint32_t _run_start;
+        GlyphCacheStats _stats;
+};
+
+/* GlyphCache using at most BUDGET_BYTES of RAM for its entries */
+template <size_t BUDGET_BYTES>
+class StaticGlyphCache : public GlyphCache {
+    public:
+        StaticGlyphCache()
+            : GlyphCache(_entry_storage, GlyphCache::entries_for_budget(BUDGET_BYTES))
+            {
+            }
+
+    private:
+        GlyphCacheEntry _entry_storage[BUDGET_BYTES / sizeof(GlyphCacheEntry)];
+};
+
+/* A one line string expanded at compile time. Declared static
+   constexpr it lands in flash and draws with one blit:
+
+       static constexpr auto label = prerender_text("READY", 0x07E0, 0x0000);
+       display.blit(10, 10, label.image());
+*/
+template <size_t LEN>
+struct PrerenderedText {
+    uint8_t pixels[LEN * GLYPH_BYTES];
+
+    constexpr Image image() const
+        {
+        return {(uint16_t)(LEN * 8), 8, ImageFormat::RGB565, pixels, nullptr, 0};
+        }
+};
+
+template <size_t N>
+constexpr PrerenderedText<N - 1> prerender_text(const char (&text)[N], uint16_t color, uint16_t bg_color)
+    {
+    PrerenderedText<N - 1> result = {};
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t k = 0; k < N - 1; k++) {
+            expand_glyph_row(&result.pixels[(i * (N - 1) + k) * 16], font[(uint8_t)text[k]][i], color, bg_color);
+        }
+    }
+    return result;
+    }
+
+#endif // GLYPH_CACHE_HPP
@@ -0,0 +1,419 @@
+/*********************************************************************
+*
+*   NAME:
+*       graphics.cpp
+*
+*   DESCRIPTION:
+*       2D primitives for ST7789VW. Every shape is broken into
+*       horizontal or vertical runs and each run goes out as a single
+*       windowed fill, never pixel by pixel.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "graphics.hpp"
+#include <stdlib.h>
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::Graphics (constructor)
+*
+*   DESCRIPTION:
+*       Graphics class constructor
+*
+*********************************************************************/
+Graphics::Graphics(ST7789VW& display)
+    : _display(display)
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::span
+*
+*   DESCRIPTION:
+*       Clips a rectangle to the current viewport and fills what is
+*       left; the display clips it further to any push_clip rectangle
+*
+*********************************************************************/
+void Graphics::span(int32_t x, int32_t y, int32_t width, int32_t height, uint16_t color)
+    {
+    int32_t x_end = x + width;
+    int32_t y_end = y + height;
+
+    if (x < 0) {
+        x = 0;
+    }
+    if (y < 0) {
+        y = 0;
+    }
+    if (x_end > _display.viewport_width()) {
+        x_end = _display.viewport_width();
+    }
+    if (y_end > _display.viewport_height()) {
+        y_end = _display.viewport_height();
+    }
+    if (x >= x_end || y >= y_end) {
+        return;
+    }
+
+    _display.fill_rect((int16_t)x, (int16_t)y, (uint16_t)(x_end - x), (uint16_t)(y_end - y), color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::draw_hline
+*
+*   DESCRIPTION:
+*       Draws a horizontal line
+*
+*********************************************************************/
+void Graphics::draw_hline(int16_t x, int16_t y, int16_t width, uint16_t color)
+    {
+    span(x, y, width, 1, color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::draw_vline
+*
+*   DESCRIPTION:
+*       Draws a vertical line
+*
+*********************************************************************/
+void Graphics::draw_vline(int16_t x, int16_t y, int16_t height, uint16_t color)
+    {
+    span(x, y, 1, height, color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::fill_rect
+*
+*   DESCRIPTION:
+*       Draws a filled rectangle
+*
+*********************************************************************/
+void Graphics::fill_rect(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color)
+    {
+    span(x, y, width, height, color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::draw_rect
+*
+*   DESCRIPTION:
+*       Draws a rectangle outline
+*
+*********************************************************************/
+void Graphics::draw_rect(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color)
+    {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    span(x, y, width, 1, color);
+    if (height > 1) {
+        span(x, (int32_t)y + height - 1, width, 1, color);
+    }
+    if (height > 2) {
+        span(x, (int32_t)y + 1, 1, height - 2, color);
+        if (width > 1) {
+            span((int32_t)x + width - 1, (int32_t)y + 1, 1, height - 2, color);
+        }
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::draw_line
+*
+*   DESCRIPTION:
+*       Bresenham line. Pixels are gathered into runs along the major
+*       axis (horizontal for shallow lines, vertical for steep ones)
+*       and each run is drawn as one span.
+*
+*********************************************************************/
+void Graphics::draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+    {
+    int32_t dx = abs(x1 - x0);
+    int32_t dy = -abs(y1 - y0);
+    int32_t sx = (x0 < x1) ? 1 : -1;
+    int32_t sy = (y0 < y1) ? 1 : -1;
+    int32_t err = dx + dy;
+    bool shallow = (dx >= -dy);
+
+    int32_t x = x0;
+    int32_t y = y0;
+    int32_t run_x = x;
+    int32_t run_y = y;
+    int32_t run_len = 0;
+
+    while (true) {
+        bool continues = shallow ? (y == run_y) : (x == run_x);
+        if (run_len > 0 && !continues) {
+            if (shallow) {
+                span((sx > 0) ? run_x : run_x - run_len + 1, run_y, run_len, 1, color);
+            } else {
+                span(run_x, (sy > 0) ? run_y : run_y - run_len + 1, 1, run_len, color);
+            }
+            run_len = 0;
+        }
+        if (run_len == 0) {
+            run_x = x;
+            run_y = y;
+        }
+        run_len++;
+
+        if (x == x1 && y == y1) {
+            break;
+        }
+        int32_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+
+    if (shallow) {
+        span((sx > 0) ? run_x : run_x - run_len + 1, run_y, run_len, 1, color);
+    } else {
+        span(run_x, (sy > 0) ? run_y : run_y - run_len + 1, 1, run_len, color);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::arcOutline
+*
+*   DESCRIPTION:
+*       Draws four quarter-circle outlines around the corner centres
+*       (left, top), (right, top), (left, bottom), (right, bottom)
+*       plus the straight edges joining them. A circle has all four
+*       centres equal; a rounded rectangle spreads them apart.
+*
+*       Row dy of the arc covers columns (h(dy + 1), h(dy)] where
+*       h(dy) is the half-width of the disc at that row. Rows that
+*       reduce to the same single column are merged into one vertical
+*       run; the run touching dy = 0 also covers the side edges.
+*
+*********************************************************************/
+void Graphics::arcOutline(int16_t left, int16_t top, int16_t right, int16_t bottom, int16_t radius, uint16_t color)
+    {
+    int32_t limit = (int32_t)radius * radius + radius;
+    int32_t h = radius;
+    bool run = false;
+    int32_t run_x = 0;
+    int32_t run_start = 0;
+    int32_t run_end = 0;
+
+    auto flush_run = [&]() {
+        if (!run) {
+            return;
+        }
+        int32_t len = run_end - run_start + 1;
+        if (run_start == 0) {
+            int32_t side = (int32_t)bottom - top + 2 * run_end + 1;
+            span(left - run_x, top - run_end, 1, side, color);
+            if (right + run_x != left - run_x) {
+                span(right + run_x, top - run_end, 1, side, color);
+            }
+        } else {
+            span(left - run_x, top - run_end, 1, len, color);
+            span(right + run_x, top - run_end, 1, len, color);
+            span(left - run_x, bottom + run_start, 1, len, color);
+            span(right + run_x, bottom + run_start, 1, len, color);
+        }
+        run = false;
+    };
+
+    for (int32_t dy = 0; dy <= radius; dy++) {
+        int32_t next = -1;
+        if (dy < radius) {
+            next = h;
+            while (next >= 0 && next * next + (dy + 1) * (dy + 1) > limit) {
+                next--;
+            }
+        }
+
+        int32_t hi = h;
+        int32_t lo = (next + 1 > hi) ? hi : next + 1;
+
+        if (lo == hi && lo != 0) {
+            if (run && run_x == hi) {
+                run_end = dy;
+            } else {
+                flush_run();
+                run = true;
+                run_x = hi;
+                run_start = dy;
+                run_end = dy;
+            }
+        } else {
+            flush_run();
+            int32_t rows[2] = {top - dy, bottom + dy};
+            int row_count = (dy == 0 && top == bottom) ? 1 : 2;
+            for (int i = 0; i < row_count; i++) {
+                if (lo == 0) {
+                    span(left - hi, rows[i], (int32_t)right - left + 2 * hi + 1, 1, color);
+                } else {
+                    span(right + lo, rows[i], hi - lo + 1, 1, color);
+                    span(left - hi, rows[i], hi - lo + 1, 1, color);
+                }
+            }
+        }
+
+        h = next;
+    }
+    flush_run();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::arcFill
+*
+*   DESCRIPTION:
+*       Fills the shape arcOutline draws. The band between the top
+*       and bottom centres is one rectangle; above and below it, rows
+*       with the same half-width are merged into rectangles too.
+*
+*********************************************************************/
+void Graphics::arcFill(int16_t left, int16_t top, int16_t right, int16_t bottom, int16_t radius, uint16_t color)
+    {
+    int32_t limit = (int32_t)radius * radius + radius;
+    int32_t width = (int32_t)right - left + 1;
+
+    span(left - radius, top, width + 2 * radius, (int32_t)bottom - top + 1, color);
+
+    int32_t h = radius;
+    int32_t group_start = 1;
+    int32_t group_h = -1;
+
+    for (int32_t dy = 1; dy <= radius + 1; dy++) {
+        if (dy <= radius) {
+            while (h >= 0 && h * h + dy * dy > limit) {
+                h--;
+            }
+        } else {
+            h = -1;
+        }
+
+        if (dy > 1 && h != group_h) {
+            int32_t rows = dy - group_start;
+            span(left - group_h, top - (dy - 1), width + 2 * group_h, rows, color);
+            span(left - group_h, bottom + group_start, width + 2 * group_h, rows, color);
+            group_start = dy;
+        }
+        group_h = h;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::draw_circle
+*
+*   DESCRIPTION:
+*       Draws a circle outline
+*
+*********************************************************************/
+void Graphics::draw_circle(int16_t cx, int16_t cy, int16_t radius, uint16_t color)
+    {
+    if (radius < 0) {
+        return;
+    }
+    arcOutline(cx, cy, cx, cy, radius, color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::fill_circle
+*
+*   DESCRIPTION:
+*       Draws a filled circle
+*
+*********************************************************************/
+void Graphics::fill_circle(int16_t cx, int16_t cy, int16_t radius, uint16_t color)
+    {
+    if (radius < 0) {
+        return;
+    }
+    arcFill(cx, cy, cx, cy, radius, color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::draw_round_rect
+*
+*   DESCRIPTION:
+*       Draws a rounded rectangle outline. The radius is limited to
+*       half the shorter side.
+*
+*********************************************************************/
+void Graphics::draw_round_rect(int16_t x, int16_t y, int16_t width, int16_t height, int16_t radius, uint16_t color)
+    {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    int16_t max_radius = ((width < height) ? width - 1 : height - 1) / 2;
+    if (radius > max_radius) {
+        radius = max_radius;
+    }
+    if (radius <= 0) {
+        draw_rect(x, y, width, height, color);
+        return;
+    }
+
+    arcOutline(x + radius, y + radius, x + width - 1 - radius, y + height - 1 - radius, radius, color);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       Graphics::fill_round_rect
+*
+*   DESCRIPTION:
+*       Draws a filled rounded rectangle
+*
+*********************************************************************/
+void Graphics::fill_round_rect(int16_t x, int16_t y, int16_t width, int16_t height, int16_t radius, uint16_t color)
+    {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    int16_t max_radius = ((width < height) ? width - 1 : height - 1) / 2;
+    if (radius > max_radius) {
+        radius = max_radius;
+    }
+    if (radius <= 0) {
+        span(x, y, width, height, color);
+        return;
+    }
+
+    arcFill(x + radius, y + radius, x + width - 1 - radius, y + height - 1 - radius, radius, color);
+    }
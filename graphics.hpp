@@ -0,0 +1,49 @@
+#ifndef GRAPHICS_HPP
+#define GRAPHICS_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       2D primitives (lines, rectangles, circles, rounded boxes)
+*       drawn as horizontal/vertical spans on top of ST7789VW
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* Coordinates are signed and relative to the display's current
+   viewport, so shapes may hang off any edge; everything is clipped to
+   the viewport and to the display's clip rectangle. Each span is sent
+   as one fill_rect burst. */
+class Graphics {
+    public:
+        explicit Graphics(ST7789VW& display);
+
+        void draw_hline(int16_t x, int16_t y, int16_t width, uint16_t color);
+        void draw_vline(int16_t x, int16_t y, int16_t height, uint16_t color);
+        void draw_rect(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color);
+        void fill_rect(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color);
+        void draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+        void draw_circle(int16_t cx, int16_t cy, int16_t radius, uint16_t color);
+        void fill_circle(int16_t cx, int16_t cy, int16_t radius, uint16_t color);
+        void draw_round_rect(int16_t x, int16_t y, int16_t width, int16_t height, int16_t radius, uint16_t color);
+        void fill_round_rect(int16_t x, int16_t y, int16_t width, int16_t height, int16_t radius, uint16_t color);
+
+        Graphics (const Graphics&) = delete;
+        Graphics& operator= (const Graphics&) = delete;
+
+    private:
+        void span(int32_t x, int32_t y, int32_t width, int32_t height, uint16_t color);
+        void arcOutline(int16_t left, int16_t top, int16_t right, int16_t bottom, int16_t radius, uint16_t color);
+        void arcFill(int16_t left, int16_t top, int16_t right, int16_t bottom, int16_t radius, uint16_t color);
+
+        ST7789VW& _display;
+};
+
+#endif // GRAPHICS_HPP
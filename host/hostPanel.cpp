@@ -0,0 +1,329 @@
+/*********************************************************************
+*
+*   NAME:
+*       hostPanel.cpp
+*
+*   DESCRIPTION:
+*       In-memory ST7789 controller model for host builds. Handles
+*       CASET/RASET/RAMWR (12 or 16 bpp)/MADCTL/COLMOD, vertical
+*       scrolling and the on/off and reset commands; parameters of
+*       anything else are ignored.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "hostPanel.hpp"
+#include <stdio.h>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+static const uint8_t CMD_SWRESET = 0x01;
+static const uint8_t CMD_DISPOFF = 0x28;
+static const uint8_t CMD_DISPON  = 0x29;
+static const uint8_t CMD_CASET   = 0x2A;
+static const uint8_t CMD_RASET   = 0x2B;
+static const uint8_t CMD_RAMWR   = 0x2C;
+static const uint8_t CMD_VSCRDEF = 0x33;
+static const uint8_t CMD_VSCSAD  = 0x37;
+static const uint8_t CMD_MADCTL  = 0x36;
+static const uint8_t CMD_COLMOD  = 0x3A;
+
+static const uint8_t MADCTL_MY = 0x80;
+static const uint8_t MADCTL_MX = 0x40;
+static const uint8_t MADCTL_MV = 0x20;
+
+static const uint8_t COLMOD_RESET = 0x66;   /* 18 bpp after reset */
+static const uint8_t COLMOD_12BPP = 0x53;
+static const uint8_t COLMOD_16BPP = 0x55;
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       rgb444To565
+*
+*   DESCRIPTION:
+*       Widens a 12-bit pixel the way the controller does, repeating
+*       the high bits into the new low bits
+*
+*********************************************************************/
+static uint16_t rgb444To565(uint16_t c)
+    {
+    uint16_t r = (c >> 8) & 0xF;
+    uint16_t g = (c >> 4) & 0xF;
+    uint16_t b = c & 0xF;
+    return (uint16_t)((((r << 1) | (r >> 3)) << 11) | (((g << 2) | (g >> 2)) << 5) | ((b << 1) | (b >> 3)));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostPanel::HostPanel (constructor)
+*
+*   DESCRIPTION:
+*       HostPanel class constructor, memory starts out black
+*
+*********************************************************************/
+HostPanel::HostPanel(uint16_t map_width, uint16_t map_height)
+    : _map_width(map_width), _map_height(map_height), _memory((size_t)map_width * map_height, 0x0000),
+      _cmd(0), _param_count(0), _madctl(0), _colmod(COLMOD_RESET), _display_on(false),
+      _col_start(0), _col_end(map_width - 1), _row_start(0), _row_end(map_height - 1),
+      _cur_col(0), _cur_row(0), _scroll_top(0), _scroll_rows(map_height), _scroll_start(0), _pending_count(0), _stray_bytes(0), _pixels_written(0)
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostPanel::command
+*
+*   DESCRIPTION:
+*       Handles a byte sent with D/C low
+*
+*********************************************************************/
+void HostPanel::command(uint8_t cmd)
+    {
+    _cmd = cmd;
+    _param_count = 0;
+    _pending_count = 0;
+
+    switch (cmd) {
+        case CMD_SWRESET:
+            _madctl = 0;
+            _colmod = COLMOD_RESET;
+            _display_on = false;
+            _col_start = 0;
+            _col_end = _map_width - 1;
+            _row_start = 0;
+            _row_end = _map_height - 1;
+            _scroll_top = 0;
+            _scroll_rows = _map_height;
+            _scroll_start = 0;
+            break;
+        case CMD_DISPON:
+            _display_on = true;
+            break;
+        case CMD_DISPOFF:
+            _display_on = false;
+            break;
+        case CMD_RAMWR:
+            _cur_col = _col_start;
+            _cur_row = _row_start;
+            break;
+        default:
+            break;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostPanel::data
+*
+*   DESCRIPTION:
+*       Handles bytes sent with D/C high for the current command
+*
+*********************************************************************/
+void HostPanel::data(const uint8_t* data, size_t len)
+    {
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = data[i];
+
+        if (_cmd == CMD_RAMWR) {
+            if (_colmod == COLMOD_16BPP) {
+                _pending[_pending_count++] = b;
+                if (_pending_count == 2) {
+                    writePixel((uint16_t)((_pending[0] << 8) | _pending[1]));
+                    _pending_count = 0;
+                }
+            } else if (_colmod == COLMOD_12BPP) {
+                /* 2 pixels per 3 bytes; a pixel lands once its 12 bits are in */
+                _pending[_pending_count++] = b;
+                if (_pending_count == 2) {
+                    writePixel(rgb444To565((uint16_t)((_pending[0] << 4) | (_pending[1] >> 4))));
+                } else if (_pending_count == 3) {
+                    writePixel(rgb444To565((uint16_t)(((_pending[1] & 0x0F) << 8) | _pending[2])));
+                    _pending_count = 0;
+                }
+            } else {
+                _stray_bytes++;
+            }
+            continue;
+        }
+
+        if (_param_count < sizeof(_params)) {
+            _params[_param_count] = b;
+        }
+        _param_count++;
+
+        switch (_cmd) {
+            case CMD_CASET:
+                if (_param_count == 4) {
+                    _col_start = (uint16_t)((_params[0] << 8) | _params[1]);
+                    _col_end = (uint16_t)((_params[2] << 8) | _params[3]);
+                }
+                break;
+            case CMD_RASET:
+                if (_param_count == 4) {
+                    _row_start = (uint16_t)((_params[0] << 8) | _params[1]);
+                    _row_end = (uint16_t)((_params[2] << 8) | _params[3]);
+                }
+                break;
+            case CMD_VSCRDEF:
+                if (_param_count == 6) {
+                    _scroll_top = (uint16_t)((_params[0] << 8) | _params[1]);
+                    _scroll_rows = (uint16_t)((_params[2] << 8) | _params[3]);
+                }
+                break;
+            case CMD_VSCSAD:
+                if (_param_count == 2) {
+                    _scroll_start = (uint16_t)((_params[0] << 8) | _params[1]);
+                }
+                break;
+            case CMD_MADCTL:
+                if (_param_count == 1) {
+                    _madctl = b;
+                }
+                break;
+            case CMD_COLMOD:
+                if (_param_count == 1) {
+                    _colmod = b;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostPanel::writePixel
+*
+*   DESCRIPTION:
+*       Stores one pixel at the address counter, mapping the window
+*       through MADCTL, then advances the counter
+*
+*********************************************************************/
+void HostPanel::writePixel(uint16_t color)
+    {
+    uint16_t px = _cur_col;
+    uint16_t py = _cur_row;
+
+    if (_madctl & MADCTL_MV) {
+        px = _cur_row;
+        py = _cur_col;
+    }
+    if (_madctl & MADCTL_MX) {
+        px = (uint16_t)(_map_width - 1 - px);
+    }
+    if (_madctl & MADCTL_MY) {
+        py = (uint16_t)(_map_height - 1 - py);
+    }
+
+    if (px < _map_width && py < _map_height) {
+        _memory[(size_t)py * _map_width + px] = color;
+        _pixels_written++;
+    } else {
+        _stray_bytes += 2;
+    }
+
+    if (_cur_col >= _col_end) {
+        _cur_col = _col_start;
+        _cur_row = (_cur_row >= _row_end) ? _row_start : (uint16_t)(_cur_row + 1);
+    } else {
+        _cur_col++;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostPanel::pixel
+*
+*   DESCRIPTION:
+*       Returns a pixel from panel memory
+*
+*********************************************************************/
+uint16_t HostPanel::pixel(uint16_t x, uint16_t y) const
+    {
+    if (x >= _map_width || y >= _map_height) {
+        return 0;
+    }
+    return _memory[(size_t)y * _map_width + x];
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostPanel::displayed_pixel
+*
+*   DESCRIPTION:
+*       Returns the pixel shown at glass position x, y. Rows inside
+*       the scroll area come from memory starting at the VSCSAD row
+*       and wrapping within the area.
+*
+*********************************************************************/
+uint16_t HostPanel::displayed_pixel(uint16_t x, uint16_t y) const
+    {
+    uint32_t scroll_end = (uint32_t)_scroll_top + _scroll_rows;
+    if (_scroll_rows == 0 || y < _scroll_top || y >= scroll_end || _scroll_start < _scroll_top || _scroll_start >= scroll_end) {
+        return pixel(x, y);
+    }
+
+    uint32_t offset = (uint32_t)(y - _scroll_top) + (_scroll_start - _scroll_top);
+    return pixel(x, (uint16_t)(_scroll_top + offset % _scroll_rows));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostPanel::clear
+*
+*   DESCRIPTION:
+*       Sets all of panel memory to a color
+*
+*********************************************************************/
+void HostPanel::clear(uint16_t color)
+    {
+    for (uint16_t& px : _memory) {
+        px = color;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostPanel::write_ppm
+*
+*   DESCRIPTION:
+*       Dumps what the glass shows as a binary PPM (P6)
+*
+*********************************************************************/
+bool HostPanel::write_ppm(const char* path) const
+    {
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) {
+        return false;
+    }
+
+    fprintf(f, "P6\n%u %u\n255\n", (unsigned)_map_width, (unsigned)_map_height);
+    for (uint32_t i = 0; i < _memory.size(); i++) {
+        uint16_t px = displayed_pixel((uint16_t)(i % _map_width), (uint16_t)(i / _map_width));
+        uint8_t r = (uint8_t)((px >> 11) & 0x1F);
+        uint8_t g = (uint8_t)((px >> 5) & 0x3F);
+        uint8_t b = (uint8_t)(px & 0x1F);
+        uint8_t rgb[3] = {(uint8_t)((r << 3) | (r >> 2)), (uint8_t)((g << 2) | (g >> 4)), (uint8_t)((b << 3) | (b >> 2))};
+        fwrite(rgb, 1, sizeof(rgb), f);
+    }
+
+    return fclose(f) == 0;
+    }
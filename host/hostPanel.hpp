@@ -0,0 +1,79 @@
+#ifndef HOST_PANEL_HPP
+#define HOST_PANEL_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       in-memory model of an ST7789 controller for host builds.
+*       Decodes the command stream into a panel framebuffer.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+class HostPanel {
+    public:
+        HostPanel(uint16_t map_width, uint16_t map_height);
+
+        void command(uint8_t cmd);
+        void data(const uint8_t* data, size_t len);
+
+        /* RGB565 pixel in panel memory coordinates (before MADCTL) */
+        uint16_t pixel(uint16_t x, uint16_t y) const;
+        /* pixel as shown on the glass, after vertical scrolling */
+        uint16_t displayed_pixel(uint16_t x, uint16_t y) const;
+        bool write_ppm(const char* path) const;
+        void clear(uint16_t color = 0x0000);
+
+        uint16_t width() const { return _map_width; }
+        uint16_t height() const { return _map_height; }
+        uint8_t madctl() const { return _madctl; }
+        uint8_t colmod() const { return _colmod; }
+        bool display_on() const { return _display_on; }
+
+        /* pixels written outside of a RAMWR or past the panel edge */
+        uint32_t stray_bytes() const { return _stray_bytes; }
+        uint32_t pixels_written() const { return _pixels_written; }
+
+    private:
+        void writePixel(uint16_t color);
+
+        uint16_t _map_width;
+        uint16_t _map_height;
+        std::vector<uint16_t> _memory;
+
+        uint8_t _cmd;
+        uint8_t _params[6];
+        size_t _param_count;
+
+        uint8_t _madctl;
+        uint8_t _colmod;
+        bool _display_on;
+
+        uint16_t _col_start;
+        uint16_t _col_end;
+        uint16_t _row_start;
+        uint16_t _row_end;
+        uint16_t _cur_col;
+        uint16_t _cur_row;
+
+        uint16_t _scroll_top;
+        uint16_t _scroll_rows;
+        uint16_t _scroll_start;
+
+        uint8_t _pending[3];
+        size_t _pending_count;
+
+        uint32_t _stray_bytes;
+        uint32_t _pixels_written;
+};
+
+#endif // HOST_PANEL_HPP
@@ -0,0 +1,66 @@
+/*********************************************************************
+*
+*   NAME:
+*       hostReport.cpp
+*
+*   DESCRIPTION:
+*       Turns HostTransport counters into modelled bus time and JSON.
+*       Wall time is bits on the wire at the bus clock, plus a fixed
+*       cost per transaction and per D/C change, which dominate for
+*       small writes such as window setup and single glyphs.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "hostReport.hpp"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       host_modeled_ns
+*
+*   DESCRIPTION:
+*       Modelled wall time of the recorded traffic
+*
+*********************************************************************/
+uint64_t host_modeled_ns(const HostTransportStats& stats, const HostBusModel& model)
+    {
+    uint64_t ns = 0;
+    if (model.clock_hz != 0) {
+        ns = (uint64_t)stats.bytes * 8u * 1000000000u / model.clock_hz;
+    }
+    ns += (uint64_t)stats.transactions * model.transaction_ns;
+    ns += (uint64_t)stats.dc_changes * model.dc_change_ns;
+    return ns;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       host_write_stats_json
+*
+*   DESCRIPTION:
+*       Writes the counters and modelled times as a JSON object
+*
+*********************************************************************/
+void host_write_stats_json(FILE* f, const char* name, const HostTransportStats& stats,
+                           const HostBusModel* models, size_t model_count)
+    {
+    fprintf(f, "{\"name\": \"%s\", \"transactions\": %lu, \"writes\": %lu, \"bytes\": %lu, "
+               "\"command_bytes\": %lu, \"data_bytes\": %lu, \"dc_changes\": %lu, \"modeled_us\": {",
+            name, (unsigned long)stats.transactions, (unsigned long)stats.writes, (unsigned long)stats.bytes,
+            (unsigned long)stats.command_bytes, (unsigned long)stats.data_bytes, (unsigned long)stats.dc_changes);
+
+    for (size_t i = 0; i < model_count; i++) {
+        fprintf(f, "%s\"%lu\": %.1f", (i == 0) ? "" : ", ", (unsigned long)models[i].clock_hz,
+                host_modeled_ns(stats, models[i]) / 1000.0);
+    }
+    fprintf(f, "}}");
+    }
@@ -0,0 +1,46 @@
+#ifndef HOST_REPORT_HPP
+#define HOST_REPORT_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       SPI wall-time model and JSON reports for HostTransport
+*       statistics
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "hostTransport.hpp"
+#include <stdio.h>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    uint32_t clock_hz;
+    uint32_t transaction_ns;    /* CS assert/release and call setup     */
+    uint32_t dc_change_ns;      /* FIFO drain + GPIO before D/C moves   */
+} HostBusModel;
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+/* overheads are estimates for an RP2040 at 125 MHz driving the bus
+   from the CPU; replace them with scope measurements when available */
+constexpr HostBusModel HOST_BUS_31_25MHZ = {31250000, 1000, 200};
+constexpr HostBusModel HOST_BUS_62_5MHZ = {62500000, 1000, 200};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/* time the recorded traffic would take on the modelled bus */
+uint64_t host_modeled_ns(const HostTransportStats& stats, const HostBusModel& model);
+
+/* writes one JSON object (no trailing newline) with the counters and
+   the modelled time for each bus model */
+void host_write_stats_json(FILE* f, const char* name, const HostTransportStats& stats,
+                           const HostBusModel* models, size_t model_count);
+
+#endif // HOST_REPORT_HPP
@@ -0,0 +1,365 @@
+/*********************************************************************
+*
+*   NAME:
+*       hostTransport.cpp
+*
+*   DESCRIPTION:
+*       Host backend for DisplayTransport. Nothing is sent anywhere;
+*       traffic is counted and decoded by an optional HostPanel so
+*       driver output and throughput can be checked without hardware.
+*       With a bus clock set, transfers take the time they would on
+*       the wire and async transfers are only decoded once that time
+*       has passed, so a buffer reused too early shows up as corrupt
+*       pixels in the panel model.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "hostTransport.hpp"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::HostTransport (constructor)
+*
+*   DESCRIPTION:
+*       HostTransport class constructor
+*
+*********************************************************************/
+HostTransport::HostTransport(HostPanel* panel)
+    : _panel(panel), _stats(), _selected(false), _dc(false), _reset_level(true), _delayed_ms(0), _delayed_us(0), _epoch(Clock::now()), _bus_hz(0),
+      _pending_data(nullptr), _pending_len(0), _wait_ns(0)
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::init
+*
+*   DESCRIPTION:
+*       Releases CS, as the Pico backend does
+*
+*********************************************************************/
+void HostTransport::init()
+    {
+    _selected = false;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::select
+*
+*   DESCRIPTION:
+*       Asserts chip select and counts the transaction
+*
+*********************************************************************/
+void HostTransport::select()
+    {
+    completePending(true);
+    if (!_selected) {
+        _stats.transactions++;
+    }
+    _selected = true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::deselect
+*
+*   DESCRIPTION:
+*       Releases chip select
+*
+*********************************************************************/
+void HostTransport::deselect()
+    {
+    completePending(true);
+    _selected = false;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::set_dc
+*
+*   DESCRIPTION:
+*       Latches the data/command line
+*
+*********************************************************************/
+void HostTransport::set_dc(bool data)
+    {
+    completePending(true);
+    if (_selected && data != _dc) {
+        _stats.dc_changes++;
+    }
+    _dc = data;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::write
+*
+*   DESCRIPTION:
+*       Blocking write, takes the simulated wire time (counted as
+*       waiting, since the CPU can do nothing else meanwhile)
+*
+*********************************************************************/
+void HostTransport::write(const uint8_t* data, size_t len)
+    {
+    wait();
+    if (_bus_hz != 0) {
+        Clock::time_point start = Clock::now();
+        Clock::time_point end = transferEnd(len);
+        while (Clock::now() < end) {
+        }
+        addWait(start);
+    }
+    deliver(data, len);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::write_async
+*
+*   DESCRIPTION:
+*       Starts a simulated transfer. The bytes are decoded when the
+*       transfer completes, not when it starts.
+*
+*********************************************************************/
+void HostTransport::write_async(const uint8_t* data, size_t len)
+    {
+    wait();
+    _stats.async_writes++;
+    _pending_data = data;
+    _pending_len = len;
+    _pending_end = transferEnd(len);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::busy
+*
+*   DESCRIPTION:
+*       Returns true until the simulated transfer time has passed
+*
+*********************************************************************/
+bool HostTransport::busy()
+    {
+    if (_pending_len == 0) {
+        return false;
+    }
+    if (Clock::now() < _pending_end) {
+        return true;
+    }
+    completePending(false);
+    return false;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::wait
+*
+*   DESCRIPTION:
+*       Blocks until the current simulated transfer completes
+*
+*********************************************************************/
+void HostTransport::wait()
+    {
+    if (_pending_len == 0) {
+        return;
+    }
+
+    Clock::time_point start = Clock::now();
+    while (Clock::now() < _pending_end) {
+    }
+    addWait(start);
+    completePending(false);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::addWait
+*
+*   DESCRIPTION:
+*       Adds the time since start to wait_us, keeping the sub-us
+*       remainder so many short waits add up
+*
+*********************************************************************/
+void HostTransport::addWait(Clock::time_point start)
+    {
+    _wait_ns += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    _stats.wait_us = _wait_ns / 1000u;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::completePending
+*
+*   DESCRIPTION:
+*       Decodes an in-flight async transfer. With early_check set the
+*       caller is about to touch CS or D/C, which is a driver bug if
+*       the transfer has not finished yet.
+*
+*********************************************************************/
+void HostTransport::completePending(bool early_check)
+    {
+    if (_pending_len == 0) {
+        return;
+    }
+    if (early_check && Clock::now() < _pending_end) {
+        _stats.early_releases++;
+    }
+
+    const uint8_t* data = _pending_data;
+    size_t len = _pending_len;
+    _pending_data = nullptr;
+    _pending_len = 0;
+    deliver(data, len);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::transferEnd
+*
+*   DESCRIPTION:
+*       Returns when a transfer of len bytes started now would finish
+*
+*********************************************************************/
+HostTransport::Clock::time_point HostTransport::transferEnd(size_t len) const
+    {
+    if (_bus_hz == 0) {
+        return Clock::now();
+    }
+    uint64_t ns = (uint64_t)len * 8u * 1000000000u / _bus_hz;
+    return Clock::now() + std::chrono::nanoseconds(ns);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::deliver
+*
+*   DESCRIPTION:
+*       Counts a write and forwards it to the panel model. Bytes
+*       written while CS is released never reach the panel.
+*
+*********************************************************************/
+void HostTransport::deliver(const uint8_t* data, size_t len)
+    {
+    _stats.writes++;
+    _stats.bytes += (uint32_t)len;
+
+    if (!_selected) {
+        _stats.unselected_bytes += (uint32_t)len;
+        return;
+    }
+
+    if (_dc) {
+        _stats.data_bytes += (uint32_t)len;
+        if (_panel != nullptr) {
+            _panel->data(data, len);
+        }
+        return;
+    }
+
+    _stats.command_bytes += (uint32_t)len;
+    for (size_t i = 0; i < len; i++) {
+        _stats.command_counts[data[i]]++;
+        if (_panel != nullptr) {
+            _panel->command(data[i]);
+        }
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::set_reset
+*
+*   DESCRIPTION:
+*       A rising edge on reset resets the panel model
+*
+*********************************************************************/
+void HostTransport::set_reset(bool level)
+    {
+    if (level && !_reset_level && _panel != nullptr) {
+        _panel->command(0x01);
+    }
+    _reset_level = level;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::delay_ms
+*
+*   DESCRIPTION:
+*       Delays are accumulated rather than slept
+*
+*********************************************************************/
+void HostTransport::delay_ms(uint32_t ms)
+    {
+    _delayed_ms += ms;
+    _delayed_us += (uint64_t)ms * 1000;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::now_us
+*
+*   DESCRIPTION:
+*       Simulated clock: elapsed real time (simulated transfers
+*       included) plus the accumulated delays
+*
+*********************************************************************/
+uint64_t HostTransport::now_us()
+    {
+    uint64_t real = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - _epoch).count();
+    return real + _delayed_us;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::delay_us
+*
+*   DESCRIPTION:
+*       Delays are accumulated rather than slept
+*
+*********************************************************************/
+void HostTransport::delay_us(uint32_t us)
+    {
+    _delayed_us += us;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostTransport::reset_stats
+*
+*   DESCRIPTION:
+*       Clears the traffic counters
+*
+*********************************************************************/
+void HostTransport::reset_stats()
+    {
+    _stats = HostTransportStats();
+    _wait_ns = 0;
+    }
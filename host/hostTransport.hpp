@@ -0,0 +1,95 @@
+#ifndef HOST_TRANSPORT_HPP
+#define HOST_TRANSPORT_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       host backend for DisplayTransport. Counts bus traffic and
+*       optionally feeds it to a HostPanel model.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayTransport.hpp"
+#include "hostPanel.hpp"
+#include <chrono>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    uint32_t transactions;          /* CS assertions                        */
+    uint32_t writes;                /* write() calls                        */
+    uint32_t bytes;                 /* all bytes written                    */
+    uint32_t command_bytes;         /* bytes written with D/C low           */
+    uint32_t data_bytes;            /* bytes written with D/C high          */
+    uint32_t unselected_bytes;      /* bytes written with CS released (bug) */
+    uint32_t async_writes;          /* write_async() calls                  */
+    uint32_t early_releases;        /* CS or D/C changed mid-transfer (bug) */
+    uint32_t dc_changes;            /* D/C level changes while selected     */
+    uint64_t wait_us;               /* time blocked on simulated transfers  */
+    uint32_t command_counts[256];   /* per opcode                           */
+} HostTransportStats;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+class HostTransport : public DisplayTransport {
+    public:
+        explicit HostTransport(HostPanel* panel = nullptr);
+
+        void init() override;
+        void select() override;
+        void deselect() override;
+        void set_dc(bool data) override;
+        void write(const uint8_t* data, size_t len) override;
+        void write_async(const uint8_t* data, size_t len) override;
+        bool busy() override;
+        void wait() override;
+        void set_reset(bool level) override;
+        void delay_ms(uint32_t ms) override;
+
+        /* real time since construction plus every delay, which is
+           added to the clock instead of slept */
+        uint64_t now_us() override;
+        void delay_us(uint32_t us) override;
+
+        /* simulated SPI clock; 0 (default) makes every transfer instant */
+        void set_bus_clock(uint32_t hz) override { _bus_hz = hz; }
+
+        const HostTransportStats& stats() const { return _stats; }
+        void reset_stats();
+
+        bool selected() const { return _selected; }
+        uint32_t delayed_ms() const { return _delayed_ms; }
+
+        HostTransport (const HostTransport&) = delete;
+        HostTransport& operator= (const HostTransport&) = delete;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        void deliver(const uint8_t* data, size_t len);
+        Clock::time_point transferEnd(size_t len) const;
+        void completePending(bool early_check);
+        void addWait(Clock::time_point start);
+
+        HostPanel* _panel;
+        HostTransportStats _stats;
+        bool _selected;
+        bool _dc;
+        bool _reset_level;
+        uint32_t _delayed_ms;
+        uint64_t _delayed_us;
+        Clock::time_point _epoch;
+        uint32_t _bus_hz;
+
+        const uint8_t* _pending_data;
+        size_t _pending_len;
+        Clock::time_point _pending_end;
+        uint64_t _wait_ns;
+};
+
+#endif // HOST_TRANSPORT_HPP
@@ -0,0 +1,80 @@
+/*********************************************************************
+*
+*   NAME:
+*       hostVsync.cpp
+*
+*   DESCRIPTION:
+*       Simulated tearing effect source. Blanks fall on multiples of
+*       the refresh period of HostTransport::now_us(), so frame pacing
+*       can be exercised on the host without real waiting.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "hostVsync.hpp"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostVsync::HostVsync (constructor)
+*
+*   DESCRIPTION:
+*       HostVsync class constructor
+*
+*********************************************************************/
+HostVsync::HostVsync(HostTransport& clock, uint32_t period_us)
+    : _clock(clock), _period_us(period_us), _vblanks(0)
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostVsync::wait_vblank
+*
+*   DESCRIPTION:
+*       Advances the clock to the next blank, or by timeout_us if
+*       that comes first
+*
+*********************************************************************/
+bool HostVsync::wait_vblank(uint32_t timeout_us)
+    {
+    if (_period_us == 0) {
+        return false;
+    }
+
+    uint64_t now = _clock.now_us();
+    uint64_t next = (now / _period_us + 1) * _period_us;
+    if (next - now > timeout_us) {
+        _clock.delay_us(timeout_us);
+        return false;
+    }
+
+    _clock.delay_us((uint32_t)(next - now));
+    _vblanks++;
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       HostVsync::scanline
+*
+*   DESCRIPTION:
+*       Position of the refresh within the current period
+*
+*********************************************************************/
+uint16_t HostVsync::scanline(uint16_t rows)
+    {
+    if (_period_us == 0) {
+        return 0;
+    }
+    return (uint16_t)((_clock.now_us() % _period_us) * rows / _period_us);
+    }
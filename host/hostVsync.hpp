@@ -0,0 +1,40 @@
+#ifndef HOST_VSYNC_HPP
+#define HOST_VSYNC_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       simulated TE signal for host builds, running on the
+*       HostTransport clock
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "frameScheduler.hpp"
+#include "hostTransport.hpp"
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* Vertical blanks every period_us of transport time, the first one
+   at time 0. Waiting advances the simulated clock. */
+class HostVsync : public TearingEffectSource {
+    public:
+        HostVsync(HostTransport& clock, uint32_t period_us);
+
+        bool wait_vblank(uint32_t timeout_us) override;
+
+        /* row the panel is refreshing at the current time */
+        uint16_t scanline(uint16_t rows);
+
+        uint32_t vblanks() const { return _vblanks; }
+
+    private:
+        HostTransport& _clock;
+        uint32_t _period_us;
+        uint32_t _vblanks;
+};
+
+#endif // HOST_VSYNC_HPP
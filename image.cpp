@@ -0,0 +1,145 @@
+/*********************************************************************
+*
+*   NAME:
+*       image.cpp
+*
+*   DESCRIPTION:
+*       Row decoders for the packed image formats. Rows are decoded
+*       on the fly into a line buffer so images never need a RAM copy.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "image.hpp"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ImageRowDecoder::ImageRowDecoder (constructor)
+*
+*   DESCRIPTION:
+*       ImageRowDecoder class constructor, positioned at row 0
+*
+*********************************************************************/
+ImageRowDecoder::ImageRowDecoder(const Image& image, Dither dither, uint16_t x, uint16_t y)
+    : _image(image), _bpp(0), _row_bytes(0), _row(0), _dither(dither), _x(x), _y(y),
+      _rle(image.data), _run_left(0), _run_index(0)
+    {
+    switch (image.format) {
+        case ImageFormat::RGB565:
+            _bpp = 16;
+            break;
+        case ImageFormat::INDEXED_1BPP:
+            _bpp = 1;
+            break;
+        case ImageFormat::INDEXED_2BPP:
+            _bpp = 2;
+            break;
+        case ImageFormat::INDEXED_4BPP:
+            _bpp = 4;
+            break;
+        case ImageFormat::INDEXED_8BPP:
+        case ImageFormat::RLE8:
+            _bpp = 8;
+            break;
+        case ImageFormat::RGB888:
+            _bpp = 24;
+            break;
+        case ImageFormat::ARGB8888:
+            _bpp = 32;
+            break;
+    }
+    _row_bytes = ((size_t)image.width * _bpp + 7) / 8;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ImageRowDecoder::raw_row
+*
+*   DESCRIPTION:
+*       Returns a row of an RGB565 image in place
+*
+*********************************************************************/
+const uint8_t* ImageRowDecoder::raw_row(uint16_t row) const
+    {
+    return &_image.data[(size_t)row * _row_bytes];
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ImageRowDecoder::paletteIndex
+*
+*   DESCRIPTION:
+*       Extracts one packed palette index from a row
+*
+*********************************************************************/
+uint8_t ImageRowDecoder::paletteIndex(const uint8_t* row, uint16_t column) const
+    {
+    uint32_t bit = (uint32_t)column * _bpp;
+    uint8_t shift = (uint8_t)(8 - _bpp - (bit & 7));
+    return (uint8_t)((row[bit >> 3] >> shift) & ((1u << _bpp) - 1));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ImageRowDecoder::decode_row
+*
+*   DESCRIPTION:
+*       Decodes the next row into out. Only the columns pixels from
+*       column first on are written; the rest of the row (RLE runs
+*       included) is consumed. Palette indices past palette_size
+*       decode as black.
+*
+*********************************************************************/
+void ImageRowDecoder::decode_row(uint8_t* out, uint16_t columns, uint16_t first)
+    {
+    const uint16_t* palette = _image.palette;
+    uint16_t palette_size = _image.palette_size;
+    uint16_t end = first + columns;
+
+    if (_image.format == ImageFormat::RGB565) {
+        const uint8_t* src = raw_row(_row) + first * 2;
+        for (uint16_t i = 0; i < columns * 2; i++) {
+            out[i] = src[i];
+        }
+    } else if (_image.format == ImageFormat::RGB888) {
+        rgb888_to_wire565(out, raw_row(_row) + first * 3, columns, _dither, (uint16_t)(_x + first), (uint16_t)(_y + _row));
+    } else if (_image.format == ImageFormat::ARGB8888) {
+        const uint32_t* src = reinterpret_cast<const uint32_t*>(raw_row(_row)) + first;
+        argb8888_to_wire565(out, src, columns, _dither, (uint16_t)(_x + first), (uint16_t)(_y + _row));
+    } else if (_image.format == ImageFormat::RLE8) {
+        for (uint16_t i = 0; i < _image.width; i++) {
+            if (_run_left == 0) {
+                _run_left = (uint16_t)(_rle[0] + 1);
+                _run_index = _rle[1];
+                _rle += 2;
+            }
+            _run_left--;
+            if (i >= first && i < end) {
+                uint16_t color = (_run_index < palette_size) ? palette[_run_index] : 0x0000;
+                *out++ = (uint8_t)(color >> 8);
+                *out++ = (uint8_t)color;
+            }
+        }
+    } else {
+        const uint8_t* src = raw_row(_row);
+        for (uint16_t i = first; i < end; i++) {
+            uint8_t index = paletteIndex(src, i);
+            uint16_t color = (index < palette_size) ? palette[index] : 0x0000;
+            *out++ = (uint8_t)(color >> 8);
+            *out++ = (uint8_t)color;
+        }
+    }
+
+    _row++;
+    }
@@ -0,0 +1,75 @@
+#ifndef IMAGE_HPP
+#define IMAGE_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       image formats for ST7789VW::blit and their row decoders
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "colorConvert.hpp"
+#include <stddef.h>
+#include <stdint.h>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+enum class ImageFormat : uint8_t {
+    RGB565,         /* 2 bytes per pixel, big-endian (wire order)             */
+    INDEXED_1BPP,   /* palette indices, MSB first, rows padded to a byte      */
+    INDEXED_2BPP,
+    INDEXED_4BPP,
+    INDEXED_8BPP,
+    RLE8,           /* (run length - 1, palette index) pairs, runs span rows  */
+    RGB888,         /* R, G, B bytes, converted (and dithered) while drawing  */
+    ARGB8888        /* 0xAARRGGBB words in native order, 4-byte aligned,
+                       alpha ignored                                          */
+};
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    ImageFormat format;
+    const uint8_t* data;
+    const uint16_t* palette;    /* RGB565 colors, indexed and RLE8 only */
+    uint16_t palette_size;
+} Image;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* Decodes an image one row at a time into wire-order RGB565 */
+class ImageRowDecoder {
+    public:
+        /* x, y is where the image lands on screen, which sets the
+           dither phase for RGB888 and ARGB8888 images */
+        explicit ImageRowDecoder(const Image& image, Dither dither = Dither::NONE, uint16_t x = 0, uint16_t y = 0);
+
+        /* decodes the next row, keeping columns pixels from column first */
+        void decode_row(uint8_t* out, uint16_t columns, uint16_t first = 0);
+
+        /* RGB565 rows can be sent straight from the image data */
+        const uint8_t* raw_row(uint16_t row) const;
+
+    private:
+        uint8_t paletteIndex(const uint8_t* row, uint16_t column) const;
+
+        const Image& _image;
+        uint8_t _bpp;
+        size_t _row_bytes;
+        uint16_t _row;
+        Dither _dither;
+        uint16_t _x;
+        uint16_t _y;
+
+        /* RLE8 decode state */
+        const uint8_t* _rle;
+        uint16_t _run_left;
+        uint8_t _run_index;
+};
+
+#endif // IMAGE_HPP
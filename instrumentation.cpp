@@ -0,0 +1,232 @@
+/*********************************************************************
+*
+*   NAME:
+*       instrumentation.cpp
+*
+*   DESCRIPTION:
+*       Counters and trace ring behind DISPLAYAPI_INSTRUMENTATION.
+*       Bus activity is charged to the API call in progress; each
+*       finished call is logged to a fixed ring with its start time,
+*       duration, area and data volume.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "instrumentation.hpp"
+#include <stdio.h>
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::DisplayInstrumentation (constructor)
+*
+*   DESCRIPTION:
+*       DisplayInstrumentation class constructor
+*
+*********************************************************************/
+DisplayInstrumentation::DisplayInstrumentation(DisplayTransport& clock)
+    : _clock(clock), _counters(), _op(DisplayOp::OTHER), _depth(0), _entry(), _entry_start(0),
+      _ring(), _ring_next(0), _ring_count(0)
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::begin
+*
+*   DESCRIPTION:
+*       Starts an API call, unless one is already running
+*
+*********************************************************************/
+void DisplayInstrumentation::begin(DisplayOp op, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+    {
+    if (_depth++ > 0) {
+        return;
+    }
+
+    _op = op;
+    current().calls++;
+    _entry_start = now();
+    _entry = {(uint32_t)_entry_start, 0, 0, x, y, width, height, op};
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::end
+*
+*   DESCRIPTION:
+*       Ends an API call and logs the outermost one to the ring
+*
+*********************************************************************/
+void DisplayInstrumentation::end()
+    {
+    if (--_depth > 0) {
+        return;
+    }
+
+    _entry.duration_us = (uint32_t)(now() - _entry_start);
+    _ring[_ring_next] = _entry;
+    _ring_next = (uint16_t)((_ring_next + 1) % DISPLAY_TRACE_ENTRIES);
+    if (_ring_count < DISPLAY_TRACE_ENTRIES) {
+        _ring_count++;
+    }
+    _op = DisplayOp::OTHER;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::on_command
+*
+*   DESCRIPTION:
+*       Records a command byte written since start_us
+*
+*********************************************************************/
+void DisplayInstrumentation::on_command(uint64_t start_us)
+    {
+    OpCounters& counters = current();
+    counters.commands++;
+    counters.bus_us += (uint32_t)(now() - start_us);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::on_data
+*
+*   DESCRIPTION:
+*       Records data bytes written since start_us
+*
+*********************************************************************/
+void DisplayInstrumentation::on_data(size_t len, uint64_t start_us)
+    {
+    OpCounters& counters = current();
+    counters.data_bytes += (uint32_t)len;
+    counters.bus_us += (uint32_t)(now() - start_us);
+    if (_depth > 0) {
+        _entry.data_bytes += (uint32_t)len;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::snapshot
+*
+*   DESCRIPTION:
+*       Returns a copy of the counters
+*
+*********************************************************************/
+InstrumentationSnapshot DisplayInstrumentation::snapshot() const
+    {
+    return _counters;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::reset
+*
+*   DESCRIPTION:
+*       Clears the counters and the trace
+*
+*********************************************************************/
+void DisplayInstrumentation::reset()
+    {
+    _counters = InstrumentationSnapshot();
+    _ring_next = 0;
+    _ring_count = 0;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::trace
+*
+*   DESCRIPTION:
+*       Copies the most recent trace entries, oldest first
+*
+*********************************************************************/
+size_t DisplayInstrumentation::trace(TraceEntry* out, size_t max) const
+    {
+    size_t count = (_ring_count < max) ? _ring_count : max;
+    size_t first = (_ring_next + DISPLAY_TRACE_ENTRIES - count) % DISPLAY_TRACE_ENTRIES;
+
+    for (size_t i = 0; i < count; i++) {
+        out[i] = _ring[(first + i) % DISPLAY_TRACE_ENTRIES];
+    }
+    return count;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::op_name
+*
+*   DESCRIPTION:
+*       Printable name of an operation
+*
+*********************************************************************/
+const char* DisplayInstrumentation::op_name(DisplayOp op)
+    {
+    switch (op) {
+        case DisplayOp::OTHER:      return "other";
+        case DisplayOp::FILL_RECT:  return "fill_rect";
+        case DisplayOp::TEXT:       return "text";
+        case DisplayOp::BLIT:       return "blit";
+        case DisplayOp::FLUSH:      return "flush";
+        case DisplayOp::STRIP:      return "strip";
+        case DisplayOp::SCROLL:     return "scroll";
+        default:                    return "?";
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::dump
+*
+*   DESCRIPTION:
+*       Prints the counters as a table
+*
+*********************************************************************/
+void DisplayInstrumentation::dump() const
+    {
+    printf("%-10s %8s %10s %10s %8s %8s %10s\n", "op", "calls", "pixels", "bytes", "cmds", "cs", "bus_us");
+    for (uint8_t i = 0; i < (uint8_t)DisplayOp::COUNT; i++) {
+        const OpCounters& c = _counters.ops[i];
+        printf("%-10s %8lu %10lu %10lu %8lu %8lu %10lu\n", op_name((DisplayOp)i),
+               (unsigned long)c.calls, (unsigned long)c.pixels, (unsigned long)c.data_bytes,
+               (unsigned long)c.commands, (unsigned long)c.cs_toggles, (unsigned long)c.bus_us);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       DisplayInstrumentation::dump_trace
+*
+*   DESCRIPTION:
+*       Prints the trace ring, oldest first
+*
+*********************************************************************/
+void DisplayInstrumentation::dump_trace() const
+    {
+    TraceEntry entries[DISPLAY_TRACE_ENTRIES];
+    size_t count = trace(entries, DISPLAY_TRACE_ENTRIES);
+
+    for (size_t i = 0; i < count; i++) {
+        const TraceEntry& e = entries[i];
+        printf("%10lu %-10s (%u,%u %ux%u) %lu us %lu bytes\n", (unsigned long)e.start_us, op_name(e.op),
+               e.x, e.y, e.width, e.height, (unsigned long)e.duration_us, (unsigned long)e.data_bytes);
+    }
+    }
@@ -0,0 +1,136 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       optional per-operation counters and trace ring for
+*       ST7789VW, compiled in with DISPLAYAPI_INSTRUMENTATION
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayTransport.hpp"
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+#if !defined(DISPLAY_TRACE_ENTRIES)
+#define DISPLAY_TRACE_ENTRIES 64
+#endif
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+/* API entry points work is attributed to; commands sent outside of
+   them (init, rotation, ...) count as OTHER */
+enum class DisplayOp : uint8_t {
+    OTHER,
+    FILL_RECT,
+    TEXT,
+    BLIT,
+    FLUSH,
+    STRIP,
+    SCROLL,
+    COUNT
+};
+
+typedef struct {
+    uint32_t calls;
+    uint32_t pixels;            /* pixels drawn, panel or RAM           */
+    uint32_t data_bytes;        /* bytes sent with D/C high             */
+    uint32_t commands;
+    uint32_t cs_toggles;        /* CS assertions                        */
+    uint32_t bus_us;            /* time inside transport write calls    */
+} OpCounters;
+
+typedef struct {
+    OpCounters ops[(uint8_t)DisplayOp::COUNT];
+} InstrumentationSnapshot;
+
+typedef struct {
+    uint32_t start_us;
+    uint32_t duration_us;
+    uint32_t data_bytes;
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    DisplayOp op;
+} TraceEntry;
+
+/*--------------------------------------------------------------------
+                                MACROS
+--------------------------------------------------------------------*/
+/* hooks used inside the driver; they compile to nothing when the
+   instrumentation is off */
+#if defined(DISPLAYAPI_INSTRUMENTATION)
+#define DISPLAY_INSTR_OP(instr, op, x, y, w, h) DisplayInstrumentation::Scope instr_scope_((instr), (op), (x), (y), (w), (h))
+#define DISPLAY_INSTR_TIME(instr, var)          uint64_t var = (instr).now()
+#define DISPLAY_INSTR(instr, call)              (instr).call
+#else
+#define DISPLAY_INSTR_OP(instr, op, x, y, w, h)
+#define DISPLAY_INSTR_TIME(instr, var)
+#define DISPLAY_INSTR(instr, call)
+#endif
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+class DisplayInstrumentation {
+    public:
+        explicit DisplayInstrumentation(DisplayTransport& clock);
+
+        /* marks one API call; nested calls add to the outermost one */
+        class Scope {
+            public:
+                Scope(DisplayInstrumentation& instr, DisplayOp op, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+                    : _instr(instr)
+                    {
+                    _instr.begin(op, x, y, width, height);
+                    }
+                ~Scope() { _instr.end(); }
+
+            private:
+                DisplayInstrumentation& _instr;
+        };
+
+        void begin(DisplayOp op, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+        void end();
+
+        uint64_t now() { return _clock.now_us(); }
+        void on_select() { current().cs_toggles++; }
+        void on_pixels(size_t count) { current().pixels += (uint32_t)count; }
+        void on_command(uint64_t start_us);
+        void on_data(size_t len, uint64_t start_us);
+
+        InstrumentationSnapshot snapshot() const;
+        void reset();
+
+        /* copies up to max entries, oldest first, returns the count */
+        size_t trace(TraceEntry* out, size_t max) const;
+
+        /* print over stdio */
+        void dump() const;
+        void dump_trace() const;
+
+        static const char* op_name(DisplayOp op);
+
+    private:
+        OpCounters& current() { return _counters.ops[(uint8_t)_op]; }
+
+        DisplayTransport& _clock;
+        InstrumentationSnapshot _counters;
+        DisplayOp _op;
+        uint8_t _depth;
+        TraceEntry _entry;
+        uint64_t _entry_start;
+
+        TraceEntry _ring[DISPLAY_TRACE_ENTRIES];
+        uint16_t _ring_next;
+        uint16_t _ring_count;
+};
+
+#endif // INSTRUMENTATION_HPP
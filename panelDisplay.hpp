@@ -0,0 +1,90 @@
+#ifndef PANEL_DISPLAY_HPP
+#define PANEL_DISPLAY_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       ST7789VW constructed from a compile-time panel description
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+/* A panel names its controller traits and geometry at rotation 0.
+   Panels driven through the pin constructor also give their pins:
+
+       struct BoardLcd : ST7789_240x280 {
+           static constexpr uint cs_pin = 9;
+           static constexpr uint dc_pin = 8;
+           static constexpr uint rst_pin = 12;
+           static constexpr uint bl_pin = 13;
+       };
+       PanelDisplay<BoardLcd> display(spi1);
+*/
+struct ST7789_240x280 {
+    typedef ST7789Controller controller;
+    static constexpr DisplayProperties props = {240, 280, 240, 320, 0, 20};
+};
+
+struct ST7735_128x160 {
+    typedef ST7735Controller controller;
+    static constexpr DisplayProperties props = {128, 160, 128, 160, 0, 0};
+};
+
+struct ILI9341_240x320 {
+    typedef ILI9341Controller controller;
+    static constexpr DisplayProperties props = {240, 320, 240, 320, 0, 0};
+};
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* A typed constructor for ST7789VW: the panel's geometry is checked
+   when the template is instantiated and its per-rotation screen sizes
+   are constants, so a bad board definition fails to build instead of
+   drawing off the panel. Nothing is specialized beyond that; drawing,
+   windowing and clipping are the shared runtime ST7789VW code reading
+   Panel::props and the controller's traits. */
+template <typename Panel>
+class PanelDisplay : public ST7789VW {
+    public:
+        typedef typename Panel::controller Controller;
+
+        static_assert(Panel::props.width > 0 && Panel::props.height > 0, "panel has no pixels");
+        static_assert(Panel::props.width <= DISPLAY_MAX_LINE_PIXELS && Panel::props.height <= DISPLAY_MAX_LINE_PIXELS,
+                      "panel side longer than the line buffer");
+        static_assert(Panel::props.width <= FRAMEBUFFER_MAX_ROWS && Panel::props.height <= FRAMEBUFFER_MAX_ROWS,
+                      "panel side longer than the framebuffer dirty tracker");
+        static_assert(Panel::props.x_offset + Panel::props.width <= Panel::props.map_width &&
+                      Panel::props.y_offset + Panel::props.height <= Panel::props.map_height,
+                      "panel does not fit the controller memory");
+
+        explicit PanelDisplay(DisplayTransport& transport)
+            : ST7789VW(transport, Panel::props, Controller::info)
+            {
+            }
+
+#if !defined(DISPLAYAPI_HOST)
+        explicit PanelDisplay(spi_inst_t* spi)
+            : ST7789VW(spi, Panel::props, Panel::cs_pin, Panel::dc_pin, Panel::rst_pin, Panel::bl_pin, Controller::info)
+            {
+            }
+#endif
+
+        /* screen geometry for a rotation, usable in constant expressions */
+        static constexpr DisplayProperties props_for(Rotation rotation)
+            {
+            return Controller::rotate(Panel::props, (uint8_t)rotation);
+            }
+
+        static constexpr uint16_t WIDTH = Panel::props.width;
+        static constexpr uint16_t HEIGHT = Panel::props.height;
+};
+
+#endif // PANEL_DISPLAY_HPP
@@ -0,0 +1,291 @@
+/*********************************************************************
+*
+*   NAME:
+*       picoTransport.cpp
+*
+*   DESCRIPTION:
+*       Pico SDK SPI backend for DisplayTransport
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "picoTransport.hpp"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::PicoSPITransport (constructor)
+*
+*   DESCRIPTION:
+*       PicoSPITransport class constructor
+*
+*********************************************************************/
+PicoSPITransport::PicoSPITransport(spi_inst_t* spi, uint cs_pin, uint dc_pin, uint rst_pin, uint bl_pin)
+    : _spi(spi), _cs_pin(cs_pin), _dc_pin(dc_pin), _rst_pin(rst_pin), _bl_pin(bl_pin), _dma_chan(-1), _dma_active(false)
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::~PicoSPITransport (deconstructor)
+*
+*   DESCRIPTION:
+*       PicoSPITransport class deconstructor, releases the DMA channel
+*
+*********************************************************************/
+PicoSPITransport::~PicoSPITransport( void )
+    {
+    if (_dma_chan >= 0) {
+        wait();
+        dma_channel_unclaim((uint)_dma_chan);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::init
+*
+*   DESCRIPTION:
+*       Configures the control pins
+*
+*********************************************************************/
+void PicoSPITransport::init()
+    {
+    gpio_init(_cs_pin);
+    gpio_set_dir(_cs_pin, GPIO_OUT);
+    gpio_put(_cs_pin, 1);
+
+    gpio_init(_dc_pin);
+    gpio_set_dir(_dc_pin, GPIO_OUT);
+
+    gpio_init(_rst_pin);
+    gpio_set_dir(_rst_pin, GPIO_OUT);
+
+    if( _bl_pin != 0 )
+        {
+        gpio_init(_bl_pin);
+        gpio_set_dir(_bl_pin, GPIO_OUT);
+        gpio_put(_bl_pin, 1);
+        }
+
+    if (_dma_chan < 0) {
+        _dma_chan = dma_claim_unused_channel(false);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::select
+*
+*   DESCRIPTION:
+*       Asserts chip select
+*
+*********************************************************************/
+void PicoSPITransport::select()
+    {
+    gpio_put(_cs_pin, 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::deselect
+*
+*   DESCRIPTION:
+*       Releases chip select
+*
+*********************************************************************/
+void PicoSPITransport::deselect()
+    {
+    wait();
+    gpio_put(_cs_pin, 1);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::set_dc
+*
+*   DESCRIPTION:
+*       Drives the data/command line
+*
+*********************************************************************/
+void PicoSPITransport::set_dc(bool data)
+    {
+    wait();
+    gpio_put(_dc_pin, data);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::write
+*
+*   DESCRIPTION:
+*       Blocking SPI write
+*
+*********************************************************************/
+void PicoSPITransport::write(const uint8_t* data, size_t len)
+    {
+    wait();
+    spi_write_blocking(_spi, data, len);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::write_async
+*
+*   DESCRIPTION:
+*       Starts a DMA transfer into the SPI TX FIFO. Falls back to a
+*       blocking write if no DMA channel is available.
+*
+*********************************************************************/
+void PicoSPITransport::write_async(const uint8_t* data, size_t len)
+    {
+    wait();
+    if (_dma_chan < 0) {
+        spi_write_blocking(_spi, data, len);
+        return;
+    }
+
+    dma_channel_config cfg = dma_channel_get_default_config((uint)_dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_dreq(&cfg, spi_get_dreq(_spi, true));
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    dma_channel_configure((uint)_dma_chan, &cfg, &spi_get_hw(_spi)->dr, data, len, true);
+    _dma_active = true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::busy
+*
+*   DESCRIPTION:
+*       Returns true until the DMA has finished and the SPI has
+*       shifted out the last byte
+*
+*********************************************************************/
+bool PicoSPITransport::busy()
+    {
+    if (!_dma_active) {
+        return false;
+    }
+    if (dma_channel_is_busy((uint)_dma_chan) || spi_is_busy(_spi)) {
+        return true;
+    }
+    wait();
+    return false;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::wait
+*
+*   DESCRIPTION:
+*       Blocks until the current DMA transfer is on the wire, then
+*       drains the RX FIFO the transfer filled and clears the overrun
+*
+*********************************************************************/
+void PicoSPITransport::wait()
+    {
+    if (!_dma_active) {
+        return;
+    }
+
+    dma_channel_wait_for_finish_blocking((uint)_dma_chan);
+    while (spi_is_busy(_spi)) {
+        tight_loop_contents();
+    }
+    while (spi_is_readable(_spi)) {
+        (void)spi_get_hw(_spi)->dr;
+    }
+    spi_get_hw(_spi)->icr = SPI_SSPICR_RORIC_BITS;
+    _dma_active = false;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::set_reset
+*
+*   DESCRIPTION:
+*       Drives the reset line
+*
+*********************************************************************/
+void PicoSPITransport::set_reset(bool level)
+    {
+    gpio_put(_rst_pin, level);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::delay_ms
+*
+*   DESCRIPTION:
+*       Blocking delay
+*
+*********************************************************************/
+void PicoSPITransport::delay_ms(uint32_t ms)
+    {
+    sleep_ms(ms);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::now_us
+*
+*   DESCRIPTION:
+*       Microseconds since boot
+*
+*********************************************************************/
+uint64_t PicoSPITransport::now_us()
+    {
+    return time_us_64();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::delay_us
+*
+*   DESCRIPTION:
+*       Blocking delay
+*
+*********************************************************************/
+void PicoSPITransport::delay_us(uint32_t us)
+    {
+    sleep_us(us);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       PicoSPITransport::set_bus_clock
+*
+*   DESCRIPTION:
+*       Reprograms the SPI baud rate once the last transfer is out
+*
+*********************************************************************/
+void PicoSPITransport::set_bus_clock(uint32_t hz)
+    {
+    wait();
+    spi_set_baudrate(_spi, hz);
+    }
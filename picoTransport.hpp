@@ -0,0 +1,54 @@
+#ifndef PICO_TRANSPORT_HPP
+#define PICO_TRANSPORT_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       Pico SDK SPI backend for DisplayTransport
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayTransport.hpp"
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+class PicoSPITransport : public DisplayTransport {
+    public:
+        PicoSPITransport(spi_inst_t* spi, uint cs_pin, uint dc_pin, uint rst_pin, uint bl_pin);
+        ~PicoSPITransport( void );
+
+        void init() override;
+        void select() override;
+        void deselect() override;
+        void set_dc(bool data) override;
+        void write(const uint8_t* data, size_t len) override;
+        void write_async(const uint8_t* data, size_t len) override;
+        bool busy() override;
+        void wait() override;
+        void set_reset(bool level) override;
+        void delay_ms(uint32_t ms) override;
+        uint64_t now_us() override;
+        void delay_us(uint32_t us) override;
+        void set_bus_clock(uint32_t hz) override;
+
+        PicoSPITransport (const PicoSPITransport&) = delete;
+        PicoSPITransport& operator= (const PicoSPITransport&) = delete;
+
+    private:
+        spi_inst_t* _spi;
+        uint _cs_pin;
+        uint _dc_pin;
+        uint _rst_pin;
+        uint _bl_pin;
+
+        int _dma_chan;          /* -1 when no channel could be claimed */
+        bool _dma_active;
+};
+
+#endif // PICO_TRANSPORT_HPP
@@ -0,0 +1,194 @@
+/*********************************************************************
+*
+*   NAME:
+*       qoiDecoder.cpp
+*
+*   DESCRIPTION:
+*       Streaming QOI decoder. Bytes are pulled from the reader in
+*       small chunks and decoded a row at a time, so a full screen
+*       image costs a line buffer instead of a RAM copy.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "qoiDecoder.hpp"
+#include <string.h>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+#define QOI_OP_INDEX    0x00
+#define QOI_OP_DIFF     0x40
+#define QOI_OP_LUMA     0x80
+#define QOI_OP_RUN      0xC0
+#define QOI_OP_RGB      0xFE
+#define QOI_OP_RGBA     0xFF
+#define QOI_MASK_2      0xC0
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       QoiDecoder::QoiDecoder (constructor)
+*
+*   DESCRIPTION:
+*       QoiDecoder class constructor, call read_header() before
+*       decoding rows
+*
+*********************************************************************/
+QoiDecoder::QoiDecoder(QoiReader reader, void* context)
+    : _reader(reader), _context(context), _width(0), _height(0), _ok(false),
+      _in_pos(0), _in_len(0), _run(0)
+    {
+    _px[0] = _px[1] = _px[2] = 0;
+    _px[3] = 255;
+    memset(_index, 0, sizeof(_index));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       QoiDecoder::read_header
+*
+*   DESCRIPTION:
+*       Reads the 14 byte header. Images wider or taller than 65535
+*       pixels are rejected.
+*
+*********************************************************************/
+bool QoiDecoder::read_header()
+    {
+    uint8_t header[QOI_HEADER_SIZE];
+    _ok = true;
+    for (size_t i = 0; i < QOI_HEADER_SIZE && _ok; i++) {
+        _ok = readByte(header[i]);
+    }
+    if (!_ok || memcmp(header, "qoif", 4) != 0) {
+        _ok = false;
+        return false;
+    }
+
+    uint32_t width = ((uint32_t)header[4] << 24) | ((uint32_t)header[5] << 16) | ((uint32_t)header[6] << 8) | header[7];
+    uint32_t height = ((uint32_t)header[8] << 24) | ((uint32_t)header[9] << 16) | ((uint32_t)header[10] << 8) | header[11];
+    if (width == 0 || height == 0 || width > 0xFFFF || height > 0xFFFF) {
+        _ok = false;
+        return false;
+    }
+
+    _width = (uint16_t)width;
+    _height = (uint16_t)height;
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       QoiDecoder::readByte
+*
+*   DESCRIPTION:
+*       Next input byte, refilling the chunk from the reader
+*
+*********************************************************************/
+bool QoiDecoder::readByte(uint8_t& value)
+    {
+    if (_in_pos == _in_len) {
+        _in_len = (uint8_t)_reader(_context, _in, sizeof(_in));
+        _in_pos = 0;
+        if (_in_len == 0) {
+            return false;
+        }
+    }
+    value = _in[_in_pos++];
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       QoiDecoder::nextPixel
+*
+*   DESCRIPTION:
+*       Advances _px to the next pixel of the stream
+*
+*********************************************************************/
+bool QoiDecoder::nextPixel()
+    {
+    if (_run > 0) {
+        _run--;
+        return true;
+    }
+
+    uint8_t b1;
+    if (!readByte(b1)) {
+        return false;
+    }
+
+    if (b1 == QOI_OP_RGB) {
+        if (!readByte(_px[0]) || !readByte(_px[1]) || !readByte(_px[2])) {
+            return false;
+        }
+    } else if (b1 == QOI_OP_RGBA) {
+        if (!readByte(_px[0]) || !readByte(_px[1]) || !readByte(_px[2]) || !readByte(_px[3])) {
+            return false;
+        }
+    } else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX) {
+        memcpy(_px, _index[b1], 4);
+    } else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF) {
+        _px[0] += ((b1 >> 4) & 0x03) - 2;
+        _px[1] += ((b1 >> 2) & 0x03) - 2;
+        _px[2] += (b1 & 0x03) - 2;
+    } else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA) {
+        uint8_t b2;
+        if (!readByte(b2)) {
+            return false;
+        }
+        int dg = (b1 & 0x3F) - 32;
+        _px[0] += dg - 8 + ((b2 >> 4) & 0x0F);
+        _px[1] += dg;
+        _px[2] += dg - 8 + (b2 & 0x0F);
+    } else {
+        /* QOI_OP_RUN: this pixel plus (b1 & 0x3F) more */
+        _run = b1 & 0x3F;
+        return true;
+    }
+
+    memcpy(_index[(_px[0] * 3 + _px[1] * 5 + _px[2] * 7 + _px[3] * 11) % 64], _px, 4);
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       QoiDecoder::decode_row
+*
+*   DESCRIPTION:
+*       Decodes the next image row. The whole row is consumed from
+*       the stream; only the columns pixels from column first on are
+*       written.
+*
+*********************************************************************/
+bool QoiDecoder::decode_row(uint8_t* out, uint16_t columns, uint16_t first)
+    {
+    uint16_t end = first + columns;
+    for (uint16_t col = 0; col < _width; col++) {
+        if (_ok) {
+            _ok = nextPixel();
+        }
+        if (col < first || col >= end) {
+            continue;
+        }
+
+        uint16_t color = 0;
+        if (_ok) {
+            color = (uint16_t)(((_px[0] & 0xF8) << 8) | ((_px[1] & 0xFC) << 3) | (_px[2] >> 3));
+        }
+        *out++ = (uint8_t)(color >> 8);
+        *out++ = (uint8_t)color;
+    }
+    return _ok;
+    }
@@ -0,0 +1,69 @@
+#ifndef QOI_DECODER_HPP
+#define QOI_DECODER_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       streaming QOI ("Quite OK Image") decoder for ST7789VW::blit_qoi
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+#define QOI_HEADER_SIZE     14
+#define QOI_READ_CHUNK      64      /* bytes requested from the reader at a time */
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+/* fills buf with up to len bytes of the file, returns the count read
+   (0 at the end of the data or on error) */
+typedef size_t (*QoiReader)(void* context, uint8_t* buf, size_t len);
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* Decodes a QOI stream one row at a time into wire-order RGB565.
+   Holds the 64 entry color index and a small input chunk, never the
+   image. Alpha is dropped. */
+class QoiDecoder {
+    public:
+        QoiDecoder(QoiReader reader, void* context);
+
+        /* reads and checks the header, false if it is not a QOI file */
+        bool read_header();
+        uint16_t width() const { return _width; }
+        uint16_t height() const { return _height; }
+
+        /* decodes the next row, keeping columns pixels from column
+           first on. On a truncated or corrupt stream the rest of the
+           row is black and false is returned. */
+        bool decode_row(uint8_t* out, uint16_t columns, uint16_t first = 0);
+
+    private:
+        bool readByte(uint8_t& value);
+        bool nextPixel();
+
+        QoiReader _reader;
+        void* _context;
+        uint16_t _width;
+        uint16_t _height;
+        bool _ok;
+
+        uint8_t _in[QOI_READ_CHUNK];
+        uint8_t _in_pos;
+        uint8_t _in_len;
+
+        uint8_t _px[4];             /* r, g, b, a of the last pixel */
+        uint8_t _index[64][4];
+        uint8_t _run;
+};
+
+#endif // QOI_DECODER_HPP
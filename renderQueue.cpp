@@ -0,0 +1,521 @@
+/*********************************************************************
+*
+*   NAME:
+*       renderQueue.cpp
+*
+*   DESCRIPTION:
+*       Lock-free SPSC render queue. The producer fills the slot at
+*       _head and then publishes it with a release store; the worker
+*       reads slots up to an acquire load of _head and frees them
+*       with a release store of _tail after they have run. With no
+*       worker running, full rings and sync() drain on the caller.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "renderQueue.hpp"
+#include <string.h>
+
+#if !defined(DISPLAYAPI_HOST)
+#include "pico/multicore.h"
+#endif
+
+/*--------------------------------------------------------------------
+                              VARIABLES
+--------------------------------------------------------------------*/
+#if !defined(DISPLAYAPI_HOST)
+static std::atomic<RenderQueue*> s_core1_queue(nullptr);   /* only one core1 to hand out */
+#endif
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       spinWait
+*
+*   DESCRIPTION:
+*       One iteration of a busy wait on the other side of the ring
+*
+*********************************************************************/
+static inline void spinWait()
+    {
+#if defined(DISPLAYAPI_HOST)
+    std::this_thread::yield();
+#else
+    tight_loop_contents();
+#endif
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::RenderQueue (constructor)
+*
+*   DESCRIPTION:
+*       RenderQueue class constructor. A ring holds capacity - 1
+*       commands, so under 2 slots there is no ring: capacity is set
+*       to 0 and each draw call runs on the caller instead.
+*
+*********************************************************************/
+RenderQueue::RenderQueue(ST7789VW& display, RenderCommand* slots, uint16_t capacity)
+    : _display(display), _slots(slots), _capacity((capacity < 2) ? 0 : capacity), _direct(), _head(0), _tail(0), _executed(0),
+      _stop(false), _running(false), _pushed(0), _executed_base(0), _stalls(0), _high_water(0)
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::~RenderQueue (destructor)
+*
+*   DESCRIPTION:
+*       RenderQueue class destructor, stops the worker
+*
+*********************************************************************/
+RenderQueue::~RenderQueue()
+    {
+    stop();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::fill
+*
+*   DESCRIPTION:
+*       Queues a full screen fill
+*
+*********************************************************************/
+void RenderQueue::fill(uint16_t color)
+    {
+    RenderCommand& command = acquireSlot();
+    command.op = RenderOp::FILL;
+    command.color = color;
+    publish();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::fill_rect
+*
+*   DESCRIPTION:
+*       Queues a filled rectangle
+*
+*********************************************************************/
+void RenderQueue::fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color)
+    {
+    RenderCommand& command = acquireSlot();
+    command.op = RenderOp::FILL_RECT;
+    command.x = x;
+    command.y = y;
+    command.width = width;
+    command.height = height;
+    command.color = color;
+    publish();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::write_string_pos
+*
+*   DESCRIPTION:
+*       Queues transparent text, returns false if it is longer than
+*       a command can carry
+*
+*********************************************************************/
+bool RenderQueue::write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, bool word_wrap)
+    {
+    return addText(RenderOp::TEXT, x, y, text, color, 0x0000, word_wrap);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::write_string_pos (opaque)
+*
+*   DESCRIPTION:
+*       Queues text over a background color
+*
+*********************************************************************/
+bool RenderQueue::write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool word_wrap)
+    {
+    return addText(RenderOp::TEXT_OPAQUE, x, y, text, color, bg_color, word_wrap);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::blit
+*
+*   DESCRIPTION:
+*       Queues an image draw. Only the Image pointer is queued, so the
+*       image and its data must stay valid until the command has run.
+*
+*********************************************************************/
+void RenderQueue::blit(int16_t x, int16_t y, const Image& image)
+    {
+    RenderCommand& command = acquireSlot();
+    command.op = RenderOp::BLIT;
+    command.x = x;
+    command.y = y;
+    command.image = &image;
+    publish();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::addText
+*
+*   DESCRIPTION:
+*       Copies the text into a command record
+*
+*********************************************************************/
+bool RenderQueue::addText(RenderOp op, int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool word_wrap)
+    {
+    size_t len = strlen(text) + 1;
+    if (len > RENDER_TEXT_MAX) {
+        return false;
+    }
+
+    RenderCommand& command = acquireSlot();
+    command.op = op;
+    command.word_wrap = word_wrap;
+    command.x = x;
+    command.y = y;
+    command.color = color;
+    command.bg_color = bg_color;
+    memcpy(command.text, text, len);
+    publish();
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::acquireSlot
+*
+*   DESCRIPTION:
+*       Returns the slot at the head, waiting for the worker while
+*       the ring is full (each such wait counts as one stall)
+*
+*********************************************************************/
+RenderCommand& RenderQueue::acquireSlot()
+    {
+    if (_capacity == 0) {
+        return _direct;
+    }
+
+    uint16_t head = _head.load(std::memory_order_relaxed);
+    uint16_t next = (uint16_t)((head + 1) % _capacity);
+
+    if (next == _tail.load(std::memory_order_acquire)) {
+        _stalls++;
+        while (next == _tail.load(std::memory_order_acquire)) {
+            if (!_running.load(std::memory_order_acquire)) {
+                run_once();
+            }
+            else {
+                spinWait();
+            }
+        }
+    }
+    return _slots[head];
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::publish
+*
+*   DESCRIPTION:
+*       Hands the slot filled by acquireSlot() to the worker, or
+*       runs it here when there is no ring
+*
+*********************************************************************/
+void RenderQueue::publish()
+    {
+    if (_capacity == 0) {
+        execute(_direct);
+        _display.wait();
+        _pushed++;
+        countExecuted();
+        return;
+    }
+
+    uint16_t head = (uint16_t)((_head.load(std::memory_order_relaxed) + 1) % _capacity);
+    _head.store(head, std::memory_order_release);
+    _pushed++;
+
+    uint16_t queued = depth();
+    if (queued > _high_water) {
+        _high_water = queued;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::sync
+*
+*   DESCRIPTION:
+*       Waits until the worker has run every queued command and the
+*       last transfer has finished
+*
+*********************************************************************/
+void RenderQueue::sync()
+    {
+    uint16_t head = _head.load(std::memory_order_relaxed);
+
+    while (_tail.load(std::memory_order_acquire) != head) {
+        if (!_running.load(std::memory_order_acquire)) {
+            run_once();
+        }
+        else {
+            spinWait();
+        }
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::run_once
+*
+*   DESCRIPTION:
+*       Runs every command currently in the ring. The display is
+*       waited on before the last slot is freed, so an empty ring
+*       means the pixels are on the panel. Returns true if anything
+*       ran.
+*
+*********************************************************************/
+bool RenderQueue::run_once()
+    {
+    uint16_t tail = _tail.load(std::memory_order_relaxed);
+    uint16_t head = _head.load(std::memory_order_acquire);
+    if (tail == head) {
+        return false;
+    }
+
+    while (tail != head) {
+        execute(_slots[tail]);
+        tail = (uint16_t)((tail + 1) % _capacity);
+        countExecuted();
+
+        if (tail == head) {
+            head = _head.load(std::memory_order_acquire);
+            if (tail == head) {
+                _display.wait();
+            }
+        }
+        _tail.store(tail, std::memory_order_release);
+    }
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::countExecuted
+*
+*   DESCRIPTION:
+*       Counts one executed command. Only one side ever writes the
+*       count, so a plain load and store does what fetch_add would
+*       without a read-modify-write, which the M0+ has no instruction
+*       for and turns into a locked library call.
+*
+*********************************************************************/
+void RenderQueue::countExecuted()
+    {
+    _executed.store(_executed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::execute
+*
+*   DESCRIPTION:
+*       Runs one command against the display
+*
+*********************************************************************/
+void RenderQueue::execute(const RenderCommand& command)
+    {
+    switch (command.op) {
+        case RenderOp::FILL:
+            _display.fill(command.color);
+            break;
+        case RenderOp::FILL_RECT:
+            _display.fill_rect(command.x, command.y, command.width, command.height, command.color);
+            break;
+        case RenderOp::TEXT:
+            _display.write_string_pos(command.x, command.y, command.text, command.color, command.word_wrap);
+            break;
+        case RenderOp::TEXT_OPAQUE:
+            _display.write_string_pos(command.x, command.y, command.text, command.color, command.bg_color, command.word_wrap);
+            break;
+        case RenderOp::BLIT:
+            _display.blit(command.x, command.y, *command.image);
+            break;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::workerLoop
+*
+*   DESCRIPTION:
+*       Worker body: drains the ring until stop() is called
+*
+*********************************************************************/
+void RenderQueue::workerLoop()
+    {
+    while (!_stop.load(std::memory_order_acquire)) {
+        if (!run_once()) {
+            spinWait();
+        }
+    }
+    run_once();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::start
+*
+*   DESCRIPTION:
+*       Starts the worker. On the Pico this takes core1, so it fails
+*       if another queue already owns it.
+*
+*********************************************************************/
+bool RenderQueue::start()
+    {
+    if (_running.load(std::memory_order_acquire)) {
+        return true;
+    }
+    _stop.store(false, std::memory_order_relaxed);
+
+#if defined(DISPLAYAPI_HOST)
+    _running.store(true, std::memory_order_release);
+    _worker = std::thread(&RenderQueue::workerLoop, this);
+#else
+    if (s_core1_queue.load() != nullptr) {
+        return false;
+    }
+    s_core1_queue.store(this);
+    _running.store(true, std::memory_order_release);
+    multicore_launch_core1(core1Entry);
+#endif
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::stop
+*
+*   DESCRIPTION:
+*       Lets the worker finish what is queued and stops it
+*
+*********************************************************************/
+void RenderQueue::stop()
+    {
+    if (!_running.load(std::memory_order_acquire)) {
+        return;
+    }
+    _stop.store(true, std::memory_order_release);
+
+#if defined(DISPLAYAPI_HOST)
+    _worker.join();
+#else
+    while (s_core1_queue.load() == this) {
+        tight_loop_contents();
+    }
+    multicore_reset_core1();
+#endif
+    _running.store(false, std::memory_order_release);
+    }
+
+#if !defined(DISPLAYAPI_HOST)
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::core1Entry
+*
+*   DESCRIPTION:
+*       core1 entry point, runs the worker of the queue that started it
+*
+*********************************************************************/
+void RenderQueue::core1Entry()
+    {
+    s_core1_queue.load()->workerLoop();
+    s_core1_queue.store(nullptr);
+    }
+#endif
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::depth
+*
+*   DESCRIPTION:
+*       Number of commands waiting or running
+*
+*********************************************************************/
+uint16_t RenderQueue::depth() const
+    {
+    if (_capacity == 0) {
+        return 0;
+    }
+
+    uint16_t head = _head.load(std::memory_order_acquire);
+    uint16_t tail = _tail.load(std::memory_order_acquire);
+    return (uint16_t)((head + _capacity - tail) % _capacity);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::stats
+*
+*   DESCRIPTION:
+*       Returns the queue counters (call from the producer side)
+*
+*********************************************************************/
+RenderQueueStats RenderQueue::stats() const
+    {
+    RenderQueueStats stats;
+    stats.pushed = _pushed;
+    stats.executed = _executed.load(std::memory_order_relaxed) - _executed_base;
+    stats.stalls = _stalls;
+    stats.high_water = _high_water;
+    return stats;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       RenderQueue::reset_stats
+*
+*   DESCRIPTION:
+*       Clears the queue counters (call from the producer side). The
+*       worker keeps counting executed commands while this runs, so
+*       the count is rebased instead of written from this side.
+*
+*********************************************************************/
+void RenderQueue::reset_stats()
+    {
+    _pushed = 0;
+    _executed_base = _executed.load(std::memory_order_relaxed);
+    _stalls = 0;
+    _high_water = 0;
+    }
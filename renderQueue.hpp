@@ -0,0 +1,142 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       render queue: draw calls become command records in a
+*       lock-free single producer / single consumer ring that a
+*       worker (core1 on the Pico, a thread on the host) executes
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+#include <atomic>
+
+#if defined(DISPLAYAPI_HOST)
+#include <thread>
+#endif
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t RENDER_TEXT_MAX = 48;   /* longest string a command can carry, including the terminator */
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+enum class RenderOp : uint8_t {
+    FILL,
+    FILL_RECT,
+    TEXT,
+    TEXT_OPAQUE,
+    BLIT
+};
+
+typedef struct {
+    RenderOp op;
+    bool word_wrap;
+    int16_t x;
+    int16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint16_t color;
+    uint16_t bg_color;
+    const Image* image;         /* BLIT only, must outlive the command */
+    char text[RENDER_TEXT_MAX];
+} RenderCommand;
+
+typedef struct {
+    uint32_t pushed;            /* commands queued                          */
+    uint32_t executed;          /* commands run by the worker               */
+    uint32_t stalls;            /* pushes that found the ring full          */
+    uint32_t high_water;        /* deepest the ring has been                */
+} RenderQueueStats;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* The producer calls the draw methods and sync(); the worker is the
+   only code touching the display while it runs. The ring holds
+   capacity - 1 commands; with fewer than 2 slots there is no ring
+   and every draw call runs and finishes on the caller. */
+class RenderQueue {
+    public:
+        RenderQueue(ST7789VW& display, RenderCommand* slots, uint16_t capacity);
+        ~RenderQueue();
+
+        /* producer side, each blocks while the ring is full */
+        void fill(uint16_t color);
+        void fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color);
+        bool write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, bool word_wrap = false);
+        bool write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool word_wrap = false);
+        void blit(int16_t x, int16_t y, const Image& image);
+
+        /* returns once every queued command has reached the panel */
+        void sync();
+
+        /* worker control: start() runs the worker on core1 (Pico) or a
+           thread (host); run_once() drains the ring on the calling
+           core instead */
+        bool start();
+        void stop();
+        bool run_once();
+
+        uint16_t depth() const;
+        RenderQueueStats stats() const;
+        void reset_stats();
+
+        RenderQueue (const RenderQueue&) = delete;
+        RenderQueue& operator= (const RenderQueue&) = delete;
+
+    private:
+        RenderCommand& acquireSlot();
+        void publish();
+        bool addText(RenderOp op, int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool word_wrap);
+        void countExecuted();
+        void execute(const RenderCommand& command);
+        void workerLoop();
+#if !defined(DISPLAYAPI_HOST)
+        static void core1Entry();
+#endif
+
+        ST7789VW& _display;
+        RenderCommand* _slots;
+        uint16_t _capacity;                 /* 0 when there is no ring */
+        RenderCommand _direct;              /* the command being run when there is no ring */
+
+        std::atomic<uint16_t> _head;        /* written by the producer only */
+        std::atomic<uint16_t> _tail;        /* written by the worker only   */
+        std::atomic<uint32_t> _executed;    /* written by the worker only   */
+        std::atomic<bool> _stop;
+        std::atomic<bool> _running;
+
+        uint32_t _pushed;
+        uint32_t _executed_base;            /* _executed at reset_stats() */
+        uint32_t _stalls;
+        uint16_t _high_water;
+
+#if defined(DISPLAYAPI_HOST)
+        std::thread _worker;
+#endif
+};
+
+/* RenderQueue with its ring sized at compile time */
+template <uint16_t CAPACITY = 32>
+class StaticRenderQueue : public RenderQueue {
+    static_assert(CAPACITY >= 2, "a ring needs at least two slots");
+
+    public:
+        explicit StaticRenderQueue(ST7789VW& display)
+            : RenderQueue(display, _slot_storage, CAPACITY)
+            {
+            }
+
+    private:
+        RenderCommand _slot_storage[CAPACITY];
+};
+
+#endif // RENDER_QUEUE_HPP
@@ -0,0 +1,418 @@
+/*********************************************************************
+*
+*   NAME:
+*       sharedBus.cpp
+*
+*   DESCRIPTION:
+*       Shared SPI bus arbitration. Each panel keeps its own CS/D/C
+*       transport; SharedBusTransport takes a ticket for the bus
+*       around every transaction and splits long bursts so one full
+*       screen fill cannot hold the other panels off for a frame.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "sharedBus.hpp"
+
+#if defined(DISPLAYAPI_HOST)
+#include <thread>
+#else
+#include "pico/stdlib.h"
+#endif
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       spinWait
+*
+*   DESCRIPTION:
+*       One iteration of a busy wait for the bus
+*
+*********************************************************************/
+static inline void spinWait()
+    {
+#if defined(DISPLAYAPI_HOST)
+    std::this_thread::yield();
+#else
+    tight_loop_contents();
+#endif
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedSpiBus::SharedSpiBus (constructor)
+*
+*   DESCRIPTION:
+*       SharedSpiBus class constructor
+*
+*********************************************************************/
+SharedSpiBus::SharedSpiBus(uint32_t max_chunk)
+    : _next_ticket(0), _serving(0), _max_chunk((max_chunk == 0) ? 1 : max_chunk), _clock_hz(0)
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedSpiBus::acquire
+*
+*   DESCRIPTION:
+*       Takes the next ticket and waits for it to be served
+*
+*********************************************************************/
+void SharedSpiBus::acquire()
+    {
+    uint32_t ticket = _next_ticket.fetch_add(1, std::memory_order_relaxed);
+    while (_serving.load(std::memory_order_acquire) != ticket) {
+        spinWait();
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedSpiBus::release
+*
+*   DESCRIPTION:
+*       Hands the bus to the next ticket
+*
+*********************************************************************/
+void SharedSpiBus::release()
+    {
+    _serving.store(_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedSpiBus::contended
+*
+*   DESCRIPTION:
+*       True when tickets beyond the holder's are outstanding
+*
+*********************************************************************/
+bool SharedSpiBus::contended() const
+    {
+    return _next_ticket.load(std::memory_order_relaxed) - _serving.load(std::memory_order_relaxed) > 1;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::SharedBusTransport (constructor)
+*
+*   DESCRIPTION:
+*       SharedBusTransport class constructor. clock_hz is applied
+*       whenever this panel takes the bus from one running at a
+*       different clock (0 leaves the clock alone).
+*
+*********************************************************************/
+SharedBusTransport::SharedBusTransport(SharedSpiBus& bus, DisplayTransport& device, uint32_t clock_hz)
+    : _bus(bus), _device(device), _clock_hz(clock_hz), _selected(false), _dc(false), _held_bytes(0), _granted_us(0), _stats()
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::acquireBus
+*
+*   DESCRIPTION:
+*       Waits for the bus and switches it to this panel's clock
+*
+*********************************************************************/
+void SharedBusTransport::acquireBus()
+    {
+    uint64_t start = _device.now_us();
+    _bus.acquire();
+    _granted_us = _device.now_us();
+
+    uint32_t waited = (uint32_t)(_granted_us - start);
+    _stats.grants++;
+    _stats.wait_us += waited;
+    if (waited > _stats.max_wait_us) {
+        _stats.max_wait_us = waited;
+    }
+
+    if (_clock_hz != 0 && _bus.clock_hz() != _clock_hz) {
+        _device.set_bus_clock(_clock_hz);
+        _bus.set_clock_hz(_clock_hz);
+        _stats.clock_switches++;
+    }
+    _held_bytes = 0;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::releaseBus
+*
+*   DESCRIPTION:
+*       Gives the bus to the next waiting panel
+*
+*********************************************************************/
+void SharedBusTransport::releaseBus()
+    {
+    _stats.hold_us += _device.now_us() - _granted_us;
+    _bus.release();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::yieldIfContended
+*
+*   DESCRIPTION:
+*       Mid-transaction, once a chunk has gone out and another panel
+*       is waiting, lets it in and then resumes the transaction with
+*       the same D/C level
+*
+*********************************************************************/
+void SharedBusTransport::yieldIfContended()
+    {
+    if (!_selected || _held_bytes < _bus.max_chunk() || !_bus.contended()) {
+        return;
+    }
+
+    _device.wait();
+    _device.deselect();
+    releaseBus();
+    _stats.yields++;
+
+    acquireBus();
+    _device.select();
+    _device.set_dc(_dc);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::init
+*
+*   DESCRIPTION:
+*       Configures the panel's pins. Holds the bus meanwhile: CS
+*       may glitch low while its pin is set up.
+*
+*********************************************************************/
+void SharedBusTransport::init()
+    {
+    acquireBus();
+    _device.init();
+    releaseBus();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::select
+*
+*   DESCRIPTION:
+*       Takes the bus and asserts this panel's chip select
+*
+*********************************************************************/
+void SharedBusTransport::select()
+    {
+    acquireBus();
+    _device.select();
+    _selected = true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::deselect
+*
+*   DESCRIPTION:
+*       Releases chip select and the bus
+*
+*********************************************************************/
+void SharedBusTransport::deselect()
+    {
+    _device.deselect();
+    _selected = false;
+    releaseBus();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::set_dc
+*
+*   DESCRIPTION:
+*       Drives the data/command line, remembered for resuming
+*
+*********************************************************************/
+void SharedBusTransport::set_dc(bool data)
+    {
+    _dc = data;
+    _device.set_dc(data);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::write
+*
+*   DESCRIPTION:
+*       Blocking write in chunks of at most max_chunk bytes
+*
+*********************************************************************/
+void SharedBusTransport::write(const uint8_t* data, size_t len)
+    {
+    while (len > 0) {
+        yieldIfContended();
+        size_t n = (len > _bus.max_chunk()) ? _bus.max_chunk() : len;
+        _device.write(data, n);
+        _held_bytes += (uint32_t)n;
+        _stats.bytes += n;
+        data += n;
+        len -= n;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::write_async
+*
+*   DESCRIPTION:
+*       Queues the data as background transfers of at most max_chunk
+*       bytes. Each one starts once the previous has finished; between
+*       chunks the bus goes to a waiting panel.
+*
+*********************************************************************/
+void SharedBusTransport::write_async(const uint8_t* data, size_t len)
+    {
+    while (len > 0) {
+        yieldIfContended();
+        size_t n = (len > _bus.max_chunk()) ? _bus.max_chunk() : len;
+        _device.write_async(data, n);
+        _held_bytes += (uint32_t)n;
+        _stats.bytes += n;
+        data += n;
+        len -= n;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::busy
+*
+*   DESCRIPTION:
+*       True while this panel's async transfer is running
+*
+*********************************************************************/
+bool SharedBusTransport::busy()
+    {
+    return _device.busy();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::wait
+*
+*   DESCRIPTION:
+*       Waits for this panel's async transfer
+*
+*********************************************************************/
+void SharedBusTransport::wait()
+    {
+    _device.wait();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::set_reset
+*
+*   DESCRIPTION:
+*       Drives this panel's reset line (not part of the bus)
+*
+*********************************************************************/
+void SharedBusTransport::set_reset(bool level)
+    {
+    _device.set_reset(level);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::delay_ms
+*
+*   DESCRIPTION:
+*       Blocking delay
+*
+*********************************************************************/
+void SharedBusTransport::delay_ms(uint32_t ms)
+    {
+    _device.delay_ms(ms);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::now_us
+*
+*   DESCRIPTION:
+*       Microsecond clock of the panel's transport
+*
+*********************************************************************/
+uint64_t SharedBusTransport::now_us()
+    {
+    return _device.now_us();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::delay_us
+*
+*   DESCRIPTION:
+*       Blocking delay
+*
+*********************************************************************/
+void SharedBusTransport::delay_us(uint32_t us)
+    {
+    _device.delay_us(us);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::reset_stats
+*
+*   DESCRIPTION:
+*       Clears the latency and bandwidth counters
+*
+*********************************************************************/
+void SharedBusTransport::reset_stats()
+    {
+    _stats = SharedBusStats();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       SharedBusTransport::bandwidth
+*
+*   DESCRIPTION:
+*       Bytes per second over the time this panel held the bus
+*
+*********************************************************************/
+uint32_t SharedBusTransport::bandwidth() const
+    {
+    if (_stats.hold_us == 0) {
+        return 0;
+    }
+    return (uint32_t)(_stats.bytes * 1000000u / _stats.hold_us);
+    }
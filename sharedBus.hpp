@@ -0,0 +1,120 @@
+#ifndef SHARED_BUS_HPP
+#define SHARED_BUS_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       one SPI bus shared by several panels: a fair bus arbiter and
+*       the per-panel transport that chunks its traffic through it
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayTransport.hpp"
+#include <atomic>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint32_t SHARED_BUS_DEFAULT_CHUNK = 1024;    /* bytes held before yielding to a waiting panel */
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    uint32_t grants;            /* times the bus was acquired           */
+    uint32_t yields;            /* bursts split to let another panel in */
+    uint32_t clock_switches;    /* bus clock changed on acquiring       */
+    uint64_t bytes;
+    uint64_t wait_us;           /* total time waiting for the bus       */
+    uint32_t max_wait_us;       /* longest single wait                  */
+    uint64_t hold_us;           /* total time holding the bus           */
+} SharedBusStats;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* Ticket arbiter: panels get the bus in the order they asked for it,
+   so contending panels alternate chunk by chunk. Safe across threads
+   and across the Pico's two cores. */
+class SharedSpiBus {
+    public:
+        explicit SharedSpiBus(uint32_t max_chunk = SHARED_BUS_DEFAULT_CHUNK);
+
+        void set_max_chunk(uint32_t bytes) { _max_chunk = (bytes == 0) ? 1 : bytes; }
+        uint32_t max_chunk() const { return _max_chunk; }
+
+        void acquire();
+        void release();
+        /* true while another panel is waiting for the bus */
+        bool contended() const;
+
+        /* clock currently programmed into the SPI block (0 = unknown) */
+        uint32_t clock_hz() const { return _clock_hz; }
+        void set_clock_hz(uint32_t hz) { _clock_hz = hz; }
+
+        SharedSpiBus (const SharedSpiBus&) = delete;
+        SharedSpiBus& operator= (const SharedSpiBus&) = delete;
+
+    private:
+        std::atomic<uint32_t> _next_ticket;
+        std::atomic<uint32_t> _serving;
+        uint32_t _max_chunk;
+        uint32_t _clock_hz;         /* only touched by the bus holder */
+};
+
+/* DisplayTransport for one panel on a shared bus. Wraps the panel's
+   own pin-level transport (CS, D/C, reset), holds the bus from select()
+   to deselect() and, when another panel is waiting, releases it every
+   max_chunk bytes of a long burst. The controller keeps its RAMWR
+   state while CS is high, so the burst resumes where it stopped.
+   Async chunks are pipelined while the bus is held, but CS (and the
+   bus) are never held between draw calls: an async ST7789VW drains
+   its last transfer and releases the bus before returning, so one
+   thread can drive several panels on the bus. */
+class SharedBusTransport : public DisplayTransport {
+    public:
+        SharedBusTransport(SharedSpiBus& bus, DisplayTransport& device, uint32_t clock_hz);
+
+        void init() override;
+        void select() override;
+        void deselect() override;
+        void set_dc(bool data) override;
+        void write(const uint8_t* data, size_t len) override;
+        void write_async(const uint8_t* data, size_t len) override;
+        bool busy() override;
+        void wait() override;
+        void set_reset(bool level) override;
+        void delay_ms(uint32_t ms) override;
+        uint64_t now_us() override;
+        void delay_us(uint32_t us) override;
+        void set_bus_clock(uint32_t hz) override { _clock_hz = hz; }
+        bool can_hold_select() override { return false; }
+
+        const SharedBusStats& stats() const { return _stats; }
+        void reset_stats();
+
+        /* bytes per second while this panel held the bus */
+        uint32_t bandwidth() const;
+
+        SharedBusTransport (const SharedBusTransport&) = delete;
+        SharedBusTransport& operator= (const SharedBusTransport&) = delete;
+
+    private:
+        void acquireBus();
+        void releaseBus();
+        void yieldIfContended();
+
+        SharedSpiBus& _bus;
+        DisplayTransport& _device;
+        uint32_t _clock_hz;
+        bool _selected;
+        bool _dc;
+        uint32_t _held_bytes;       /* bytes since the bus was granted */
+        uint64_t _granted_us;
+        SharedBusStats _stats;
+};
+
+#endif // SHARED_BUS_HPP
@@ -0,0 +1,220 @@
+/*********************************************************************
+*
+*   NAME:
+*       stripRenderer.cpp
+*
+*   DESCRIPTION:
+*       Band renderer for panels without room for a full framebuffer.
+*       Draw calls are recorded with their bounding boxes; render()
+*       replays the entries that overlap each strip into the strip
+*       buffer and streams it with a single window.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "stripRenderer.hpp"
+#include <string.h>
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       StripRenderer::StripRenderer (constructor)
+*
+*   DESCRIPTION:
+*       StripRenderer class constructor
+*
+*********************************************************************/
+StripRenderer::StripRenderer(ST7789VW& display, uint16_t* strip_pixels, uint16_t strip_width, uint16_t strip_rows,
+                             DisplayListEntry* entries, uint16_t max_entries,
+                             char* text_pool, uint16_t text_pool_size)
+    : _display(display), _strip(strip_pixels), _strip_width(strip_width), _strip_rows(strip_rows), _entries(entries), _max_entries(max_entries),
+      _count(0), _text(text_pool), _text_size(text_pool_size), _text_used(0), _background(0x0000), _stats()
+    {
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       StripRenderer::clear
+*
+*   DESCRIPTION:
+*       Empties the display list
+*
+*********************************************************************/
+void StripRenderer::clear()
+    {
+    _count = 0;
+    _text_used = 0;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       StripRenderer::fill_rect
+*
+*   DESCRIPTION:
+*       Records a filled rectangle, returns false if the list is full
+*
+*********************************************************************/
+bool StripRenderer::fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color)
+    {
+    if (_count >= _max_entries) {
+        return false;
+    }
+
+    DisplayListEntry& entry = _entries[_count++];
+    entry.op = DisplayListOp::FILL_RECT;
+    entry.word_wrap = false;
+    entry.x = x;
+    entry.y = y;
+    entry.width = width;
+    entry.height = height;
+    entry.color = color;
+    entry.bg_color = 0;
+    entry.text_offset = 0;
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       StripRenderer::write_string_pos
+*
+*   DESCRIPTION:
+*       Records transparent text
+*
+*********************************************************************/
+bool StripRenderer::write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, bool word_wrap)
+    {
+    return addText(DisplayListOp::TEXT, x, y, text, color, 0x0000, word_wrap);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       StripRenderer::write_string_pos (opaque)
+*
+*   DESCRIPTION:
+*       Records text over a background color
+*
+*********************************************************************/
+bool StripRenderer::write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool word_wrap)
+    {
+    return addText(DisplayListOp::TEXT_OPAQUE, x, y, text, color, bg_color, word_wrap);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       StripRenderer::addText
+*
+*   DESCRIPTION:
+*       Copies the text into the pool and records it with the area
+*       its layout covers
+*
+*********************************************************************/
+bool StripRenderer::addText(DisplayListOp op, int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool word_wrap)
+    {
+    size_t len = strlen(text) + 1;
+    if (_count >= _max_entries || len > (size_t)(_text_size - _text_used)) {
+        return false;
+    }
+
+    DisplayListEntry& entry = _entries[_count++];
+    entry.op = op;
+    entry.word_wrap = word_wrap;
+    DisplayRect area = _display.measure_string(x, y, text, word_wrap);
+    entry.x = x;
+    entry.y = y;
+    entry.width = area.width;
+    entry.height = area.height;
+    entry.color = color;
+    entry.bg_color = bg_color;
+    entry.text_offset = _text_used;
+
+    memcpy(&_text[_text_used], text, len);
+    _text_used += (uint16_t)len;
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       StripRenderer::render
+*
+*   DESCRIPTION:
+*       Replays the list once per strip. Each strip starts as the
+*       background color, gets every entry whose bounds overlap it,
+*       then goes out as one window. The buffer is laid out at the
+*       display's current width, so a wider display gets fewer rows
+*       per strip rather than running past the end of the buffer.
+*       The list is in screen coordinates, so the whole screen is
+*       pushed as the viewport while it runs.
+*
+*********************************************************************/
+bool StripRenderer::render()
+    {
+    uint16_t width = _display.width();
+    uint16_t height = _display.height();
+
+    uint16_t rows = _strip_rows;
+    if (_strip_width < width) {
+        rows = (uint16_t)((uint32_t)_strip_width * _strip_rows / width);
+    }
+    if (rows == 0 || !_display.push_screen()) {
+        return false;
+    }
+
+    for (uint16_t y = 0; y < height; y += rows) {
+        uint16_t y_end = (rows > height - y) ? height : (uint16_t)(y + rows);
+
+        _display.begin_strip(_strip, y, rows);
+        _display.fill_rect(0, y, width, rows, _background);
+
+        for (uint16_t i = 0; i < _count; i++) {
+            const DisplayListEntry& entry = _entries[i];
+            if (entry.y >= y_end || entry.y + entry.height <= y) {
+                _stats.entries_culled++;
+                continue;
+            }
+            replay(entry);
+            _stats.entries_replayed++;
+        }
+
+        _display.end_strip();
+        _stats.strips++;
+    }
+    _display.pop_clip();
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       StripRenderer::replay
+*
+*   DESCRIPTION:
+*       Runs one entry against the display's current strip
+*
+*********************************************************************/
+void StripRenderer::replay(const DisplayListEntry& entry)
+    {
+    switch (entry.op) {
+        case DisplayListOp::FILL_RECT:
+            _display.fill_rect(entry.x, entry.y, entry.width, entry.height, entry.color);
+            break;
+        case DisplayListOp::TEXT:
+            _display.write_string_pos(entry.x, entry.y, &_text[entry.text_offset], entry.color, entry.word_wrap);
+            break;
+        case DisplayListOp::TEXT_OPAQUE:
+            _display.write_string_pos(entry.x, entry.y, &_text[entry.text_offset], entry.color, entry.bg_color, entry.word_wrap);
+            break;
+    }
+    }
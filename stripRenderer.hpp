@@ -0,0 +1,111 @@
+#ifndef STRIP_RENDERER_HPP
+#define STRIP_RENDERER_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       band renderer: records draw calls into a display list and
+*       replays it strip by strip into a small RAM buffer
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+enum class DisplayListOp : uint8_t {
+    FILL_RECT,
+    TEXT,
+    TEXT_OPAQUE
+};
+
+typedef struct {
+    DisplayListOp op;
+    bool word_wrap;
+    int16_t x;                  /* area touched, used to cull per strip */
+    int16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint16_t color;
+    uint16_t bg_color;
+    uint16_t text_offset;       /* into the text pool */
+} DisplayListEntry;
+
+typedef struct {
+    uint32_t strips;
+    uint32_t entries_replayed;
+    uint32_t entries_culled;
+} StripStats;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+class StripRenderer {
+    public:
+        /* strip_pixels holds strip_rows rows of strip_width pixels.
+           Strips are full display width, so when the display is wider
+           than strip_width (rotated, or a small buffer) each strip
+           covers fewer rows. Coordinates are screen coordinates:
+           render() draws the whole screen whatever viewport or clip
+           is pushed on the display */
+        StripRenderer(ST7789VW& display, uint16_t* strip_pixels, uint16_t strip_width, uint16_t strip_rows,
+                      DisplayListEntry* entries, uint16_t max_entries,
+                      char* text_pool, uint16_t text_pool_size);
+
+        void clear();
+        void set_background(uint16_t color) { _background = color; }
+
+        bool fill_rect(int16_t x, int16_t y, uint16_t width, uint16_t height, uint16_t color);
+        bool write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, bool word_wrap = false);
+        bool write_string_pos(int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool word_wrap = false);
+
+        /* draws the whole list, one setWindow + RAMWR per strip.
+           Returns false, drawing nothing, if the buffer cannot hold
+           one display row or the display's clip stack is full */
+        bool render();
+
+        uint16_t entry_count() const { return _count; }
+        const StripStats& stats() const { return _stats; }
+        void reset_stats() { _stats = StripStats(); }
+
+        StripRenderer (const StripRenderer&) = delete;
+        StripRenderer& operator= (const StripRenderer&) = delete;
+
+    private:
+        bool addText(DisplayListOp op, int16_t x, int16_t y, const char* text, uint16_t color, uint16_t bg_color, bool word_wrap);
+        void replay(const DisplayListEntry& entry);
+
+        ST7789VW& _display;
+        uint16_t* _strip;
+        uint16_t _strip_width;
+        uint16_t _strip_rows;
+        DisplayListEntry* _entries;
+        uint16_t _max_entries;
+        uint16_t _count;
+        char* _text;
+        uint16_t _text_size;
+        uint16_t _text_used;
+        uint16_t _background;
+        StripStats _stats;
+};
+
+/* StripRenderer with its storage sized at compile time */
+template <uint16_t WIDTH, uint16_t STRIP_ROWS, uint16_t MAX_ENTRIES = 64, uint16_t TEXT_POOL = 512>
+class StaticStripRenderer : public StripRenderer {
+    public:
+        explicit StaticStripRenderer(ST7789VW& display)
+            : StripRenderer(display, _strip_storage, WIDTH, STRIP_ROWS, _entry_storage, MAX_ENTRIES, _text_storage, TEXT_POOL)
+            {
+            }
+
+    private:
+        uint16_t _strip_storage[WIDTH * STRIP_ROWS];
+        DisplayListEntry _entry_storage[MAX_ENTRIES];
+        char _text_storage[TEXT_POOL];
+};
+
+#endif // STRIP_RENDERER_HPP
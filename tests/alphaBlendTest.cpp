@@ -0,0 +1,257 @@
+/*********************************************************************
+*
+*   NAME:
+*       alphaBlendTest.cpp
+*
+*   DESCRIPTION:
+*       Checks the alpha blend kernels against a floating point
+*       reference (within one LSB per channel, every alpha, a spread
+*       of colors), and the two-pixel kernels against the scalar ones
+*       for every width up to a few words, every destination
+*       alignment, and that nothing past the row is written
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "alphaBlend.hpp"
+#include "testCheck.hpp"
+#include <math.h>
+#include <string.h>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr size_t MAX_PIXELS = 37;
+constexpr size_t GUARD = 8;
+constexpr uint8_t GUARD_BYTE = 0x5A;
+
+/* extremes, primaries, grays and odd values in every channel */
+static const uint16_t COLORS[] = {
+    0x0000, 0xFFFF, 0xF800, 0x07E0, 0x001F, 0x8410, 0x7BEF,
+    0x0821, 0xF7DE, 0x1234, 0xA5C3, 0x5D6B, 0xFFE0, 0x07FF,
+};
+constexpr size_t COLOR_COUNT = sizeof(COLORS) / sizeof(COLORS[0]);
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       channelClose
+*
+*   DESCRIPTION:
+*       True if one channel of got is within one LSB of fg over bg
+*       with alpha / 255 in floating point
+*
+*********************************************************************/
+static bool channelClose(uint16_t got, uint16_t fg, uint16_t bg, uint8_t alpha, int shift, uint16_t max)
+    {
+    double a = alpha / 255.0;
+    double want = ((fg >> shift) & max) * a + ((bg >> shift) & max) * (1.0 - a);
+    return fabs((double)((got >> shift) & max) - want) <= 1.0;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       closeToReference
+*
+*   DESCRIPTION:
+*       True if every channel of got is within one LSB of the float
+*       blend
+*
+*********************************************************************/
+static bool closeToReference(uint16_t got, uint16_t fg, uint16_t bg, uint8_t alpha)
+    {
+    return channelClose(got, fg, bg, alpha, 11, 0x1F)
+        && channelClose(got, fg, bg, alpha, 5, 0x3F)
+        && channelClose(got, fg, bg, alpha, 0, 0x1F);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       fillRow
+*
+*   DESCRIPTION:
+*       Writes count wire-order pixels cycling through COLORS
+*
+*********************************************************************/
+static void fillRow(uint8_t* dst, size_t count, size_t first)
+    {
+    for (size_t i = 0; i < count; i++) {
+        uint16_t c = COLORS[(first + i) % COLOR_COUNT];
+        dst[i * 2] = (uint8_t)(c >> 8);
+        dst[i * 2 + 1] = (uint8_t)c;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       guardsIntact
+*
+*   DESCRIPTION:
+*       True if the bytes around the blended row were not written
+*
+*********************************************************************/
+static bool guardsIntact(const uint8_t* buf, size_t offset, size_t len)
+    {
+    for (size_t i = 0; i < offset; i++) {
+        if (buf[i] != GUARD_BYTE) {
+            return false;
+        }
+    }
+    for (size_t i = offset + len; i < offset + len + GUARD; i++) {
+        if (buf[i] != GUARD_BYTE) {
+            return false;
+        }
+    }
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testBlend565
+*
+*   DESCRIPTION:
+*       blend565 against the float reference for every alpha and
+*       every pair of colors; alpha 0 and 255 are exact
+*
+*********************************************************************/
+static void testBlend565()
+    {
+    uint32_t far = 0;
+    uint32_t ends = 0;
+    for (uint16_t fg : COLORS) {
+        for (uint16_t bg : COLORS) {
+            for (uint32_t alpha = 0; alpha < 256; alpha++) {
+                far += !closeToReference(blend565(fg, bg, (uint8_t)alpha), fg, bg, (uint8_t)alpha);
+            }
+            ends += (blend565(fg, bg, 0) != bg) + (blend565(fg, bg, 255) != fg);
+        }
+    }
+    CHECK_EQ(far, 0);
+    CHECK_EQ(ends, 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testRowsReference
+*
+*   DESCRIPTION:
+*       blend_wire565 and blend_mask_wire565 against the float
+*       reference over a row of every background color
+*
+*********************************************************************/
+static void testRowsReference()
+    {
+    uint32_t far = 0;
+    for (uint16_t fg : COLORS) {
+        for (uint32_t alpha = 0; alpha < 256; alpha++) {
+            uint8_t row[COLOR_COUNT * 2];
+            fillRow(row, COLOR_COUNT, 0);
+            blend_wire565(row, fg, (uint8_t)alpha, COLOR_COUNT);
+            for (size_t i = 0; i < COLOR_COUNT; i++) {
+                uint16_t got = (uint16_t)((row[i * 2] << 8) | row[i * 2 + 1]);
+                far += !closeToReference(got, fg, COLORS[i], (uint8_t)alpha);
+            }
+        }
+
+        /* every alpha at once, against each background in turn */
+        for (size_t first = 0; first < COLOR_COUNT; first++) {
+            uint8_t alphas[256];
+            uint8_t row[256 * 2];
+            for (uint32_t i = 0; i < 256; i++) {
+                alphas[i] = (uint8_t)(i * 97 + first);
+            }
+            fillRow(row, 256, first);
+            blend_mask_wire565(row, fg, alphas, 256);
+            for (size_t i = 0; i < 256; i++) {
+                uint16_t got = (uint16_t)((row[i * 2] << 8) | row[i * 2 + 1]);
+                far += !closeToReference(got, fg, COLORS[(first + i) % COLOR_COUNT], alphas[i]);
+            }
+        }
+    }
+    CHECK_EQ(far, 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testPairsMatchScalar
+*
+*   DESCRIPTION:
+*       The two-pixel kernels against the scalar ones for every width,
+*       destination alignment and a spread of alphas
+*
+*********************************************************************/
+static void testPairsMatchScalar()
+    {
+    uint8_t alphas[MAX_PIXELS + 4];
+    for (size_t i = 0; i < sizeof(alphas); i++) {
+        alphas[i] = (uint8_t)(i * 53 + 7);
+    }
+    alphas[1] = 0;
+    alphas[2] = 255;
+
+    uint32_t mismatches = 0;
+    uint32_t overruns = 0;
+    for (size_t count = 0; count <= MAX_PIXELS; count++) {
+        for (size_t off = 0; off < 4; off++) {
+            for (uint32_t alpha = 0; alpha < 256; alpha += 17) {
+                uint8_t want[4 + MAX_PIXELS * 2 + GUARD];
+                uint8_t got[4 + MAX_PIXELS * 2 + GUARD];
+                memset(want, GUARD_BYTE, sizeof(want));
+                fillRow(want + off, count, alpha);
+                memcpy(got, want, sizeof(got));
+
+                uint16_t color = COLORS[alpha % COLOR_COUNT];
+                blend_wire565_scalar(want + off, color, (uint8_t)alpha, count);
+                blend_wire565(got + off, color, (uint8_t)alpha, count);
+                mismatches += (memcmp(want, got, sizeof(want)) != 0);
+                overruns += !guardsIntact(got, off, count * 2);
+            }
+
+            for (size_t alpha_off = 0; alpha_off < 4; alpha_off++) {
+                uint8_t want[4 + MAX_PIXELS * 2 + GUARD];
+                uint8_t got[4 + MAX_PIXELS * 2 + GUARD];
+                memset(want, GUARD_BYTE, sizeof(want));
+                fillRow(want + off, count, alpha_off);
+                memcpy(got, want, sizeof(got));
+
+                uint16_t color = COLORS[(count + alpha_off) % COLOR_COUNT];
+                blend_mask_wire565_scalar(want + off, color, alphas + alpha_off, count);
+                blend_mask_wire565(got + off, color, alphas + alpha_off, count);
+                mismatches += (memcmp(want, got, sizeof(want)) != 0);
+                overruns += !guardsIntact(got, off, count * 2);
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(overruns, 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testBlend565();
+    testRowsReference();
+    testPairsMatchScalar();
+    return test_result("alphaBlendTest");
+    }
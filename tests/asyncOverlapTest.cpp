@@ -0,0 +1,160 @@
+/*********************************************************************
+*
+*   NAME:
+*       asyncOverlapTest.cpp
+*
+*   DESCRIPTION:
+*       One panel on a simulated SPI clock, drawn sync and async: the
+*       async run must leave the same image, never touch CS or D/C
+*       under a running transfer, and spend less time blocked on the
+*       bus because the next line is built while the last one is sent
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+#include "hostTransport.hpp"
+#include "testCheck.hpp"
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t WIDTH = 240;
+constexpr uint16_t HEIGHT = 320;
+constexpr DisplayProperties PROPS = {WIDTH, HEIGHT, WIDTH, HEIGHT, 0, 0};
+/* faster than any real SPI bus, so the CPU time async hides behind
+   the transfers is a measurable share of the total */
+constexpr uint32_t BUS_HZ = 250000000;
+constexpr uint16_t PHOTO_W = 200;
+constexpr uint16_t PHOTO_H = 120;
+constexpr uint8_t RUNS = 7;
+
+/*--------------------------------------------------------------------
+                              VARIABLES
+--------------------------------------------------------------------*/
+static uint8_t photo_data[PHOTO_W * PHOTO_H * 3];
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       drawScene
+*
+*   DESCRIPTION:
+*       Fills, a dithered RGB888 image (CPU-heavy rows) and text;
+*       every row of each goes out as its own line buffer
+*
+*********************************************************************/
+static void drawScene(ST7789VW& display)
+    {
+    static const Image photo = {PHOTO_W, PHOTO_H, ImageFormat::RGB888, photo_data, nullptr, 0};
+
+    display.fill(0x1234);
+    display.fill_rect(10, 10, 220, 30, 0xA5C3);
+    display.set_dither(Dither::BAYER4);
+    display.blit(20, 50, photo);
+    display.blit(20, 175, photo);
+    for (uint16_t row = 0; row < 3; row++) {
+        display.write_string_pos(4, (int16_t)(300 + row * 6), "async overlap test line", (uint16_t)0xFFFF, (uint16_t)0x0000);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       render
+*
+*   DESCRIPTION:
+*       Draws the scene on a fresh panel; returns the time blocked on
+*       the bus, and checks the CS and D/C discipline
+*
+*********************************************************************/
+static uint64_t render(HostPanel& panel, bool async)
+    {
+    HostTransport transport(&panel);
+    ST7789VW display(transport, PROPS);
+    display.init(false);
+    transport.set_bus_clock(BUS_HZ);
+    display.set_async(async);
+    transport.reset_stats();
+
+    display.fill_rect(0, 0, 8, 8, 0x0F0F);
+    if (async) {
+        /* the burst is still open: CS held until the next command */
+        CHECK(transport.selected());
+    }
+    drawScene(display);
+    display.wait();
+    CHECK(!transport.selected());
+    CHECK(!display.busy());
+
+    const HostTransportStats& stats = transport.stats();
+    CHECK_EQ(stats.early_releases, 0);
+    CHECK_EQ(stats.unselected_bytes, 0);
+    CHECK_EQ(panel.stray_bytes(), 0);
+    CHECK_EQ(stats.async_writes > 0, async);
+    return stats.wait_us;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testOverlap
+*
+*   DESCRIPTION:
+*       Same image both ways; the async run waits less (best of a
+*       few runs, since the host clock is shared with other work)
+*
+*********************************************************************/
+static void testOverlap()
+    {
+    uint64_t sync_wait = UINT64_MAX;
+    uint64_t async_wait = UINT64_MAX;
+    uint32_t differing = 0;
+
+    for (uint8_t run = 0; run < RUNS; run++) {
+        HostPanel sync_panel(WIDTH, HEIGHT);
+        HostPanel async_panel(WIDTH, HEIGHT);
+        uint64_t s = render(sync_panel, false);
+        uint64_t a = render(async_panel, true);
+        sync_wait = (s < sync_wait) ? s : sync_wait;
+        async_wait = (a < async_wait) ? a : async_wait;
+
+        for (uint16_t y = 0; y < HEIGHT; y++) {
+            for (uint16_t x = 0; x < WIDTH; x++) {
+                differing += (sync_panel.pixel(x, y) != async_panel.pixel(x, y));
+            }
+        }
+    }
+
+    CHECK_EQ(differing, 0);
+    CHECK(sync_wait > 0);
+    CHECK(async_wait < sync_wait);
+    printf("asyncOverlapTest: blocked %llu us sync, %llu us async\n",
+           (unsigned long long)sync_wait, (unsigned long long)async_wait);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    for (size_t i = 0; i < sizeof(photo_data); i++) {
+        photo_data[i] = (uint8_t)(i * 37 + (i / (PHOTO_W * 3)) * 11);
+    }
+
+    testOverlap();
+    return test_result("asyncOverlapTest");
+    }
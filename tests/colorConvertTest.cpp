@@ -0,0 +1,217 @@
+/*********************************************************************
+*
+*   NAME:
+*       colorConvertTest.cpp
+*
+*   DESCRIPTION:
+*       Checks the word-parallel RGB888 / ARGB8888 to RGB565 kernels
+*       against the one-pixel-at-a-time reference for every width up
+*       to a few words, every source and destination alignment, every
+*       dither phase, and that nothing past the row is written
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "colorConvert.hpp"
+#include "testCheck.hpp"
+#include <string.h>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr size_t MAX_PIXELS = 37;
+constexpr size_t GUARD = 8;
+constexpr uint8_t GUARD_BYTE = 0x5A;
+static const Dither DITHERS[] = {Dither::NONE, Dither::BAYER4};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       fillSource
+*
+*   DESCRIPTION:
+*       Pseudo-random bytes with the saturating values 0, 254 and 255
+*       mixed in, where dithering clamps
+*
+*********************************************************************/
+static void fillSource(uint8_t* data, size_t len)
+    {
+    uint32_t state = 0x12345678;
+    for (size_t i = 0; i < len; i++) {
+        state = state * 1664525u + 1013904223u;
+        uint8_t v = (uint8_t)(state >> 24);
+        switch (i % 7) {
+            case 0: v = 255; break;
+            case 3: v = 0; break;
+            case 5: v = 254; break;
+            default: break;
+        }
+        data[i] = v;
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       guardsIntact
+*
+*   DESCRIPTION:
+*       True if the bytes around the converted row were not written
+*
+*********************************************************************/
+static bool guardsIntact(const uint8_t* buf, size_t offset, size_t len)
+    {
+    for (size_t i = 0; i < offset; i++) {
+        if (buf[i] != GUARD_BYTE) {
+            return false;
+        }
+    }
+    for (size_t i = offset + len; i < offset + len + GUARD; i++) {
+        if (buf[i] != GUARD_BYTE) {
+            return false;
+        }
+    }
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testReferenceNoDither
+*
+*   DESCRIPTION:
+*       The scalar reference truncates to rgb565() without dithering
+*
+*********************************************************************/
+static void testReferenceNoDither()
+    {
+    uint8_t src[MAX_PIXELS * 3];
+    uint8_t out[MAX_PIXELS * 2];
+    fillSource(src, sizeof(src));
+    rgb888_to_wire565_scalar(out, src, MAX_PIXELS);
+
+    uint32_t wrong = 0;
+    for (size_t i = 0; i < MAX_PIXELS; i++) {
+        uint16_t want = rgb565(src[i * 3], src[i * 3 + 1], src[i * 3 + 2]);
+        wrong += (out[i * 2] != (uint8_t)(want >> 8) || out[i * 2 + 1] != (uint8_t)want);
+    }
+    CHECK_EQ(wrong, 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testRgb888
+*
+*   DESCRIPTION:
+*       rgb888_to_wire565 against the scalar version
+*
+*********************************************************************/
+static void testRgb888()
+    {
+    uint8_t src[MAX_PIXELS * 3 + 4];
+    fillSource(src, sizeof(src));
+    uint32_t mismatches = 0;
+    uint32_t overruns = 0;
+
+    for (Dither dither : DITHERS) {
+        for (size_t count = 0; count <= MAX_PIXELS; count++) {
+            for (size_t src_off = 0; src_off < 4; src_off++) {
+                for (size_t out_off = 0; out_off < 4; out_off++) {
+                    for (uint16_t phase = 0; phase < 16; phase++) {
+                        uint16_t x = phase & 3;
+                        uint16_t y = phase >> 2;
+                        uint8_t want[4 + MAX_PIXELS * 2 + GUARD];
+                        uint8_t got[4 + MAX_PIXELS * 2 + GUARD];
+                        memset(want, GUARD_BYTE, sizeof(want));
+                        memset(got, GUARD_BYTE, sizeof(got));
+
+                        rgb888_to_wire565_scalar(want + out_off, src + src_off, count, dither, x, y);
+                        rgb888_to_wire565(got + out_off, src + src_off, count, dither, x, y);
+                        mismatches += (memcmp(want, got, sizeof(want)) != 0);
+                        overruns += !guardsIntact(got, out_off, count * 2);
+                    }
+                }
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(overruns, 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testArgb8888
+*
+*   DESCRIPTION:
+*       argb8888_to_wire565 against the scalar version, alpha ignored
+*
+*********************************************************************/
+static void testArgb8888()
+    {
+    uint32_t src[MAX_PIXELS + 4];
+    fillSource((uint8_t*)src, sizeof(src));
+    uint32_t mismatches = 0;
+    uint32_t overruns = 0;
+
+    for (Dither dither : DITHERS) {
+        for (size_t count = 0; count <= MAX_PIXELS; count++) {
+            for (size_t src_off = 0; src_off < 4; src_off++) {
+                for (size_t out_off = 0; out_off < 4; out_off++) {
+                    for (uint16_t phase = 0; phase < 16; phase++) {
+                        uint16_t x = phase & 3;
+                        uint16_t y = phase >> 2;
+                        uint8_t want[4 + MAX_PIXELS * 2 + GUARD];
+                        uint8_t got[4 + MAX_PIXELS * 2 + GUARD];
+                        memset(want, GUARD_BYTE, sizeof(want));
+                        memset(got, GUARD_BYTE, sizeof(got));
+
+                        argb8888_to_wire565_scalar(want + out_off, src + src_off, count, dither, x, y);
+                        argb8888_to_wire565(got + out_off, src + src_off, count, dither, x, y);
+                        mismatches += (memcmp(want, got, sizeof(want)) != 0);
+                        overruns += !guardsIntact(got, out_off, count * 2);
+                    }
+                }
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(overruns, 0);
+
+    /* alpha does not change the result */
+    uint32_t opaque[MAX_PIXELS];
+    uint8_t a[MAX_PIXELS * 2];
+    uint8_t b[MAX_PIXELS * 2];
+    for (size_t i = 0; i < MAX_PIXELS; i++) {
+        opaque[i] = src[i] | 0xFF000000u;
+        src[i] &= 0x00FFFFFFu;
+    }
+    argb8888_to_wire565(a, opaque, MAX_PIXELS, Dither::BAYER4, 1, 2);
+    argb8888_to_wire565(b, src, MAX_PIXELS, Dither::BAYER4, 1, 2);
+    CHECK(memcmp(a, b, sizeof(a)) == 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testReferenceNoDither();
+    testRgb888();
+    testArgb8888();
+    return test_result("colorConvertTest");
+    }
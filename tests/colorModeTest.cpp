@@ -0,0 +1,229 @@
+/*********************************************************************
+*
+*   NAME:
+*       colorModeTest.cpp
+*
+*   DESCRIPTION:
+*       Draws the same scene in RGB565 and RGB444 mode, straight to
+*       the panel and through a framebuffer flush, sync and async, and
+*       checks that the HostPanel decodes the 12-bit stream to the
+*       RGB565 image quantized to 444
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+#include "hostTransport.hpp"
+#include "testCheck.hpp"
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t WIDTH = 240;
+constexpr uint16_t HEIGHT = 320;
+constexpr DisplayProperties PROPS = {WIDTH, HEIGHT, WIDTH, HEIGHT, 0, 0};
+
+/* 5x3 RGB565 image, wire order, low bits set so 444 loses them */
+static const uint8_t SPRITE_DATA[5 * 3 * 2] = {
+    0xFF, 0xFF, 0x12, 0x34, 0xA5, 0xC3, 0x08, 0x21, 0x7B, 0xEF,
+    0x00, 0x1F, 0x07, 0xE0, 0xF8, 0x00, 0x5D, 0x6B, 0x84, 0x10,
+    0xF7, 0xDE, 0x00, 0x00, 0x33, 0x33, 0xCC, 0xCC, 0x0F, 0x0F,
+};
+static const Image SPRITE = {5, 3, ImageFormat::RGB565, SPRITE_DATA, nullptr, 0};
+
+/* 7x5 4bpp indexed image */
+static const uint16_t PALETTE[4] = {0x0821, 0xA5C3, 0xFFFF, 0x5D6B};
+static const uint8_t ICON_DATA[4 * 5] = {
+    0x01, 0x23, 0x01, 0x20,
+    0x12, 0x30, 0x12, 0x30,
+    0x23, 0x01, 0x23, 0x00,
+    0x30, 0x12, 0x30, 0x10,
+    0x33, 0x22, 0x11, 0x00,
+};
+static const Image ICON = {7, 5, ImageFormat::INDEXED_4BPP, ICON_DATA, PALETTE, 4};
+
+/*--------------------------------------------------------------------
+                              VARIABLES
+--------------------------------------------------------------------*/
+static uint16_t framebuffer[WIDTH * HEIGHT];
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       quantize444
+*
+*   DESCRIPTION:
+*       An RGB565 color after a trip through RGB444: the low bits are
+*       dropped and the controller repeats the high bits into them
+*
+*********************************************************************/
+static uint16_t quantize444(uint16_t c)
+    {
+    uint16_t r = (c >> 12) & 0xF;
+    uint16_t g = (c >> 7) & 0xF;
+    uint16_t b = (c >> 1) & 0xF;
+    return (uint16_t)((((r << 1) | (r >> 3)) << 11) | (((g << 2) | (g >> 2)) << 5) | ((b << 1) | (b >> 3)));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       drawScene
+*
+*   DESCRIPTION:
+*       Fills of odd and even widths at odd and even columns, opaque
+*       and transparent text, and odd-width images whose rows each
+*       leave a pixel to carry into the next
+*
+*********************************************************************/
+static void drawScene(ST7789VW& display)
+    {
+    display.fill(0x1234);
+    display.fill_rect(3, 5, 7, 3, 0xA5C3);
+    display.fill_rect(20, 11, 13, 9, 0x0821);
+    display.fill_rect(1, 40, 239, 1, 0x7BEF);
+    display.fill_rect(0, 300, 240, 20, 0xF7DE);
+    display.write_string_pos(9, 50, "RGB444 odd", (uint16_t)0xFFFF, (uint16_t)0x5D6B);
+    display.write_string_pos(11, 70, "over", (uint16_t)0xCCCC);
+    display.blit(41, 91, SPRITE);
+    display.blit(100, 91, SPRITE);
+    display.blit(101, 117, ICON);
+    display.blit(236, 200, ICON);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       render
+*
+*   DESCRIPTION:
+*       Draws the scene on a fresh panel in one mode
+*
+*********************************************************************/
+static void render(HostPanel& panel, ST7789VW::ColorMode mode, bool async, bool buffered)
+    {
+    HostTransport transport(&panel);
+    ST7789VW display(transport, PROPS);
+    display.init(false);
+    display.set_color_mode(mode);
+    display.set_async(async);
+
+    if (buffered) {
+        display.attach_framebuffer(framebuffer);
+        drawScene(display);
+        display.flush();
+        display.detach_framebuffer();
+    } else {
+        drawScene(display);
+    }
+    display.wait();
+
+    CHECK_EQ(panel.stray_bytes(), 0);
+    CHECK_EQ(transport.stats().early_releases, 0);
+    CHECK_EQ(transport.stats().unselected_bytes, 0);
+    CHECK_EQ(transport.stats().async_writes > 0, async);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       countDiffering
+*
+*   DESCRIPTION:
+*       Pixels of got that are not want, optionally quantized to 444
+*
+*********************************************************************/
+static uint32_t countDiffering(const HostPanel& got, const HostPanel& want, bool quantized)
+    {
+    uint32_t n = 0;
+    for (uint16_t y = 0; y < HEIGHT; y++) {
+        for (uint16_t x = 0; x < WIDTH; x++) {
+            uint16_t c = want.pixel(x, y);
+            n += (got.pixel(x, y) != (quantized ? quantize444(c) : c));
+        }
+    }
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testModes
+*
+*   DESCRIPTION:
+*       Every RGB444 run equals the quantized RGB565 image, and every
+*       RGB565 run equals it exactly
+*
+*********************************************************************/
+static void testModes()
+    {
+    HostPanel reference(WIDTH, HEIGHT);
+    render(reference, ST7789VW::ColorMode::RGB565, false, false);
+
+    /* the scene has colors 444 can't hold */
+    CHECK(countDiffering(reference, reference, true) > 1000);
+
+    for (uint8_t variant = 0; variant < 4; variant++) {
+        bool async = (variant & 1) != 0;
+        bool buffered = (variant & 2) != 0;
+
+        HostPanel packed(WIDTH, HEIGHT);
+        render(packed, ST7789VW::ColorMode::RGB444, async, buffered);
+        CHECK_EQ(packed.colmod(), 0x53);
+        CHECK_EQ(countDiffering(packed, reference, true), 0);
+
+        HostPanel full(WIDTH, HEIGHT);
+        render(full, ST7789VW::ColorMode::RGB565, async, buffered);
+        CHECK_EQ(countDiffering(full, reference, false), 0);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testBackTo565
+*
+*   DESCRIPTION:
+*       Switching back to RGB565 restores full precision
+*
+*********************************************************************/
+static void testBackTo565()
+    {
+    HostPanel panel(WIDTH, HEIGHT);
+    HostTransport transport(&panel);
+    ST7789VW display(transport, PROPS);
+    display.init(false);
+
+    display.set_color_mode(ST7789VW::ColorMode::RGB444);
+    display.fill_rect(0, 0, 3, 1, 0xA5C3);
+    display.set_color_mode(ST7789VW::ColorMode::RGB565);
+    display.fill_rect(0, 1, 3, 1, 0xA5C3);
+
+    CHECK_EQ(panel.pixel(2, 0), quantize444(0xA5C3));
+    CHECK_EQ(panel.pixel(2, 1), 0xA5C3);
+    CHECK_EQ(panel.colmod(), 0x55);
+    CHECK_EQ(panel.stray_bytes(), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testModes();
+    testBackTo565();
+    return test_result("colorModeTest");
+    }
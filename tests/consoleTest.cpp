@@ -0,0 +1,242 @@
+/*********************************************************************
+*
+*   NAME:
+*       consoleTest.cpp
+*
+*   DESCRIPTION:
+*       Runs Console on a HostPanel with fixed header and footer rows:
+*       the scroll area it defines, one VSCSAD per scrolled line that
+*       wraps back to the top of the area, what the glass shows after
+*       the wrap, and put_char() text appearing on flush()
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "console.hpp"
+#include "hostTransport.hpp"
+#include "testCheck.hpp"
+#include <vector>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr DisplayProperties PROPS = {240, 280, 240, 320, 0, 20};
+constexpr uint16_t HEADER_ROWS = 16;
+constexpr uint16_t FOOTER_ROWS = 20;
+constexpr uint16_t OLD_COLOR = 0x1234;
+constexpr uint16_t BG_COLOR = 0x0000;
+
+/* panel memory rows: the offset and header above the area, whole
+   text lines in it, and the rest of memory below */
+constexpr uint16_t TOP_FIXED = 20 + HEADER_ROWS;
+constexpr uint16_t SCROLL_ROWS = (280 - HEADER_ROWS - FOOTER_ROWS) / 8 * 8;
+constexpr uint16_t BOTTOM_FIXED = 320 - TOP_FIXED - SCROLL_ROWS;
+constexpr uint16_t LINES = SCROLL_ROWS / 8;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* keeps the parameters of every VSCRDEF and VSCSAD */
+class ScrollLog : public HostTransport {
+    public:
+        explicit ScrollLog(HostPanel* panel)
+            : HostTransport(panel)
+            {
+            }
+
+        void set_dc(bool data) override
+            {
+            HostTransport::set_dc(data);
+            _data = data;
+            }
+
+        void write(const uint8_t* data, size_t len) override
+            {
+            HostTransport::write(data, len);
+            if (!_data) {
+                _cmd = (len == 1) ? data[0] : 0;
+                if (_cmd == (uint8_t)ST7789VW_CMD::VSCRDEF) {
+                    area.clear();
+                }
+                else if (_cmd == (uint8_t)ST7789VW_CMD::VSCSAD) {
+                    starts.push_back(0);
+                }
+                return;
+            }
+            for (size_t i = 0; i < len; i++) {
+                if (_cmd == (uint8_t)ST7789VW_CMD::VSCRDEF) {
+                    area.push_back(data[i]);
+                }
+                else if (_cmd == (uint8_t)ST7789VW_CMD::VSCSAD) {
+                    starts.back() = (uint16_t)((starts.back() << 8) | data[i]);
+                }
+            }
+            }
+
+        std::vector<uint8_t> area;
+        std::vector<uint16_t> starts;
+
+    private:
+        bool _data = false;
+        uint8_t _cmd = 0;
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       countShown
+*
+*   DESCRIPTION:
+*       Counts pixels of a color the glass shows in a band of rows
+*
+*********************************************************************/
+static uint32_t countShown(const HostPanel& panel, uint16_t y, uint16_t h, uint16_t color)
+    {
+    uint32_t n = 0;
+    for (uint16_t row = y; row < y + h; row++) {
+        for (uint16_t col = 0; col < panel.width(); col++) {
+            n += (panel.displayed_pixel(col, row) == color);
+        }
+    }
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       lineColor
+*
+*   DESCRIPTION:
+*       Text color of the k-th line written, distinct per line
+*
+*********************************************************************/
+static uint16_t lineColor(uint16_t k)
+    {
+    return (uint16_t)(0x8000 | (k + 1) * 0x0041);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testScrollWrap
+*
+*   DESCRIPTION:
+*       begin() defines the area around the header and footer; every
+*       newline on the last line moves the start by one text line and
+*       the start wraps to the top of the area after a full turn. The
+*       glass then shows the last lines written, in order, with a
+*       blank line under them and the fixed rows untouched.
+*
+*********************************************************************/
+static void testScrollWrap()
+    {
+    HostPanel panel(240, 320);
+    ScrollLog transport(&panel);
+    ST7789VW display(transport, PROPS);
+    display.init(false);
+    panel.clear(OLD_COLOR);
+
+    Console console(display, 0xFFFF, BG_COLOR, HEADER_ROWS, FOOTER_ROWS);
+    CHECK(console.begin());
+    CHECK_EQ(console.lines(), LINES);
+    CHECK_EQ(console.columns(), 30);
+
+    const uint8_t want_area[] = {0, TOP_FIXED, 0, SCROLL_ROWS, 0, BOTTOM_FIXED};
+    CHECK(transport.area == std::vector<uint8_t>(want_area, want_area + sizeof(want_area)));
+    CHECK_EQ(transport.starts.size(), 1);
+    CHECK_EQ(transport.starts.back(), TOP_FIXED);
+
+    /* a full turn of the area and a few lines more */
+    const uint16_t written = 2 * LINES + 3;
+    for (uint16_t k = 0; k < written; k++) {
+        console.set_colors(lineColor(k), BG_COLOR);
+        console.write("AB wrap\n");
+    }
+
+    const uint16_t scrolls = written - (LINES - 1);
+    CHECK_EQ(transport.starts.size(), 1u + scrolls);
+    uint32_t wrong_starts = 0;
+    for (uint16_t i = 1; i < transport.starts.size(); i++) {
+        wrong_starts += (transport.starts[i] != TOP_FIXED + (i * 8) % SCROLL_ROWS);
+    }
+    CHECK_EQ(wrong_starts, 0);
+    CHECK_EQ(transport.starts[LINES], TOP_FIXED);
+
+    /* glass line j holds text line written - (LINES - 1) + j */
+    uint32_t misplaced = 0;
+    for (uint16_t j = 0; j + 1 < LINES; j++) {
+        uint16_t k = (uint16_t)(written - (LINES - 1) + j);
+        uint16_t y = (uint16_t)(TOP_FIXED + j * 8);
+        misplaced += (countShown(panel, y, 8, lineColor(k)) == 0);
+        misplaced += (countShown(panel, y, 8, lineColor(k - 1)) != 0);
+    }
+    CHECK_EQ(misplaced, 0);
+    CHECK_EQ(countShown(panel, TOP_FIXED + (LINES - 1) * 8, 8, BG_COLOR), 240u * 8);
+
+    CHECK_EQ(countShown(panel, 20, HEADER_ROWS, OLD_COLOR), 240u * HEADER_ROWS);
+    CHECK_EQ(countShown(panel, TOP_FIXED + SCROLL_ROWS, 300 - TOP_FIXED - SCROLL_ROWS, OLD_COLOR),
+             240u * (300 - TOP_FIXED - SCROLL_ROWS));
+    CHECK_EQ(panel.stray_bytes(), 0);
+
+    console.end();
+    CHECK_EQ(transport.starts.back(), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testFlush
+*
+*   DESCRIPTION:
+*       put_char() text stays pending until flush(), which draws it
+*       without ending the line
+*
+*********************************************************************/
+static void testFlush()
+    {
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    ST7789VW display(transport, PROPS);
+    display.init(false);
+
+    Console console(display, 0xFFFF, BG_COLOR);
+    CHECK(console.begin());
+    console.put_char('>');
+    console.put_char(' ');
+    uint32_t before = panel.pixels_written();
+    CHECK_EQ(countShown(panel, 20, 8, 0xFFFF), 0);
+
+    console.flush();
+    CHECK_EQ(panel.pixels_written() - before, 2 * 8 * 8);
+    CHECK(countShown(panel, 20, 8, 0xFFFF) > 0);
+
+    /* the line goes on from where the prompt ended */
+    console.write("ok");
+    CHECK(countShown(panel, 20, 8, 0xFFFF) > 0);
+    CHECK_EQ(countShown(panel, 28, 8, 0xFFFF), 0);
+    CHECK_EQ(panel.pixels_written() - before, 4 * 8 * 8);
+    CHECK_EQ(panel.stray_bytes(), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testScrollWrap();
+    testFlush();
+    return test_result("consoleTest");
+    }
@@ -0,0 +1,231 @@
+/*********************************************************************
+*
+*   NAME:
+*       fontTest.cpp
+*
+*   DESCRIPTION:
+*       Draws the 8x8 font scaled and small hand-packed 2 and 4 bpp
+*       fonts at several scales, opaque and transparent, straight to
+*       a HostPanel and through a framebuffer, and checks every pixel
+*       against font_glyph_bit()/font_glyph_alpha()
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "alphaBlend.hpp"
+#include "displayAPI.hpp"
+#include "font.hpp"
+#include "hostTransport.hpp"
+#include "testCheck.hpp"
+#include <string.h>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+enum class TextMode : uint8_t {
+    OPAQUE,                     /* write_string_pos with a background     */
+    OVER_PANEL,                 /* transparent, drawn straight to the panel */
+    OVER_FRAMEBUFFER            /* transparent, blended in a framebuffer  */
+};
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t WIDTH = 240;
+constexpr uint16_t HEIGHT = 320;
+constexpr DisplayProperties PROPS = {WIDTH, HEIGHT, WIDTH, HEIGHT, 0, 0};
+constexpr uint16_t OLD = 0x39E7;
+constexpr uint16_t FG = 0xFD20;
+constexpr uint16_t BG = 0x0811;
+constexpr int16_t MARGIN = 2;
+
+/* 'A' and 'B', 2 bits of coverage, offset inside cells wider than
+   the bitmaps; every coverage level appears */
+static const uint8_t AA2_BITMAP[] = {0x1B, 0xE4, 0x6C, 0x93, 0x27, 0xD8};
+static const FontGlyph AA2_GLYPHS[] = {
+    {0, 3, 4, 5, 1, 1},
+    {24, 4, 3, 4, 0, 2},
+};
+static const Font AA2_FONT = {AA2_BITMAP, AA2_GLYPHS, 'A', 'B', 6, 2};
+
+/* the same with 4 bits of coverage and a glyph starting mid-byte */
+static const uint8_t AA4_BITMAP[] = {0x0F, 0x37, 0x8C, 0xE1, 0x52, 0x9A, 0x46, 0xBD, 0xF0};
+static const FontGlyph AA4_GLYPHS[] = {
+    {0, 3, 3, 4, 0, 0},
+    {36, 2, 4, 3, 1, 1},
+};
+static const Font AA4_FONT = {AA4_BITMAP, AA4_GLYPHS, 'A', 'B', 5, 4};
+
+/*--------------------------------------------------------------------
+                              VARIABLES
+--------------------------------------------------------------------*/
+static uint16_t framebuffer[WIDTH * HEIGHT];
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       expectedPixel
+*
+*   DESCRIPTION:
+*       What one glyph pixel should become over under. 1-bit fonts
+*       and transparent text on the panel only have set or unset
+*       pixels; otherwise coverage blends the color over what is
+*       beneath.
+*
+*********************************************************************/
+static uint16_t expectedPixel(const Font& f, const FontGlyph& g, uint16_t col, uint16_t row, uint16_t under, TextMode mode)
+    {
+    if (f.bpp <= 1 || mode == TextMode::OVER_PANEL) {
+        return font_glyph_bit(f, g, col, row) ? FG : under;
+    }
+    return blend565(FG, under, font_glyph_alpha(f, g, col, row));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       countWrong
+*
+*   DESCRIPTION:
+*       Compares the panel around a string drawn at x, y with the
+*       glyphs: each font pixel covers scale x scale screen pixels,
+*       cells outside the bitmap hold the background (or what was
+*       there), and nothing around the string changed
+*
+*********************************************************************/
+static uint32_t countWrong(const HostPanel& panel, const Font& f, uint8_t scale, int16_t x, int16_t y, const char* text, TextMode mode)
+    {
+    int16_t width = 0;
+    for (size_t k = 0; text[k]; k++) {
+        width = (int16_t)(width + font_glyph(f, text[k]).advance * scale);
+    }
+    int16_t height = (int16_t)(f.line_height * scale);
+    uint16_t cell_under = (mode == TextMode::OPAQUE) ? BG : OLD;
+
+    uint32_t wrong = 0;
+    for (int16_t py = (int16_t)(y - MARGIN); py < y + height + MARGIN; py++) {
+        for (int16_t px = (int16_t)(x - MARGIN); px < x + width + MARGIN; px++) {
+            uint16_t want = OLD;
+            if (px >= x && px < x + width && py >= y && py < y + height) {
+                int dx = (px - x) / scale;
+                int line = (py - y) / scale;
+                size_t k = 0;
+                while (dx >= font_glyph(f, text[k]).advance) {
+                    dx -= font_glyph(f, text[k]).advance;
+                    k++;
+                }
+                const FontGlyph& g = font_glyph(f, text[k]);
+                int row = line - g.y_offset;
+                int col = dx - g.x_offset;
+                want = cell_under;
+                if (row >= 0 && row < g.height && col >= 0 && col < g.width) {
+                    want = expectedPixel(f, g, (uint16_t)col, (uint16_t)row, cell_under, mode);
+                }
+            }
+            wrong += (panel.pixel((uint16_t)px, (uint16_t)py) != want);
+        }
+    }
+    return wrong;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       checkFont
+*
+*   DESCRIPTION:
+*       Draws text in one font at scales 1 to 3 in every mode and
+*       checks each string
+*
+*********************************************************************/
+static void checkFont(const Font& f, const char* text)
+    {
+    static const TextMode modes[] = {TextMode::OPAQUE, TextMode::OVER_PANEL, TextMode::OVER_FRAMEBUFFER};
+
+    for (TextMode mode : modes) {
+        HostPanel panel(WIDTH, HEIGHT);
+        HostTransport transport(&panel);
+        ST7789VW display(transport, PROPS);
+        display.init(false);
+        if (mode == TextMode::OVER_FRAMEBUFFER) {
+            display.attach_framebuffer(framebuffer);
+        }
+        display.fill(OLD);
+
+        for (uint8_t scale = 1; scale <= 3; scale++) {
+            int16_t x = (int16_t)(7 + scale);
+            int16_t y = (int16_t)(scale * 40 - 30);
+            display.set_font(&f, scale);
+            if (mode == TextMode::OPAQUE) {
+                display.write_string_pos(x, y, text, FG, BG);
+            } else {
+                display.write_string_pos(x, y, text, FG);
+            }
+            display.flush();
+            CHECK_EQ(countWrong(panel, f, scale, x, y, text, mode), 0);
+        }
+
+        if (mode == TextMode::OVER_FRAMEBUFFER) {
+            display.detach_framebuffer();
+        }
+        CHECK_EQ(panel.stray_bytes(), 0);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testFontData
+*
+*   DESCRIPTION:
+*       The hand-packed coverage reads back as packed, so the drawing
+*       checks below compare against the intended glyphs
+*
+*********************************************************************/
+static void testFontData()
+    {
+    CHECK_EQ(font_max_value(AA2_FONT), 3);
+    CHECK_EQ(font_max_value(AA4_FONT), 15);
+
+    /* 0x1B = 00 01 10 11 */
+    const FontGlyph& a2 = font_glyph(AA2_FONT, 'A');
+    CHECK_EQ(font_glyph_alpha(AA2_FONT, a2, 0, 0), 0);
+    CHECK_EQ(font_glyph_alpha(AA2_FONT, a2, 1, 0), 85);
+    CHECK(!font_glyph_bit(AA2_FONT, a2, 1, 0));
+    CHECK(font_glyph_bit(AA2_FONT, a2, 2, 0));
+    CHECK_EQ(font_glyph_alpha(AA2_FONT, a2, 0, 1), 255);
+
+    /* B starts at bit 36: the low nibble of 0x52 */
+    const FontGlyph& b4 = font_glyph(AA4_FONT, 'B');
+    CHECK_EQ(font_glyph_alpha(AA4_FONT, b4, 0, 0), 2 * 17);
+    CHECK_EQ(font_glyph_alpha(AA4_FONT, b4, 1, 0), 9 * 17);
+    CHECK(font_glyph_bit(AA4_FONT, b4, 1, 0));
+
+    /* codes outside the font draw as its first glyph */
+    CHECK(&font_glyph(AA4_FONT, 'z') == &font_glyph(AA4_FONT, 'A'));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testFontData();
+    checkFont(font_8x8, "Sc@le");
+    checkFont(AA2_FONT, "ABBA");
+    checkFont(AA4_FONT, "BAzB");
+    return test_result("fontTest");
+    }
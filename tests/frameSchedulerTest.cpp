@@ -0,0 +1,260 @@
+/*********************************************************************
+*
+*   NAME:
+*       frameSchedulerTest.cpp
+*
+*   DESCRIPTION:
+*       Drives FrameScheduler on the HostTransport clock with a
+*       HostVsync standing in for the panel's TE pin: frames hold the
+*       target rate, a slow frame is counted and moves the schedule,
+*       a TE source that never fires times out, and a synced flush
+*       starts at the simulated blank
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "frameScheduler.hpp"
+#include "hostTransport.hpp"
+#include "hostVsync.hpp"
+#include "testCheck.hpp"
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr DisplayProperties PROPS = {80, 60, 240, 320, 0, 0};
+constexpr uint16_t TARGET_FPS = 50;
+constexpr uint32_t PERIOD_US = 1000000 / TARGET_FPS;
+constexpr uint32_t RENDER_US = 5000;
+constexpr uint32_t SLACK_US = 2000;         /* real time spent drawing and flushing */
+constexpr uint32_t FRAMES = 20;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* notes the clock at the first write after arm() */
+class StampTransport : public HostTransport {
+    public:
+        explicit StampTransport(HostPanel* panel)
+            : HostTransport(panel), stamp(0), _armed(false)
+            {
+            }
+
+        void arm() { _armed = true; }
+
+        void write(const uint8_t* data, size_t len) override
+            {
+            if (_armed) {
+                stamp = now_us();
+                _armed = false;
+            }
+            HostTransport::write(data, len);
+            }
+
+        uint64_t stamp;
+
+    private:
+        bool _armed;
+};
+
+/* a panel with its framebuffer */
+struct SchedulerRig {
+    SchedulerRig()
+        : panel(240, 320), transport(&panel), display(transport, PROPS)
+        {
+        display.init(false);
+        display.attach_framebuffer(pixels);
+        }
+
+    HostPanel panel;
+    StampTransport transport;
+    ST7789VW display;
+    uint16_t pixels[80 * 60];
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       near
+*
+*   DESCRIPTION:
+*       True if b - a is want, give or take the real time between the
+*       scheduler reading the clock and the test reading it
+*
+*********************************************************************/
+static bool near(uint64_t a, uint64_t b, uint32_t want)
+    {
+    return b - a + SLACK_US >= want && b - a <= want + SLACK_US;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       runFrame
+*
+*   DESCRIPTION:
+*       One frame that takes render_us to draw; returns when it
+*       started
+*
+*********************************************************************/
+static uint64_t runFrame(SchedulerRig& rig, FrameScheduler& scheduler, uint32_t render_us, uint16_t color)
+    {
+    scheduler.begin_frame();
+    uint64_t start = rig.transport.now_us();
+    rig.display.fill_rect(10, 10, 20, 20, color);
+    rig.transport.delay_us(render_us);
+    scheduler.end_frame();
+    return start;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testTargetRate
+*
+*   DESCRIPTION:
+*       Frames shorter than the period start one period apart
+*
+*********************************************************************/
+static void testTargetRate()
+    {
+    SchedulerRig rig;
+    FrameScheduler scheduler(rig.display, TARGET_FPS);
+
+    uint64_t last = 0;
+    uint32_t off_pace = 0;
+    for (uint32_t i = 0; i < FRAMES; i++) {
+        uint64_t start = runFrame(rig, scheduler, RENDER_US, (uint16_t)(i * 0x0841));
+        if (i > 0) {
+            off_pace += !near(last, start, PERIOD_US);
+        }
+        last = start;
+    }
+    CHECK_EQ(off_pace, 0);
+    CHECK_EQ(scheduler.stats().frames, FRAMES);
+    CHECK_EQ(scheduler.stats().missed_deadlines, 0);
+    CHECK_EQ(scheduler.stats().vblank_timeouts, 0);
+
+    /* first start to last end: FRAMES - 1 periods plus one render */
+    uint32_t fps = scheduler.achieved_fps_x100();
+    uint32_t span_min = (FRAMES - 1) * PERIOD_US + RENDER_US;
+    CHECK(fps <= (uint32_t)((uint64_t)FRAMES * 100000000u / span_min));
+    CHECK(fps >= (uint32_t)((uint64_t)FRAMES * 100000000u / (span_min + FRAMES * SLACK_US)));
+    CHECK_EQ(rig.panel.pixel(15, 15), (uint16_t)((FRAMES - 1) * 0x0841));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testMissedDeadline
+*
+*   DESCRIPTION:
+*       A frame longer than the period is counted as missed and the
+*       next one starts when it ends; the frames after it go back to
+*       one per period instead of bursting to catch up
+*
+*********************************************************************/
+static void testMissedDeadline()
+    {
+    SchedulerRig rig;
+    FrameScheduler scheduler(rig.display, TARGET_FPS);
+
+    runFrame(rig, scheduler, RENDER_US, 0x1111);
+    uint64_t slow = runFrame(rig, scheduler, PERIOD_US + PERIOD_US / 2, 0x2222);
+    CHECK_EQ(scheduler.stats().missed_deadlines, 1);
+    CHECK(scheduler.stats().max_render_us >= PERIOD_US + PERIOD_US / 2);
+
+    uint64_t after = runFrame(rig, scheduler, RENDER_US, 0x3333);
+    uint64_t next = runFrame(rig, scheduler, RENDER_US, 0x4444);
+    uint64_t last = runFrame(rig, scheduler, RENDER_US, 0x5555);
+    CHECK(near(slow, after, PERIOD_US + PERIOD_US / 2));
+    CHECK(near(after, next, PERIOD_US));
+    CHECK(near(next, last, PERIOD_US));
+    CHECK_EQ(scheduler.stats().missed_deadlines, 1);
+    CHECK_EQ(scheduler.stats().frames, 5);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testVblankTimeout
+*
+*   DESCRIPTION:
+*       A TE source that never fires is counted once per frame and
+*       the frame is still flushed
+*
+*********************************************************************/
+static void testVblankTimeout()
+    {
+    SchedulerRig rig;
+    HostVsync silent(rig.transport, 0);
+    FrameScheduler scheduler(rig.display, TARGET_FPS, &silent);
+
+    for (uint16_t i = 0; i < 3; i++) {
+        runFrame(rig, scheduler, RENDER_US, (uint16_t)(0x0F0F + i));
+    }
+    CHECK_EQ(scheduler.stats().vblank_timeouts, 3);
+    CHECK_EQ(silent.vblanks(), 0);
+    CHECK_EQ(rig.panel.pixel(15, 15), 0x0F11);
+    CHECK_EQ(rig.transport.stats().command_counts[0x35], 1);        /* TEON */
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testFlushAfterBlank
+*
+*   DESCRIPTION:
+*       With a TE source the first byte of each flush goes out at the
+*       start of a simulated blank, not when drawing ends
+*
+*********************************************************************/
+static void testFlushAfterBlank()
+    {
+    const uint32_t refresh_us = 16667;
+    SchedulerRig rig;
+    HostVsync vsync(rig.transport, refresh_us);
+    FrameScheduler scheduler(rig.display, 30, &vsync);
+
+    uint32_t late = 0;
+    for (uint16_t i = 0; i < 6; i++) {
+        scheduler.begin_frame();
+        rig.display.fill_rect(10, 10, 20, 20, (uint16_t)(0x7000 + i));
+        rig.transport.delay_us(RENDER_US + i * 1000);
+        uint64_t render_end = rig.transport.now_us();
+        rig.transport.arm();
+        scheduler.end_frame();
+
+        uint64_t stamp = rig.transport.stamp;
+        uint64_t blank = stamp / refresh_us * refresh_us;
+        late += (blank < render_end || stamp - blank > SLACK_US);
+    }
+    CHECK_EQ(late, 0);
+    CHECK_EQ(vsync.vblanks(), 6);
+    CHECK_EQ(scheduler.stats().vblank_timeouts, 0);
+    CHECK_EQ(rig.panel.pixel(15, 15), 0x7005);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testTargetRate();
+    testMissedDeadline();
+    testVblankTimeout();
+    testFlushAfterBlank();
+    return test_result("frameSchedulerTest");
+    }
@@ -0,0 +1,301 @@
+/*********************************************************************
+*
+*   NAME:
+*       framebufferTest.cpp
+*
+*   DESCRIPTION:
+*       DirtyTracker merges neighbouring row spans while the clean
+*       pixels they add stay within FLUSH_MERGE_SLACK_PIXELS and
+*       splits them past it, never missing a dirty pixel; a flush
+*       sends one window per merged rectangle, touches nothing else,
+*       and leaves the panel equal to the framebuffer
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+#include "framebuffer.hpp"
+#include "hostTransport.hpp"
+#include "testCheck.hpp"
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t WIDTH = 240;
+constexpr uint16_t HEIGHT = 320;
+constexpr DisplayProperties PROPS = {WIDTH, HEIGHT, WIDTH, HEIGHT, 0, 0};
+constexpr uint16_t SENTINEL = 0x1234;
+constexpr uint16_t SLACK = (uint16_t)FLUSH_MERGE_SLACK_PIXELS;
+
+/*--------------------------------------------------------------------
+                              VARIABLES
+--------------------------------------------------------------------*/
+static uint16_t framebuffer[WIDTH * HEIGHT];
+static bool marked[HEIGHT][WIDTH];
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       rectCount
+*
+*   DESCRIPTION:
+*       Rectangles next_rect() hands out, the first one in first
+*
+*********************************************************************/
+static uint32_t rectCount(const DirtyTracker& dirty, DisplayRect& first)
+    {
+    uint32_t n = 0;
+    uint16_t row = 0;
+    DisplayRect rect;
+    while (dirty.next_rect(row, rect)) {
+        if (n == 0) {
+            first = rect;
+        }
+        n++;
+    }
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testMergeSlack
+*
+*   DESCRIPTION:
+*       A row one span wider than the last is merged while the clean
+*       pixels it adds are exactly the slack, and split one past it;
+*       spans far apart and rows with a clean row between are split
+*
+*********************************************************************/
+static void testMergeSlack()
+    {
+    DirtyTracker dirty;
+    DisplayRect rect;
+
+    /* [0, 10) over [0, 10 + SLACK): the rectangle gains SLACK clean pixels */
+    dirty.reset(WIDTH, HEIGHT);
+    dirty.mark(0, 20, 10, 1);
+    dirty.mark(0, 21, 10 + SLACK, 1);
+    CHECK_EQ(rectCount(dirty, rect), 1);
+    CHECK(rect.x == 0 && rect.y == 20 && rect.width == 10 + SLACK && rect.height == 2);
+
+    dirty.reset(WIDTH, HEIGHT);
+    dirty.mark(0, 20, 10, 1);
+    dirty.mark(0, 21, 11 + SLACK, 1);
+    CHECK_EQ(rectCount(dirty, rect), 2);
+    CHECK(rect.x == 0 && rect.y == 20 && rect.width == 10 && rect.height == 1);
+
+    /* the same spans the other way round cost the same */
+    dirty.reset(WIDTH, HEIGHT);
+    dirty.mark(0, 20, 10 + SLACK, 1);
+    dirty.mark(0, 21, 10, 1);
+    CHECK_EQ(rectCount(dirty, rect), 1);
+
+    dirty.reset(WIDTH, HEIGHT);
+    dirty.mark(0, 30, 10, 1);
+    dirty.mark(100, 31, 10, 1);
+    CHECK_EQ(rectCount(dirty, rect), 2);
+
+    dirty.reset(WIDTH, HEIGHT);
+    dirty.mark(5, 40, 10, 1);
+    dirty.mark(5, 42, 10, 1);
+    CHECK_EQ(rectCount(dirty, rect), 2);
+
+    /* a tall block merges row by row into one rectangle */
+    dirty.reset(WIDTH, HEIGHT);
+    dirty.mark(50, 60, 30, 40);
+    dirty.mark(52, 70, 20, 5);
+    CHECK_EQ(rectCount(dirty, rect), 1);
+    CHECK(rect.x == 50 && rect.y == 60 && rect.width == 30 && rect.height == 40);
+
+    dirty.clear();
+    CHECK(dirty.empty());
+    CHECK_EQ(rectCount(dirty, rect), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testCoverage
+*
+*   DESCRIPTION:
+*       Scattered marks, some clipped at the right edge: the
+*       rectangles cover every marked pixel and stay inside the
+*       tracked area
+*
+*********************************************************************/
+static void testCoverage()
+    {
+    DirtyTracker dirty;
+    dirty.reset(WIDTH, HEIGHT);
+    for (uint16_t y = 0; y < HEIGHT; y++) {
+        for (uint16_t x = 0; x < WIDTH; x++) {
+            marked[y][x] = false;
+        }
+    }
+
+    uint32_t seed = 12345;
+    for (uint16_t i = 0; i < 60; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint16_t x = (uint16_t)((seed >> 8) % (WIDTH + 20));
+        uint16_t y = (uint16_t)((seed >> 16) % HEIGHT);
+        uint16_t w = (uint16_t)(1 + (seed >> 4) % 40);
+        uint16_t h = (uint16_t)(1 + (seed >> 12) % 6);
+        dirty.mark(x, y, w, h);
+        for (uint16_t r = y; r < y + h && r < HEIGHT; r++) {
+            for (uint16_t c = x; c < x + w && c < WIDTH; c++) {
+                marked[r][c] = true;
+            }
+        }
+    }
+
+    uint32_t outside = 0;
+    uint16_t row = 0;
+    DisplayRect rect;
+    while (dirty.next_rect(row, rect)) {
+        outside += (rect.x + rect.width > WIDTH || rect.y + rect.height > HEIGHT);
+        for (uint16_t r = rect.y; r < rect.y + rect.height && r < HEIGHT; r++) {
+            for (uint16_t c = rect.x; c < rect.x + rect.width && c < WIDTH; c++) {
+                marked[r][c] = false;
+            }
+        }
+    }
+
+    uint32_t missed = 0;
+    for (uint16_t y = 0; y < HEIGHT; y++) {
+        for (uint16_t x = 0; x < WIDTH; x++) {
+            missed += marked[y][x];
+        }
+    }
+    CHECK_EQ(missed, 0);
+    CHECK_EQ(outside, 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       countChanged
+*
+*   DESCRIPTION:
+*       Panel pixels no longer holding the sentinel
+*
+*********************************************************************/
+static uint32_t countChanged(const HostPanel& panel)
+    {
+    uint32_t n = 0;
+    for (uint16_t y = 0; y < HEIGHT; y++) {
+        for (uint16_t x = 0; x < WIDTH; x++) {
+            n += (panel.pixel(x, y) != SENTINEL);
+        }
+    }
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       countDifferent
+*
+*   DESCRIPTION:
+*       Panel pixels that differ from the framebuffer (wire order)
+*
+*********************************************************************/
+static uint32_t countDifferent(const HostPanel& panel)
+    {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(framebuffer);
+    uint32_t n = 0;
+    for (uint16_t y = 0; y < HEIGHT; y++) {
+        for (uint16_t x = 0; x < WIDTH; x++) {
+            size_t i = ((size_t)y * WIDTH + x) * 2;
+            n += (panel.pixel(x, y) != (uint16_t)((bytes[i] << 8) | bytes[i + 1]));
+        }
+    }
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testFlush
+*
+*   DESCRIPTION:
+*       Merged rows go out as one window and split ones as two, the
+*       panel outside them is left alone, and after a scene of
+*       overlapping draws the panel equals the framebuffer
+*
+*********************************************************************/
+static void testFlush()
+    {
+    HostPanel panel(WIDTH, HEIGHT);
+    HostTransport transport(&panel);
+    ST7789VW display(transport, PROPS);
+    display.init(false);
+    display.attach_framebuffer(framebuffer);
+    display.fill(0x0000);
+    display.flush();
+    const uint32_t* counts = transport.stats().command_counts;
+
+    /* within the slack: one window of the merged size */
+    panel.clear(SENTINEL);
+    transport.reset_stats();
+    display.fill_rect(10, 10, 20, 1, 0xF800);
+    display.fill_rect(10, 11, 20 + SLACK / 2, 1, 0xF800);
+    display.flush();
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::RAMWR], 1);
+    CHECK_EQ(countChanged(panel), 2u * (20 + SLACK / 2));
+
+    /* past it: a window each */
+    panel.clear(SENTINEL);
+    transport.reset_stats();
+    display.fill_rect(0, 50, 10, 1, 0x07E0);
+    display.fill_rect(100, 51, 10, 1, 0x07E0);
+    display.flush();
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::RAMWR], 2);
+    CHECK_EQ(countChanged(panel), 20);
+
+    /* nothing drawn, nothing sent */
+    transport.reset_stats();
+    display.flush();
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::RAMWR], 0);
+
+    panel.clear(SENTINEL);
+    display.fill(0x0000);
+    display.flush();
+    uint32_t seed = 777;
+    for (uint16_t i = 0; i < 40; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int16_t x = (int16_t)((seed >> 8) % (WIDTH + 40)) - 20;
+        int16_t y = (int16_t)((seed >> 16) % (HEIGHT + 40)) - 20;
+        display.fill_rect(x, y, (uint16_t)(1 + (seed >> 4) % 50), (uint16_t)(1 + (seed >> 12) % 8), (uint16_t)seed);
+    }
+    display.write_string_pos(13, 200, "dirty text", (uint16_t)0xFFFF, (uint16_t)0x0010);
+    display.write_string_pos(101, 7, "over", (uint16_t)0xFFE0);
+    display.flush();
+    CHECK_EQ(countDifferent(panel), 0);
+    CHECK_EQ(panel.stray_bytes(), 0);
+    display.detach_framebuffer();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testMergeSlack();
+    testCoverage();
+    testFlush();
+    return test_result("framebufferTest");
+    }
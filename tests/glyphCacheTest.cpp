@@ -0,0 +1,246 @@
+/*********************************************************************
+*
+*   NAME:
+*       glyphCacheTest.cpp
+*
+*   DESCRIPTION:
+*       GlyphCache hits, misses and LRU eviction within a set, entries
+*       of the current run staying pinned until the next begin_run(),
+*       and opaque text drawn through a cache too small for its runs
+*       matching text drawn without one
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+#include "glyphCache.hpp"
+#include "hostTransport.hpp"
+#include "testCheck.hpp"
+#include <string.h>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t FG = 0xFFE0;
+constexpr uint16_t BG = 0x001F;
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       isGlyph
+*
+*   DESCRIPTION:
+*       True if pixels hold the expanded glyph for c in fg over bg
+*
+*********************************************************************/
+static bool isGlyph(const uint8_t* pixels, char c, uint16_t fg, uint16_t bg)
+    {
+    uint8_t want[16];
+    for (int i = 0; i < 8; i++) {
+        expand_glyph_row(want, font[(uint8_t)c][i], fg, bg);
+        if (memcmp(pixels + i * 16, want, sizeof(want)) != 0) {
+            return false;
+        }
+    }
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       useOnce
+*
+*   DESCRIPTION:
+*       Looks a glyph up in a run of its own, so nothing stays pinned
+*
+*********************************************************************/
+static const uint8_t* useOnce(GlyphCache& cache, char c)
+    {
+    cache.begin_run();
+    return cache.lookup(c, FG, BG);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testHitMiss
+*
+*   DESCRIPTION:
+*       The first lookup expands the glyph, the next returns the same
+*       entry; another color pair is a different entry
+*
+*********************************************************************/
+static void testHitMiss()
+    {
+    GlyphCacheEntry entries[GLYPH_CACHE_WAYS];
+    GlyphCache cache(entries, GLYPH_CACHE_WAYS);
+    CHECK_EQ(cache.capacity(), GLYPH_CACHE_WAYS);
+
+    const uint8_t* first = useOnce(cache, 'A');
+    CHECK(first != nullptr && isGlyph(first, 'A', FG, BG));
+    CHECK(useOnce(cache, 'A') == first);
+    CHECK_EQ(cache.stats().misses, 1);
+    CHECK_EQ(cache.stats().hits, 1);
+
+    cache.begin_run();
+    const uint8_t* swapped = cache.lookup('A', BG, FG);
+    CHECK(swapped != nullptr && swapped != first && isGlyph(swapped, 'A', BG, FG));
+    CHECK_EQ(cache.stats().misses, 2);
+    CHECK_EQ(cache.stats().evictions, 0);
+
+    cache.clear();
+    useOnce(cache, 'A');
+    CHECK_EQ(cache.stats().misses, 3);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testEviction
+*
+*   DESCRIPTION:
+*       A full set replaces its least recently used entry, and a hit
+*       makes an entry the most recently used
+*
+*********************************************************************/
+static void testEviction()
+    {
+    GlyphCacheEntry entries[GLYPH_CACHE_WAYS];
+    GlyphCache cache(entries, GLYPH_CACHE_WAYS);
+
+    for (char c = 'A'; c < 'A' + GLYPH_CACHE_WAYS; c++) {
+        useOnce(cache, c);
+    }
+    CHECK_EQ(cache.stats().evictions, 0);
+
+    /* 'A' is used again, so 'B' is now the oldest */
+    useOnce(cache, 'A');
+    const uint8_t* e = useOnce(cache, 'E');
+    CHECK(e != nullptr && isGlyph(e, 'E', FG, BG));
+    CHECK_EQ(cache.stats().evictions, 1);
+
+    cache.reset_stats();
+    useOnce(cache, 'A');
+    useOnce(cache, 'C');
+    useOnce(cache, 'D');
+    CHECK_EQ(cache.stats().hits, 3);
+    useOnce(cache, 'B');
+    CHECK_EQ(cache.stats().misses, 1);
+    CHECK_EQ(cache.stats().evictions, 1);
+
+    /* 'B' took the place of 'E', the oldest after the hits above */
+    useOnce(cache, 'E');
+    CHECK_EQ(cache.stats().misses, 2);
+    CHECK_EQ(cache.stats().hits, 3);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testPinning
+*
+*   DESCRIPTION:
+*       Glyphs looked up since begin_run() are never evicted: with the
+*       set full of them a further glyph is a bypass and every pointer
+*       already handed out still holds its glyph. The next run may
+*       evict them again.
+*
+*********************************************************************/
+static void testPinning()
+    {
+    GlyphCacheEntry entries[GLYPH_CACHE_WAYS];
+    GlyphCache cache(entries, GLYPH_CACHE_WAYS);
+    const uint8_t* held[GLYPH_CACHE_WAYS];
+
+    cache.begin_run();
+    for (uint8_t k = 0; k < GLYPH_CACHE_WAYS; k++) {
+        held[k] = cache.lookup((char)('A' + k), FG, BG);
+        CHECK(held[k] != nullptr);
+    }
+    CHECK(cache.lookup('Z', FG, BG) == nullptr);
+    CHECK(cache.lookup('Z', BG, FG) == nullptr);
+    CHECK_EQ(cache.stats().bypasses, 2);
+    CHECK_EQ(cache.stats().evictions, 0);
+
+    uint32_t overwritten = 0;
+    for (uint8_t k = 0; k < GLYPH_CACHE_WAYS; k++) {
+        overwritten += !isGlyph(held[k], (char)('A' + k), FG, BG);
+    }
+    CHECK_EQ(overwritten, 0);
+
+    /* a hit within the run doesn't unpin anything either */
+    CHECK(cache.lookup('A', FG, BG) == held[0]);
+    CHECK(cache.lookup('Z', FG, BG) == nullptr);
+
+    CHECK(useOnce(cache, 'Z') != nullptr);
+    CHECK_EQ(cache.stats().evictions, 1);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testDisplayText
+*
+*   DESCRIPTION:
+*       Text drawn through a two-entry cache, with runs longer than it
+*       holds and repeated so some glyphs hit, equals uncached text
+*
+*********************************************************************/
+static void testDisplayText()
+    {
+    static const char* const lines[] = {"AAAA", "ABCDEFGH", "abab abab", "AAAA"};
+    DisplayProperties props = {240, 320, 240, 320, 0, 0};
+    HostPanel plain_panel(240, 320);
+    HostPanel cached_panel(240, 320);
+    HostTransport plain_transport(&plain_panel);
+    HostTransport cached_transport(&cached_panel);
+    ST7789VW plain(plain_transport, props);
+    ST7789VW cached(cached_transport, props);
+    plain.init(false);
+    cached.init(false);
+
+    GlyphCacheEntry entries[2];
+    GlyphCache cache(entries, 2);
+    cached.set_glyph_cache(&cache);
+
+    for (uint16_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+        plain.write_string_pos(3, (int16_t)(5 + i * 9), lines[i], FG, BG);
+        cached.write_string_pos(3, (int16_t)(5 + i * 9), lines[i], FG, BG);
+    }
+    CHECK(cache.stats().hits > 0);
+    CHECK(cache.stats().bypasses > 0);
+
+    uint32_t differing = 0;
+    for (uint16_t y = 0; y < 320; y++) {
+        for (uint16_t x = 0; x < 240; x++) {
+            differing += (plain_panel.pixel(x, y) != cached_panel.pixel(x, y));
+        }
+    }
+    CHECK_EQ(differing, 0);
+    CHECK_EQ(cached_panel.stray_bytes(), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testHitMiss();
+    testEviction();
+    testPinning();
+    testDisplayText();
+    return test_result("glyphCacheTest");
+    }
@@ -0,0 +1,299 @@
+/*********************************************************************
+*
+*   NAME:
+*       hostPanelTest.cpp
+*
+*   DESCRIPTION:
+*       Drives ST7789VW through HostTransport and checks what the
+*       HostPanel model ends up holding after fills and text
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+#include "font.hpp"
+#include "graphics.hpp"
+#include "hostTransport.hpp"
+#include "testCheck.hpp"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       countRect
+*
+*   DESCRIPTION:
+*       Counts panel pixels of a color inside a rectangle
+*
+*********************************************************************/
+static uint32_t countRect(const HostPanel& panel, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+    {
+    uint32_t n = 0;
+    for (uint16_t row = y; row < y + h; row++) {
+        for (uint16_t col = x; col < x + w; col++) {
+            n += (panel.pixel(col, row) == color);
+        }
+    }
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       checkGlyph
+*
+*   DESCRIPTION:
+*       Compares an 8x8 cell of the panel with font[][]. Unset pixels
+*       must be bg (opaque text) or keep their old color.
+*
+*********************************************************************/
+static void checkGlyph(const HostPanel& panel, uint16_t x, uint16_t y, char c, uint16_t fg, uint16_t bg)
+    {
+    uint32_t wrong = 0;
+    for (uint16_t row = 0; row < 8; row++) {
+        for (uint16_t col = 0; col < 8; col++) {
+            bool set = (font[(uint8_t)c][row] >> (7 - col)) & 1;
+            wrong += panel.pixel(x + col, y + row) != (set ? fg : bg);
+        }
+    }
+    CHECK_EQ(wrong, 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testFillsAndText
+*
+*   DESCRIPTION:
+*       Full-panel geometry: screen and memory coordinates coincide
+*
+*********************************************************************/
+static void testFillsAndText()
+    {
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    DisplayProperties props = {240, 320, 240, 320, 0, 0};
+    ST7789VW display(transport, props);
+    display.init();
+
+    CHECK(panel.display_on());
+    CHECK_EQ(panel.colmod(), 0x55);
+    CHECK_EQ(panel.madctl(), 0x00);
+
+    display.fill((uint16_t)Colors::RED);
+    CHECK_EQ(countRect(panel, 0, 0, 240, 320, (uint16_t)Colors::RED), 240 * 320);
+
+    display.fill_rect(10, 20, 30, 40, (uint16_t)Colors::GREEN);
+    CHECK_EQ(countRect(panel, 10, 20, 30, 40, (uint16_t)Colors::GREEN), 30 * 40);
+    CHECK_EQ(countRect(panel, 0, 0, 240, 320, (uint16_t)Colors::GREEN), 30 * 40);
+
+    display.write_string_pos((uint16_t)16, (uint16_t)100, "Ab", (uint16_t)Colors::WHITE, (uint16_t)Colors::BLUE);
+    checkGlyph(panel, 16, 100, 'A', (uint16_t)Colors::WHITE, (uint16_t)Colors::BLUE);
+    checkGlyph(panel, 24, 100, 'b', (uint16_t)Colors::WHITE, (uint16_t)Colors::BLUE);
+
+    display.write_string_pos((uint16_t)40, (uint16_t)120, "x", (uint16_t)Colors::YELLOW);
+    checkGlyph(panel, 40, 120, 'x', (uint16_t)Colors::YELLOW, (uint16_t)Colors::RED);
+
+    CHECK_EQ(panel.stray_bytes(), 0);
+    CHECK_EQ(transport.stats().unselected_bytes, 0);
+    CHECK_EQ(transport.stats().early_releases, 0);
+    CHECK(transport.stats().transactions > 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testOffsetPanel
+*
+*   DESCRIPTION:
+*       240x280 module in 240x320 controller memory: drawing lands
+*       y_offset rows down and never touches the rows outside
+*
+*********************************************************************/
+static void testOffsetPanel()
+    {
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    DisplayProperties props = {240, 280, 240, 320, 0, 20};
+    ST7789VW display(transport, props);
+    display.init();
+    panel.clear(0x1234);
+
+    display.fill((uint16_t)Colors::CYAN);
+    CHECK_EQ(countRect(panel, 0, 20, 240, 280, (uint16_t)Colors::CYAN), 240 * 280);
+    CHECK_EQ(countRect(panel, 0, 0, 240, 20, 0x1234), 240 * 20);
+    CHECK_EQ(countRect(panel, 0, 300, 240, 20, 0x1234), 240 * 20);
+
+    display.write_string_pos((uint16_t)0, (uint16_t)0, "Z", (uint16_t)Colors::BLACK, (uint16_t)Colors::WHITE);
+    checkGlyph(panel, 0, 20, 'Z', (uint16_t)Colors::BLACK, (uint16_t)Colors::WHITE);
+    CHECK_EQ(panel.stray_bytes(), 0);
+
+    CHECK(panel.write_ppm("hostPanelTest.ppm"));
+    remove("hostPanelTest.ppm");
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testOversizePanel
+*
+*   DESCRIPTION:
+*       A panel taller than the dirty tracker and line buffer hold is
+*       clamped at construction, so a fill stops at the last tracked
+*       row instead of running past the buffers
+*
+*********************************************************************/
+static void testOversizePanel()
+    {
+    HostPanel panel(240, 400);
+    HostTransport transport(&panel);
+    DisplayProperties props = {240, 400, 240, 400, 0, 0};
+    ST7789VW display(transport, props);
+    CHECK_EQ(display.width(), 240);
+    CHECK_EQ(display.height(), FRAMEBUFFER_MAX_ROWS);
+
+    display.init();
+    panel.clear(0x1234);
+    display.fill((uint16_t)Colors::CYAN);
+    CHECK_EQ(countRect(panel, 0, 0, 240, FRAMEBUFFER_MAX_ROWS, (uint16_t)Colors::CYAN), 240 * FRAMEBUFFER_MAX_ROWS);
+    CHECK_EQ(countRect(panel, 0, FRAMEBUFFER_MAX_ROWS, 240, 400 - FRAMEBUFFER_MAX_ROWS, 0x1234), 240 * (400 - FRAMEBUFFER_MAX_ROWS));
+    CHECK_EQ(panel.stray_bytes(), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testViewport
+*
+*   DESCRIPTION:
+*       Negative viewport coordinates reach left of and above the
+*       origin and are clipped to the viewport
+*
+*********************************************************************/
+static void testViewport()
+    {
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    DisplayProperties props = {240, 320, 240, 320, 0, 0};
+    ST7789VW display(transport, props);
+    display.init();
+    display.fill((uint16_t)Colors::BLACK);
+
+    CHECK(display.push_viewport(50, 60, 100, 80));
+    display.fill_rect(-10, -10, 30, 30, (uint16_t)Colors::RED);
+    display.fill_rect(90, 70, 30, 30, (uint16_t)Colors::GREEN);
+    display.pop_clip();
+
+    CHECK_EQ(countRect(panel, 50, 60, 20, 20, (uint16_t)Colors::RED), 20 * 20);
+    CHECK_EQ(countRect(panel, 140, 130, 10, 10, (uint16_t)Colors::GREEN), 10 * 10);
+    CHECK_EQ(countRect(panel, 0, 0, 240, 320, (uint16_t)Colors::BLACK), 240 * 320 - 20 * 20 - 10 * 10);
+    CHECK_EQ(panel.stray_bytes(), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testGraphicsViewport
+*
+*   DESCRIPTION:
+*       Graphics shapes are relative to the viewport and clipped to it
+*       and to a narrower push_clip, not to the whole screen
+*
+*********************************************************************/
+static void testGraphicsViewport()
+    {
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    DisplayProperties props = {240, 320, 240, 320, 0, 0};
+    ST7789VW display(transport, props);
+    display.init();
+    display.fill((uint16_t)Colors::BLACK);
+    Graphics gfx(display);
+
+    /* a disc centred on the viewport's corner only covers its quarter */
+    CHECK(display.push_viewport(60, 80, 100, 120));
+    gfx.fill_circle(0, 0, 40, (uint16_t)Colors::RED);
+    gfx.fill_rect(-20, 100, 200, 50, (uint16_t)Colors::GREEN);
+    CHECK(display.push_clip(0, 0, 50, 60));
+    gfx.fill_circle(50, 60, 30, (uint16_t)Colors::BLUE);
+    display.reset_clip();
+
+    uint32_t inside = countRect(panel, 60, 80, 100, 120, (uint16_t)Colors::BLACK);
+    CHECK_EQ(countRect(panel, 0, 0, 240, 320, (uint16_t)Colors::BLACK) - inside, 240 * 320 - 100 * 120);
+    CHECK_EQ(countRect(panel, 60, 200 - 20, 100, 20, (uint16_t)Colors::GREEN), 100 * 20);
+    CHECK(countRect(panel, 60, 80, 40, 40, (uint16_t)Colors::RED) > 0);
+    CHECK_EQ(countRect(panel, 110, 80, 50, 100, (uint16_t)Colors::BLUE), 0);
+    CHECK_EQ(countRect(panel, 60, 140, 50, 40, (uint16_t)Colors::BLUE), 0);
+    CHECK(countRect(panel, 80, 110, 30, 30, (uint16_t)Colors::BLUE) > 0);
+    CHECK_EQ(panel.stray_bytes(), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testRotatedFramebuffer
+*
+*   DESCRIPTION:
+*       Rotating with a framebuffer attached flushes what was drawn,
+*       keeps the buffer in the new geometry and sends none of its
+*       old-orientation contents; only what is drawn afterwards goes
+*       out
+*
+*********************************************************************/
+static void testRotatedFramebuffer()
+    {
+    static uint16_t pixels[240 * 320];
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    DisplayProperties props = {240, 320, 240, 320, 0, 0};
+    ST7789VW display(transport, props);
+    display.init();
+    display.attach_framebuffer(pixels);
+    display.fill((uint16_t)Colors::BLUE);
+    display.fill_rect(0, 0, 50, 50, (uint16_t)Colors::RED);
+
+    display.set_rotation(ST7789VW::Rotation::ROTATION_270);
+    CHECK(display.framebuffer_attached());
+    CHECK_EQ(countRect(panel, 0, 0, 240, 320, (uint16_t)Colors::RED), 50 * 50);
+    CHECK_EQ(countRect(panel, 0, 0, 240, 320, (uint16_t)Colors::BLUE), 240 * 320 - 50 * 50);
+
+    transport.reset_stats();
+    display.flush();
+    CHECK_EQ(transport.stats().command_counts[(uint8_t)ST7789VW_CMD::RAMWR], 0);
+
+    display.fill_rect(300, 200, 20, 40, (uint16_t)Colors::GREEN);
+    display.flush();
+    CHECK_EQ(countRect(panel, 0, 0, 240, 320, (uint16_t)Colors::GREEN), 20 * 40);
+    CHECK_EQ(countRect(panel, 0, 0, 240, 320, (uint16_t)Colors::BLUE) + countRect(panel, 0, 0, 240, 320, (uint16_t)Colors::RED),
+             240 * 320 - 20 * 40);
+    CHECK_EQ(panel.stray_bytes(), 0);
+
+    display.detach_framebuffer();
+    CHECK(!display.framebuffer_attached());
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testFillsAndText();
+    testOffsetPanel();
+    testOversizePanel();
+    testViewport();
+    testGraphicsViewport();
+    testRotatedFramebuffer();
+    return test_result("hostPanelTest");
+    }
@@ -0,0 +1,231 @@
+/*********************************************************************
+*
+*   NAME:
+*       initSequenceTest.cpp
+*
+*   DESCRIPTION:
+*       Runs the non-blocking init on an injected clock: every step
+*       goes out at its deadline and not before, the bus sees exactly
+*       what blocking init() sends, and SWRESET forgets the cached
+*       controller state
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+#include "hostTransport.hpp"
+#include "testCheck.hpp"
+#include <vector>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr DisplayProperties PROPS = {240, 280, 240, 320, 0, 20};
+constexpr uint32_t POLL_LIMIT_MS = 1000;
+
+/* recorded in place of bytes for the control lines */
+constexpr uint16_t EVENT_SELECT = 0x100;
+constexpr uint16_t EVENT_DESELECT = 0x101;
+constexpr uint16_t EVENT_RESET_LOW = 0x102;
+constexpr uint16_t EVENT_RESET_HIGH = 0x103;
+constexpr uint16_t DATA_FLAG = 0x200;      /* OR'd into bytes sent with D/C high */
+
+/* when something reaches the bus, in ms from the first poll */
+static const uint32_t HW_RESET_STEPS_MS[] = {0, 10, 130, 280, 330};
+constexpr uint32_t HW_RESET_DONE_MS = 380;
+static const uint32_t SW_RESET_STEPS_MS[] = {0, 150, 200};
+constexpr uint32_t SW_RESET_DONE_MS = 250;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* records every byte with its D/C level, the CS edges and the reset pin */
+class StreamLog : public HostTransport {
+    public:
+        void select() override
+            {
+            HostTransport::select();
+            stream.push_back(EVENT_SELECT);
+            }
+
+        void deselect() override
+            {
+            HostTransport::deselect();
+            stream.push_back(EVENT_DESELECT);
+            }
+
+        void set_dc(bool data) override
+            {
+            HostTransport::set_dc(data);
+            _data = data;
+            }
+
+        void set_reset(bool level) override
+            {
+            HostTransport::set_reset(level);
+            stream.push_back(level ? EVENT_RESET_HIGH : EVENT_RESET_LOW);
+            }
+
+        void write(const uint8_t* data, size_t len) override
+            {
+            HostTransport::write(data, len);
+            for (size_t i = 0; i < len; i++) {
+                stream.push_back((uint16_t)(data[i] | (_data ? DATA_FLAG : 0)));
+            }
+            }
+
+        std::vector<uint16_t> stream;
+
+    private:
+        bool _data = false;
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       checkPolled
+*
+*   DESCRIPTION:
+*       Polls once per simulated ms and checks that the stream grows
+*       only at the expected times, that poll() reports done at
+*       done_ms and no earlier, and that the stream equals init()'s
+*
+*********************************************************************/
+static void checkPolled(bool hardware_reset, const uint32_t* steps_ms, size_t step_count, uint32_t done_ms)
+    {
+    StreamLog polled_log;
+    ST7789VW polled(polled_log, PROPS);
+    polled.begin_init(hardware_reset);
+
+    /* nothing goes out until the first poll */
+    CHECK(polled_log.stream.empty());
+
+    const uint64_t base_us = 5000000;
+    std::vector<uint32_t> grew_at;
+    uint32_t finished_at = POLL_LIMIT_MS;
+    size_t seen = 0;
+    for (uint32_t ms = 0; ms < POLL_LIMIT_MS; ms++) {
+        bool done = polled.poll(base_us + (uint64_t)ms * 1000u);
+        if (polled_log.stream.size() != seen) {
+            seen = polled_log.stream.size();
+            grew_at.push_back(ms);
+        }
+        if (done) {
+            finished_at = ms;
+            break;
+        }
+    }
+
+    CHECK_EQ(grew_at.size(), step_count);
+    for (size_t i = 0; i < step_count && i < grew_at.size(); i++) {
+        CHECK_EQ(grew_at[i], steps_ms[i]);
+    }
+    CHECK_EQ(finished_at, done_ms);
+    CHECK_EQ(polled.init_time_us(), done_ms * 1000u);
+    CHECK(polled.poll(base_us + (uint64_t)POLL_LIMIT_MS * 1000u));
+    CHECK_EQ(polled_log.stream.size(), seen);
+
+    StreamLog blocking_log;
+    ST7789VW blocking(blocking_log, PROPS);
+    blocking.init(hardware_reset);
+    CHECK_EQ(blocking_log.delayed_ms(), done_ms);
+    CHECK(polled_log.stream == blocking_log.stream);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testLateClock
+*
+*   DESCRIPTION:
+*       A late poll runs what is due in one go, and each following
+*       delay counts from that poll rather than from the missed
+*       deadline
+*
+*********************************************************************/
+static void testLateClock()
+    {
+    StreamLog log;
+    ST7789VW display(log, PROPS);
+    display.begin_init(false);
+
+    CHECK(!display.poll(0));
+    size_t after_swreset = log.stream.size();
+    CHECK(!display.poll(149999));
+    CHECK_EQ(log.stream.size(), after_swreset);
+
+    /* 100 ms late for SLPOUT: its 50 ms delay starts now */
+    CHECK(!display.poll(250000));
+    size_t after_slpout = log.stream.size();
+    CHECK(after_slpout > after_swreset);
+    CHECK(!display.poll(299999));
+    CHECK_EQ(log.stream.size(), after_slpout);
+    CHECK(!display.poll(300000));
+    CHECK(log.stream.size() > after_slpout);
+    CHECK(!display.poll(349999));
+    CHECK(display.poll(350000));
+    CHECK_EQ(display.init_time_us(), 350000);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testResetClearsShadow
+*
+*   DESCRIPTION:
+*       After SWRESET the controller has lost its window, format and
+*       orientation, so a second init and the same draw send them again
+*
+*********************************************************************/
+static void testResetClearsShadow()
+    {
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    ST7789VW display(transport, PROPS);
+    display.init(false);
+    display.fill_rect(10, 10, 20, 20, 0x1234);
+    display.fill_rect(10, 10, 20, 20, 0x4321);
+
+    const uint32_t* counts = transport.stats().command_counts;
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::CASET], 1);
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::COLMOD], 1);
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::MADCTL], 1);
+
+    display.begin_init(false);
+    for (uint32_t ms = 0; !display.poll((uint64_t)ms * 1000u); ms++) {
+    }
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::SWRESET], 2);
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::COLMOD], 2);
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::MADCTL], 2);
+
+    display.fill_rect(10, 10, 20, 20, 0x5678);
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::CASET], 2);
+    CHECK_EQ(counts[(uint8_t)ST7789VW_CMD::RASET], 2);
+    CHECK_EQ(panel.pixel(15, 35), 0x5678);
+    CHECK_EQ(panel.stray_bytes(), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    checkPolled(true, HW_RESET_STEPS_MS, sizeof(HW_RESET_STEPS_MS) / sizeof(HW_RESET_STEPS_MS[0]), HW_RESET_DONE_MS);
+    checkPolled(false, SW_RESET_STEPS_MS, sizeof(SW_RESET_STEPS_MS) / sizeof(SW_RESET_STEPS_MS[0]), SW_RESET_DONE_MS);
+    testLateClock();
+    testResetClearsShadow();
+    return test_result("initSequenceTest");
+    }
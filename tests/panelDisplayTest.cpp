@@ -0,0 +1,188 @@
+/*********************************************************************
+*
+*   NAME:
+*       panelDisplayTest.cpp
+*
+*   DESCRIPTION:
+*       PanelDisplay's compile-time geometry, and that the wrapper
+*       hands the panel's props and controller traits to ST7789VW:
+*       the controller's own init table runs and drawing lands on the
+*       panel's area of controller memory
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "hostTransport.hpp"
+#include "panelDisplay.hpp"
+#include "testCheck.hpp"
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef PanelDisplay<ST7789_240x280> Lcd280;
+typedef PanelDisplay<ST7735_128x160> Lcd160;
+typedef PanelDisplay<ILI9341_240x320> Lcd320;
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+/* geometry is usable in constant expressions */
+static_assert(Lcd280::WIDTH == 240 && Lcd280::HEIGHT == 280, "rotation 0 size");
+static_assert(Lcd280::props_for(ST7789VW::Rotation::ROTATION_90).width == 280, "rotated width");
+static_assert(Lcd280::props_for(ST7789VW::Rotation::ROTATION_90).height == 240, "rotated height");
+static_assert(Lcd280::props_for(ST7789VW::Rotation::ROTATION_270).x_offset == 20, "offset follows the rotation");
+static_assert(Lcd160::props_for(ST7789VW::Rotation::ROTATION_270).width == 160, "rotated width");
+static_assert(Lcd320::props_for(ST7789VW::Rotation::ROTATION_180).height == 320, "rotation 180 size");
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       countColor
+*
+*   DESCRIPTION:
+*       Counts panel memory pixels of a color
+*
+*********************************************************************/
+static uint32_t countColor(const HostPanel& panel, uint16_t color)
+    {
+    uint32_t n = 0;
+    for (uint16_t y = 0; y < panel.height(); y++) {
+        for (uint16_t x = 0; x < panel.width(); x++) {
+            n += (panel.pixel(x, y) == color);
+        }
+    }
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ranInitTable
+*
+*   DESCRIPTION:
+*       True if every command of the controller's init table was sent
+*
+*********************************************************************/
+static bool ranInitTable(const HostTransport& transport, const ControllerInfo& info)
+    {
+    size_t pos = 0;
+    while (pos < info.init_len) {
+        uint8_t cmd = info.init[pos];
+        uint8_t len = (uint8_t)(info.init[pos + 1] & ~CTRL_DELAY);
+        bool delay = (info.init[pos + 1] & CTRL_DELAY) != 0;
+        if (cmd != CTRL_FORMAT && transport.stats().command_counts[cmd] == 0) {
+            return false;
+        }
+        pos += 2 + len + (delay ? 1 : 0);
+    }
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       checkSizes
+*
+*   DESCRIPTION:
+*       width()/height() follow props_for() in every rotation
+*
+*********************************************************************/
+template <typename Panel>
+static void checkSizes()
+    {
+    HostTransport transport;
+    PanelDisplay<Panel> display(transport);
+    for (uint8_t r = 0; r < 4; r++) {
+        display.set_rotation((ST7789VW::Rotation)r);
+        DisplayProperties props = PanelDisplay<Panel>::props_for((ST7789VW::Rotation)r);
+        CHECK_EQ(display.width(), props.width);
+        CHECK_EQ(display.height(), props.height);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       checkFill
+*
+*   DESCRIPTION:
+*       Init runs the panel's controller table, and a fill covers the
+*       panel's area of controller memory and nothing else, in the
+*       rotations where the model's addressing matches the module
+*
+*********************************************************************/
+template <typename Panel>
+static void checkFill(uint16_t first_x, uint16_t first_y)
+    {
+    static const ST7789VW::Rotation rotations[] = {ST7789VW::Rotation::ROTATION_0, ST7789VW::Rotation::ROTATION_270};
+    const DisplayProperties& props = Panel::props;
+
+    HostPanel panel(props.map_width, props.map_height);
+    HostTransport transport(&panel);
+    PanelDisplay<Panel> display(transport);
+    display.init(false);
+    CHECK_EQ(panel.colmod(), Panel::controller::info.colmod_rgb565);
+    CHECK(ranInitTable(transport, Panel::controller::info));
+
+    for (ST7789VW::Rotation rotation : rotations) {
+        panel.clear(0x1234);
+        display.set_rotation(rotation);
+        display.fill(0xA5C3);
+        CHECK_EQ(countColor(panel, 0xA5C3), (uint32_t)props.width * props.height);
+        CHECK_EQ(panel.stray_bytes(), 0);
+    }
+
+    /* screen 0,0 in rotation 0 sits at the panel's offset */
+    display.set_rotation(ST7789VW::Rotation::ROTATION_0);
+    display.fill_rect(0, 0, 1, 1, 0x0F0F);
+    CHECK_EQ(panel.pixel(first_x, first_y), 0x0F0F);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testST7735Init
+*
+*   DESCRIPTION:
+*       The ST7735 panel gets its own init table and pixel format
+*       (the host panel model only decodes the ST7789 COLMOD values,
+*       so this panel is checked on the command stream)
+*
+*********************************************************************/
+static void testST7735Init()
+    {
+    HostTransport transport;
+    Lcd160 display(transport);
+    display.init(false);
+    CHECK(ranInitTable(transport, ST7735Controller::info));
+    CHECK(!ranInitTable(transport, ILI9341Controller::info));
+    CHECK_EQ(transport.stats().command_counts[(uint8_t)ST7789VW_CMD::COLMOD], 1);
+    CHECK_EQ(transport.stats().unselected_bytes, 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    checkSizes<ST7789_240x280>();
+    checkSizes<ST7735_128x160>();
+    checkSizes<ILI9341_240x320>();
+    checkFill<ST7789_240x280>(0, 20);
+    checkFill<ILI9341_240x320>(ILI9341_240x320::props.map_width - 1, 0);
+    testST7735Init();
+    return test_result("panelDisplayTest");
+    }
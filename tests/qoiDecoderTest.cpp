@@ -0,0 +1,301 @@
+/*********************************************************************
+*
+*   NAME:
+*       qoiDecoderTest.cpp
+*
+*   DESCRIPTION:
+*       Decodes a hand-assembled QOI stream that uses every op (RGB,
+*       RGBA, INDEX, DIFF, LUMA, RUN) and ends with the end marker,
+*       and checks the pixels, the bytes consumed, truncated streams
+*       and blit_qoi onto HostPanel
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+#include "hostTransport.hpp"
+#include "qoiDecoder.hpp"
+#include "testCheck.hpp"
+#include <string.h>
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    const uint8_t* data;
+    size_t len;
+    size_t pos;
+    size_t max_read;            /* bytes handed out per reader call */
+} MemoryStream;
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t IMAGE_W = 4;
+constexpr uint16_t IMAGE_H = 3;
+
+/* 4x3 image; the decoder starts from r,g,b,a = 0,0,0,255 */
+static const uint8_t STREAM[] = {
+    'q', 'o', 'i', 'f', 0, 0, 0, IMAGE_W, 0, 0, 0, IMAGE_H, 4, 0,
+    0xFE, 200, 100, 50,         /* RGB   (200,100,50), index slot 31   */
+    0x76,                       /* DIFF  +1 -1 +0  -> (201,99,50)      */
+    0xAA, 0xA3,                 /* LUMA  dg +10, dr +12, db +5         */
+    0xC2,                       /* RUN   3 more of (213,109,55)        */
+    0x1F,                       /* INDEX 31 -> (200,100,50)            */
+    0x4C,                       /* DIFF  -2 +1 -2  -> (198,101,48)     */
+    0xFF, 10, 20, 30, 128,      /* RGBA  alpha is dropped              */
+    0x80, 0xF0,                 /* LUMA  dg -32, dr -25, db -40, wraps */
+    0xFE, 255, 255, 255,        /* RGB   white                         */
+    0xC0,                       /* RUN   1 more white                  */
+    0, 0, 0, 0, 0, 0, 0, 1,     /* end marker                          */
+};
+constexpr size_t END_MARKER_SIZE = 8;
+
+static const uint8_t EXPECTED_RGB[IMAGE_W * IMAGE_H][3] = {
+    {200, 100, 50}, {201, 99, 50},  {213, 109, 55}, {213, 109, 55},
+    {213, 109, 55}, {213, 109, 55}, {200, 100, 50}, {198, 101, 48},
+    {10, 20, 30},   {241, 244, 246}, {255, 255, 255}, {255, 255, 255},
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       readMemory
+*
+*   DESCRIPTION:
+*       QoiReader over a MemoryStream
+*
+*********************************************************************/
+static size_t readMemory(void* context, uint8_t* buf, size_t len)
+    {
+    MemoryStream* s = (MemoryStream*)context;
+    size_t n = s->len - s->pos;
+    if (n > len) {
+        n = len;
+    }
+    if (n > s->max_read) {
+        n = s->max_read;
+    }
+    memcpy(buf, s->data + s->pos, n);
+    s->pos += n;
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       expected565
+*
+*   DESCRIPTION:
+*       Expected RGB565 value of pixel i
+*
+*********************************************************************/
+static uint16_t expected565(size_t i)
+    {
+    const uint8_t* p = EXPECTED_RGB[i];
+    return (uint16_t)(((p[0] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[2] >> 3));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       decodeAll
+*
+*   DESCRIPTION:
+*       Decodes every row into out (RGB565), returns how many rows
+*       decode_row reported good
+*
+*********************************************************************/
+static uint16_t decodeAll(QoiDecoder& decoder, uint16_t* out)
+    {
+    uint16_t good = 0;
+    for (uint16_t row = 0; row < IMAGE_H; row++) {
+        uint8_t wire[IMAGE_W * 2];
+        good += decoder.decode_row(wire, IMAGE_W) ? 1 : 0;
+        for (uint16_t col = 0; col < IMAGE_W; col++) {
+            out[row * IMAGE_W + col] = (uint16_t)((wire[col * 2] << 8) | wire[col * 2 + 1]);
+        }
+    }
+    return good;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testVector
+*
+*   DESCRIPTION:
+*       Every op decodes to the expected pixel, and the decoder stops
+*       in front of the end marker (fed one byte per read so the
+*       stream position is exact)
+*
+*********************************************************************/
+static void testVector()
+    {
+    MemoryStream stream = {STREAM, sizeof(STREAM), 0, 1};
+    QoiDecoder decoder(readMemory, &stream);
+    CHECK(decoder.read_header());
+    CHECK_EQ(decoder.width(), IMAGE_W);
+    CHECK_EQ(decoder.height(), IMAGE_H);
+
+    uint16_t pixels[IMAGE_W * IMAGE_H];
+    CHECK_EQ(decodeAll(decoder, pixels), IMAGE_H);
+    for (size_t i = 0; i < IMAGE_W * IMAGE_H; i++) {
+        CHECK_EQ(pixels[i], expected565(i));
+    }
+    CHECK_EQ(stream.pos, sizeof(STREAM) - END_MARKER_SIZE);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testColumns
+*
+*   DESCRIPTION:
+*       A column window keeps only its pixels but consumes whole rows
+*
+*********************************************************************/
+static void testColumns()
+    {
+    MemoryStream stream = {STREAM, sizeof(STREAM), 0, QOI_READ_CHUNK};
+    QoiDecoder decoder(readMemory, &stream);
+    CHECK(decoder.read_header());
+
+    for (uint16_t row = 0; row < IMAGE_H; row++) {
+        uint8_t wire[4] = {0xEE, 0xEE, 0xEE, 0xEE};
+        CHECK(decoder.decode_row(wire, 1, 2));
+        CHECK_EQ((uint16_t)((wire[0] << 8) | wire[1]), expected565(row * IMAGE_W + 2));
+        CHECK_EQ(wire[2], 0xEE);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testTruncated
+*
+*   DESCRIPTION:
+*       Every cut of the stream: a cut header is rejected; a cut body
+*       decodes the pixels before the cut, turns the rest black and
+*       reports the failure
+*
+*********************************************************************/
+static void testTruncated()
+    {
+    const size_t body_end = sizeof(STREAM) - END_MARKER_SIZE;
+    size_t last_good = 0;
+
+    for (size_t len = 0; len < body_end; len++) {
+        MemoryStream stream = {STREAM, len, 0, QOI_READ_CHUNK};
+        QoiDecoder decoder(readMemory, &stream);
+        if (len < QOI_HEADER_SIZE) {
+            CHECK(!decoder.read_header());
+            continue;
+        }
+        CHECK(decoder.read_header());
+
+        uint16_t pixels[IMAGE_W * IMAGE_H];
+        CHECK(decodeAll(decoder, pixels) < IMAGE_H);
+
+        size_t good = 0;
+        while (good < IMAGE_W * IMAGE_H && pixels[good] == expected565(good)) {
+            good++;
+        }
+        CHECK(good < IMAGE_W * IMAGE_H);
+        CHECK(good >= last_good);
+        last_good = good;
+
+        uint32_t not_black = 0;
+        for (size_t i = good; i < IMAGE_W * IMAGE_H; i++) {
+            not_black += (pixels[i] != 0);
+        }
+        CHECK_EQ(not_black, 0);
+    }
+
+    /* cut at the end marker: the image itself is complete */
+    MemoryStream stream = {STREAM, body_end, 0, QOI_READ_CHUNK};
+    QoiDecoder decoder(readMemory, &stream);
+    uint16_t pixels[IMAGE_W * IMAGE_H];
+    CHECK(decoder.read_header());
+    CHECK_EQ(decodeAll(decoder, pixels), IMAGE_H);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testBadHeader
+*
+*   DESCRIPTION:
+*       Wrong magic and zero sizes are rejected
+*
+*********************************************************************/
+static void testBadHeader()
+    {
+    uint8_t bad[sizeof(STREAM)];
+    memcpy(bad, STREAM, sizeof(STREAM));
+    bad[0] = 'Q';
+    MemoryStream stream = {bad, sizeof(bad), 0, QOI_READ_CHUNK};
+    QoiDecoder magic(readMemory, &stream);
+    CHECK(!magic.read_header());
+
+    memcpy(bad, STREAM, sizeof(STREAM));
+    bad[7] = 0;
+    stream = {bad, sizeof(bad), 0, QOI_READ_CHUNK};
+    QoiDecoder zero(readMemory, &stream);
+    CHECK(!zero.read_header());
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testBlit
+*
+*   DESCRIPTION:
+*       blit_qoi puts the decoded pixels on the panel
+*
+*********************************************************************/
+static void testBlit()
+    {
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    DisplayProperties props = {240, 320, 240, 320, 0, 0};
+    ST7789VW display(transport, props);
+    display.init(false);
+
+    MemoryStream stream = {STREAM, sizeof(STREAM), 0, 5};
+    QoiDecoder decoder(readMemory, &stream);
+    CHECK(display.blit_qoi(10, 20, decoder));
+
+    for (uint16_t row = 0; row < IMAGE_H; row++) {
+        for (uint16_t col = 0; col < IMAGE_W; col++) {
+            CHECK_EQ(panel.pixel((uint16_t)(10 + col), (uint16_t)(20 + row)), expected565(row * IMAGE_W + col));
+        }
+    }
+    CHECK_EQ(panel.stray_bytes(), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testVector();
+    testColumns();
+    testTruncated();
+    testBadHeader();
+    testBlit();
+    return test_result("qoiDecoderTest");
+    }
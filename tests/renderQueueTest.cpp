@@ -0,0 +1,213 @@
+/*********************************************************************
+*
+*   NAME:
+*       renderQueueTest.cpp
+*
+*   DESCRIPTION:
+*       Producer/consumer stress test for RenderQueue: the test thread
+*       pushes numbered commands through a small ring while the worker
+*       thread drains it, and the pixels reaching the transport must
+*       come out complete and in order, and a queue too small for a
+*       ring runs each command on the caller
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "hostTransport.hpp"
+#include "renderQueue.hpp"
+#include "testCheck.hpp"
+#include <vector>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint32_t COMMANDS = 50000;
+constexpr uint16_t RING = 8;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* keeps every RAMWR payload as RGB565 values */
+class PixelLog : public HostTransport {
+    public:
+        void set_dc(bool data) override
+            {
+            HostTransport::set_dc(data);
+            _data = data;
+            }
+
+        void write(const uint8_t* data, size_t len) override
+            {
+            HostTransport::write(data, len);
+            if (!_data) {
+                _in_ramwr = (len == 1 && data[0] == (uint8_t)ST7789VW_CMD::RAMWR);
+                return;
+            }
+            for (size_t i = 0; _in_ramwr && i + 1 < len; i += 2) {
+                pixels.push_back((uint16_t)((data[i] << 8) | data[i + 1]));
+            }
+            }
+
+        std::vector<uint16_t> pixels;
+
+    private:
+        bool _data = false;
+        bool _in_ramwr = false;
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       pushNumbered
+*
+*   DESCRIPTION:
+*       Queues count 1x1 fills whose color is their sequence number
+*
+*********************************************************************/
+static void pushNumbered(RenderQueue& queue, uint32_t first, uint32_t count)
+    {
+    for (uint32_t i = first; i < first + count; i++) {
+        queue.fill_rect((uint16_t)(i % 240), (uint16_t)((i / 240) % 280), 1, 1, (uint16_t)i);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testStress
+*
+*   DESCRIPTION:
+*       Every command runs exactly once and in push order, with the
+*       ring full most of the time
+*
+*********************************************************************/
+static void testStress()
+    {
+    PixelLog transport;
+    DisplayProperties props = {240, 280, 240, 320, 0, 20};
+    ST7789VW display(transport, props);
+    display.init(false);
+    transport.pixels.reserve(COMMANDS);
+
+    StaticRenderQueue<RING> queue(display);
+    CHECK(queue.start());
+    pushNumbered(queue, 0, COMMANDS);
+    queue.sync();
+
+    RenderQueueStats stats = queue.stats();
+    CHECK_EQ(stats.pushed, COMMANDS);
+    CHECK_EQ(stats.executed, COMMANDS);
+    CHECK(stats.high_water <= RING - 1);
+
+    CHECK_EQ(transport.pixels.size(), (size_t)COMMANDS);
+    uint32_t out_of_order = 0;
+    for (size_t i = 0; i < transport.pixels.size(); i++) {
+        out_of_order += (transport.pixels[i] != (uint16_t)i);
+    }
+    CHECK_EQ(out_of_order, 0);
+
+    queue.stop();
+    CHECK_EQ(transport.stats().unselected_bytes, 0);
+    CHECK_EQ(transport.stats().early_releases, 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testResetWhileRunning
+*
+*   DESCRIPTION:
+*       reset_stats() while the worker is mid-ring: commands run after
+*       the reset are counted and none are lost or double counted
+*
+*********************************************************************/
+static void testResetWhileRunning()
+    {
+    HostTransport transport;
+    DisplayProperties props = {240, 280, 240, 320, 0, 20};
+    ST7789VW display(transport, props);
+    display.init(false);
+
+    StaticRenderQueue<RING> queue(display);
+    CHECK(queue.start());
+    for (uint32_t round = 0; round < 200; round++) {
+        pushNumbered(queue, 0, 100);
+        uint16_t queued = queue.depth();
+        queue.reset_stats();
+        pushNumbered(queue, 0, 100);
+        queue.sync();
+
+        RenderQueueStats stats = queue.stats();
+        CHECK_EQ(stats.pushed, 100);
+        CHECK(stats.executed >= 100 && stats.executed <= 100u + queued);
+    }
+    queue.stop();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testNoRing
+*
+*   DESCRIPTION:
+*       With 0 or 1 slots there is no ring: each draw call runs on the
+*       caller, in order, with or without a worker, instead of dividing
+*       by zero or waiting forever for a free slot
+*
+*********************************************************************/
+static void testNoRing()
+    {
+    RenderCommand slot[1];
+
+    for (uint16_t capacity = 0; capacity < 2; capacity++) {
+        PixelLog transport;
+        DisplayProperties props = {240, 280, 240, 320, 0, 20};
+        ST7789VW display(transport, props);
+        display.init(false);
+
+        RenderQueue queue(display, slot, capacity);
+        pushNumbered(queue, 0, 10);
+        CHECK_EQ(transport.pixels.size(), 10);
+        CHECK_EQ(queue.depth(), 0);
+
+        CHECK(queue.start());
+        pushNumbered(queue, 10, 10);
+        queue.sync();
+        queue.stop();
+
+        RenderQueueStats stats = queue.stats();
+        CHECK_EQ(stats.pushed, 20);
+        CHECK_EQ(stats.executed, 20);
+        CHECK_EQ(stats.stalls, 0);
+        CHECK_EQ(transport.pixels.size(), 20);
+        uint32_t out_of_order = 0;
+        for (size_t i = 0; i < transport.pixels.size(); i++) {
+            out_of_order += (transport.pixels[i] != (uint16_t)i);
+        }
+        CHECK_EQ(out_of_order, 0);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testStress();
+    testResetWhileRunning();
+    testNoRing();
+    return test_result("renderQueueTest");
+    }
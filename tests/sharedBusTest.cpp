@@ -0,0 +1,210 @@
+/*********************************************************************
+*
+*   NAME:
+*       sharedBusTest.cpp
+*
+*   DESCRIPTION:
+*       Two panels on one SharedSpiBus. Two threads draw on them at
+*       once, one in async mode; each panel's stream must arrive
+*       intact and both must get the bus. One thread driving both
+*       panels in async mode must not lock itself out.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+#include "hostTransport.hpp"
+#include "sharedBus.hpp"
+#include "testCheck.hpp"
+#include <atomic>
+#include <thread>
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr DisplayProperties PANEL_PROPS = {240, 280, 240, 320, 0, 20};
+constexpr uint32_t CHUNK = 512;
+constexpr uint32_t MIN_FRAMES = 40;
+constexpr uint32_t MAX_FRAMES = 4000;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* one panel: model, its own pins, and its view of the shared bus */
+struct BusPanel {
+    explicit BusPanel(SharedSpiBus& bus)
+        : panel(240, 320), device(&panel), transport(bus, device, 0), display(transport, PANEL_PROPS)
+        {
+        }
+
+    HostPanel panel;
+    HostTransport device;
+    SharedBusTransport transport;
+    ST7789VW display;
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       countRect
+*
+*   DESCRIPTION:
+*       Counts panel pixels of a color inside a rectangle
+*
+*********************************************************************/
+static uint32_t countRect(const HostPanel& panel, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+    {
+    uint32_t n = 0;
+    for (uint16_t row = y; row < y + h; row++) {
+        for (uint16_t col = x; col < x + w; col++) {
+            n += (panel.pixel(col, row) == color);
+        }
+    }
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       drawFrames
+*
+*   DESCRIPTION:
+*       Full-screen fills and a bar in the panel's own colors, until
+*       both threads have drawn MIN_FRAMES, then a final frame that
+*       is checked afterwards
+*
+*********************************************************************/
+static void drawFrames(BusPanel& p, uint16_t base, std::atomic<uint32_t>& mine, const std::atomic<uint32_t>& other)
+    {
+    uint32_t frame = 0;
+    while (frame < MAX_FRAMES && (frame < MIN_FRAMES || other.load() < MIN_FRAMES)) {
+        p.display.fill((uint16_t)(base + frame));
+        p.display.fill_rect(0, 100, 240, 40, (uint16_t)~(base + frame));
+        mine.store(++frame);
+    }
+
+    p.display.fill(base);
+    p.display.fill_rect(20, 50, 100, 60, (uint16_t)~base);
+    p.display.wait();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       checkPanel
+*
+*   DESCRIPTION:
+*       The final frame is on the panel and no byte was sent out of
+*       a transaction or cut short
+*
+*********************************************************************/
+static void checkPanel(BusPanel& p, uint16_t base)
+    {
+    CHECK_EQ(countRect(p.panel, 0, 20, 240, 280, base), 240 * 280 - 100 * 60);
+    CHECK_EQ(countRect(p.panel, 20, 70, 100, 60, (uint16_t)~base), 100 * 60);
+    CHECK_EQ(p.panel.stray_bytes(), 0);
+    CHECK_EQ(p.device.stats().unselected_bytes, 0);
+    CHECK_EQ(p.device.stats().early_releases, 0);
+    CHECK(!p.device.selected());
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testTwoThreads
+*
+*   DESCRIPTION:
+*       Each thread drives one panel; the async one queues its
+*       chunks through the device's write_async
+*
+*********************************************************************/
+static void testTwoThreads()
+    {
+    SharedSpiBus bus(CHUNK);
+    BusPanel a(bus);
+    BusPanel b(bus);
+    a.display.init(false);
+    b.display.init(false);
+    a.display.set_async(true);
+
+    std::atomic<uint32_t> frames_a(0);
+    std::atomic<uint32_t> frames_b(0);
+    std::thread thread_a([&] { drawFrames(a, 0x1111, frames_a, frames_b); });
+    std::thread thread_b([&] { drawFrames(b, 0x4444, frames_b, frames_a); });
+    thread_a.join();
+    thread_b.join();
+
+    checkPanel(a, 0x1111);
+    checkPanel(b, 0x4444);
+
+    /* both drew while the other did, and long bursts were split to
+       let the other panel in */
+    CHECK(frames_a.load() >= MIN_FRAMES && frames_b.load() >= MIN_FRAMES);
+    CHECK(a.transport.stats().yields + b.transport.stats().yields > 0);
+    CHECK(a.transport.stats().grants > frames_a.load());
+    CHECK(b.transport.stats().grants > frames_b.load());
+    CHECK(a.device.stats().async_writes > 0);
+    CHECK_EQ(b.device.stats().async_writes, 0);
+    CHECK(!bus.contended());
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testOneThreadAsync
+*
+*   DESCRIPTION:
+*       One thread alternating between two async panels: each draw
+*       call has to give the bus back before it returns, or the
+*       second panel waits for the bus forever
+*
+*********************************************************************/
+static void testOneThreadAsync()
+    {
+    SharedSpiBus bus(CHUNK);
+    BusPanel a(bus);
+    BusPanel b(bus);
+    a.display.init(false);
+    b.display.init(false);
+    a.display.set_async(true);
+    b.display.set_async(true);
+
+    for (uint16_t i = 0; i < 4; i++) {
+        a.display.fill((uint16_t)(0x2222 + i));
+        b.display.fill((uint16_t)(0x5555 + i));
+        a.display.write_string_pos((uint16_t)0, (uint16_t)0, "A", (uint16_t)Colors::WHITE, (uint16_t)Colors::BLACK);
+        b.display.write_string_pos((uint16_t)0, (uint16_t)0, "B", (uint16_t)Colors::WHITE, (uint16_t)Colors::BLACK);
+    }
+    a.display.fill(0x2222);
+    b.display.fill(0x5555);
+    a.display.fill_rect(20, 50, 100, 60, (uint16_t)~0x2222);
+    b.display.fill_rect(20, 50, 100, 60, (uint16_t)~0x5555);
+
+    checkPanel(a, 0x2222);
+    checkPanel(b, 0x5555);
+    CHECK(a.device.stats().async_writes > 0);
+    CHECK(b.device.stats().async_writes > 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    testOneThreadAsync();
+    testTwoThreads();
+    return test_result("sharedBusTest");
+    }
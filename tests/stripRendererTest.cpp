@@ -0,0 +1,187 @@
+/*********************************************************************
+*
+*   NAME:
+*       stripRendererTest.cpp
+*
+*   DESCRIPTION:
+*       Replays display lists through StripRenderer into HostPanel and
+*       checks the strip buffer is never written past its end, also
+*       when the display is rotated wider than the buffer
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "hostTransport.hpp"
+#include "stripRenderer.hpp"
+#include "testCheck.hpp"
+
+/*--------------------------------------------------------------------
+                          LITERAL CONSTANTS
+--------------------------------------------------------------------*/
+constexpr uint16_t STRIP_WIDTH = 240;
+constexpr uint16_t STRIP_ROWS = 8;
+constexpr uint16_t GUARD_PIXELS = 64;
+constexpr uint16_t GUARD = 0xA5A5;
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       countColor
+*
+*   DESCRIPTION:
+*       Counts panel pixels of a color
+*
+*********************************************************************/
+static uint32_t countColor(const HostPanel& panel, uint16_t color)
+    {
+    uint32_t n = 0;
+    for (uint16_t y = 0; y < panel.height(); y++) {
+        for (uint16_t x = 0; x < panel.width(); x++) {
+            n += (panel.pixel(x, y) == color);
+        }
+    }
+    return n;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       renderRotation
+*
+*   DESCRIPTION:
+*       Renders a background and one rectangle at a rotation and
+*       checks the panel and the guard pixels after the strip buffer
+*
+*********************************************************************/
+static void renderRotation(ST7789VW::Rotation rotation)
+    {
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    DisplayProperties props = {240, 280, 240, 320, 0, 20};
+    ST7789VW display(transport, props);
+    display.init();
+    display.set_rotation(rotation);
+    panel.clear(0x1234);
+
+    uint16_t strip[STRIP_WIDTH * STRIP_ROWS + GUARD_PIXELS];
+    DisplayListEntry entries[4];
+    char text[16];
+    for (uint16_t i = 0; i < GUARD_PIXELS; i++) {
+        strip[STRIP_WIDTH * STRIP_ROWS + i] = GUARD;
+    }
+
+    StripRenderer renderer(display, strip, STRIP_WIDTH, STRIP_ROWS, entries, 4, text, sizeof(text));
+    renderer.set_background((uint16_t)Colors::BLUE);
+    CHECK(renderer.fill_rect(10, 10, 50, 30, (uint16_t)Colors::RED));
+    CHECK(renderer.render());
+
+    uint32_t guard_hits = 0;
+    for (uint16_t i = 0; i < GUARD_PIXELS; i++) {
+        guard_hits += (strip[STRIP_WIDTH * STRIP_ROWS + i] != GUARD);
+    }
+    CHECK_EQ(guard_hits, 0);
+
+    CHECK_EQ(countColor(panel, (uint16_t)Colors::RED), 50 * 30);
+    CHECK_EQ(countColor(panel, (uint16_t)Colors::BLUE), 240 * 280 - 50 * 30);
+    CHECK_EQ(panel.stray_bytes(), 0);
+
+    /* rotated, the 280-pixel rows fit 6 to a strip over 240 rows */
+    uint32_t strips = (rotation == ST7789VW::Rotation::ROTATION_270) ? 240 / 6 : 280 / STRIP_ROWS;
+    CHECK_EQ(renderer.stats().strips, strips);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testTooNarrow
+*
+*   DESCRIPTION:
+*       A buffer smaller than one display row refuses to render
+*
+*********************************************************************/
+static void testTooNarrow()
+    {
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    DisplayProperties props = {240, 320, 240, 320, 0, 0};
+    ST7789VW display(transport, props);
+    display.init();
+
+    uint16_t strip[100];
+    DisplayListEntry entries[1];
+    char text[4];
+    StripRenderer renderer(display, strip, 100, 1, entries, 1, text, sizeof(text));
+    CHECK(!renderer.render());
+    CHECK_EQ(renderer.stats().strips, 0);
+    CHECK_EQ(panel.pixels_written(), 0);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       testPushedViewport
+*
+*   DESCRIPTION:
+*       The list is drawn in screen coordinates whatever viewport and
+*       clip the display has, entries may start off screen, and the
+*       viewport is back in place afterwards
+*
+*********************************************************************/
+static void testPushedViewport()
+    {
+    HostPanel panel(240, 320);
+    HostTransport transport(&panel);
+    DisplayProperties props = {240, 320, 240, 320, 0, 0};
+    ST7789VW display(transport, props);
+    display.init();
+    panel.clear(0x1234);
+
+    uint16_t strip[STRIP_WIDTH * STRIP_ROWS];
+    DisplayListEntry entries[4];
+    char text[16];
+    StripRenderer renderer(display, strip, STRIP_WIDTH, STRIP_ROWS, entries, 4, text, sizeof(text));
+    renderer.set_background((uint16_t)Colors::BLUE);
+    CHECK(renderer.fill_rect(10, 10, 50, 30, (uint16_t)Colors::RED));
+    CHECK(renderer.fill_rect(-20, 300, 40, 40, (uint16_t)Colors::GREEN));
+
+    CHECK(display.push_viewport(100, 100, 50, 50));
+    CHECK(display.push_clip(0, 0, 10, 10));
+    CHECK(renderer.render());
+
+    CHECK_EQ(countColor(panel, (uint16_t)Colors::RED), 50 * 30);
+    CHECK_EQ(panel.pixel(10, 10), (uint16_t)Colors::RED);
+    CHECK_EQ(countColor(panel, (uint16_t)Colors::GREEN), 20 * 20);
+    CHECK_EQ(panel.pixel(0, 300), (uint16_t)Colors::GREEN);
+    CHECK_EQ(countColor(panel, (uint16_t)Colors::BLUE), 240 * 320 - 50 * 30 - 20 * 20);
+    CHECK_EQ(panel.stray_bytes(), 0);
+
+    DisplayRect clip = display.clip_rect();
+    CHECK_EQ(clip.x, 100);
+    CHECK_EQ(clip.width, 10);
+    CHECK_EQ(display.viewport_width(), 50);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Test entry point
+*
+*********************************************************************/
+int main()
+    {
+    renderRotation(ST7789VW::Rotation::ROTATION_0);
+    renderRotation(ST7789VW::Rotation::ROTATION_270);
+    testTooNarrow();
+    testPushedViewport();
+    return test_result("stripRendererTest");
+    }
@@ -0,0 +1,57 @@
+#ifndef TEST_CHECK_HPP
+#define TEST_CHECK_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       minimal check macros for the host tests. Each test is its own
+*       executable; failed checks are printed and main returns
+*       test_result().
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stdio.h>
+
+/*--------------------------------------------------------------------
+                              VARIABLES
+--------------------------------------------------------------------*/
+inline int test_failures = 0;
+inline int test_checks = 0;
+
+/*--------------------------------------------------------------------
+                                MACROS
+--------------------------------------------------------------------*/
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        test_checks++;                                                      \
+        if (!(cond)) {                                                      \
+            test_failures++;                                                \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                      \
+    do {                                                                    \
+        test_checks++;                                                      \
+        long long _a = (long long)(a);                                      \
+        long long _b = (long long)(b);                                      \
+        if (_a != _b) {                                                     \
+            test_failures++;                                                \
+            printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n",        \
+                   __FILE__, __LINE__, #a, #b, _a, _b);                     \
+        }                                                                   \
+    } while (0)
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+inline int test_result(const char* name)
+    {
+    printf("%s: %d checks, %d failed\n", name, test_checks, test_failures);
+    return (test_failures == 0) ? 0 : 1;
+    }
+
+#endif // TEST_CHECK_HPP
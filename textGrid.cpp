@@ -0,0 +1,223 @@
+/*********************************************************************
+*
+*   NAME:
+*       textGrid.cpp
+*
+*   DESCRIPTION:
+*       Text grid with a shadow of every 8x8 cell. write() compares
+*       each character against the shadow and redraws only the cells
+*       that changed, one windowed burst per run of adjacent changed
+*       cells. A blank cell matches any blank with the same background
+*       since its foreground color never reaches the panel.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "textGrid.hpp"
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       sameCell
+*
+*   DESCRIPTION:
+*       True if drawing c in the given colors would leave the cell
+*       looking the way it already does
+*
+*********************************************************************/
+static bool sameCell(const TextCell& cell, char c, uint16_t color, uint16_t bg_color)
+    {
+    if (cell.c != c || cell.bg_color != bg_color) {
+        return false;
+    }
+    return c == ' ' || cell.color == color;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       TextGrid::TextGrid (constructor)
+*
+*   DESCRIPTION:
+*       TextGrid class constructor
+*
+*********************************************************************/
+TextGrid::TextGrid(ST7789VW& display, TextCell* cells, uint16_t cell_count)
+    : _display(display), _cells(cells), _cell_count(cell_count), _columns(0), _rows(0),
+      _rotation(display.rotation()), _stats()
+    {
+    _columns = (uint16_t)(_display.width() / 8);
+    _rows = (uint16_t)(_display.height() / 8);
+    invalidate();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       TextGrid::write
+*
+*   DESCRIPTION:
+*       Writes text at a cell position, sending only changed cells
+*
+*********************************************************************/
+void TextGrid::write(uint16_t col, uint16_t row, const char* text, uint16_t color, uint16_t bg_color)
+    {
+    checkRotation();
+    if (row >= _rows) {
+        return;
+    }
+
+    TextCell* line = &_cells[row * _columns];
+    uint16_t run_start = 0;
+    uint16_t run_len = 0;
+    const char* run_text = text;
+
+    for (; *text && col < _columns; text++, col++) {
+        _stats.cells_written++;
+        if (sameCell(line[col], *text, color, bg_color)) {
+            if (run_len) {
+                drawRun(run_start, row, run_text, run_len, color, bg_color);
+                run_len = 0;
+            }
+            continue;
+        }
+
+        if (run_len == 0) {
+            run_start = col;
+            run_text = text;
+        }
+        run_len++;
+        line[col] = {*text, color, bg_color};
+    }
+
+    if (run_len) {
+        drawRun(run_start, row, run_text, run_len, color, bg_color);
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       TextGrid::drawRun
+*
+*   DESCRIPTION:
+*       Sends a run of changed cells as one opaque text burst
+*
+*********************************************************************/
+void TextGrid::drawRun(uint16_t col, uint16_t row, const char* text, uint16_t len, uint16_t color, uint16_t bg_color)
+    {
+    char buf[DISPLAY_MAX_LINE_PIXELS / 8 + 1];
+    for (uint16_t i = 0; i < len; i++) {
+        buf[i] = text[i];
+    }
+    buf[len] = '\0';
+
+    _display.write_string_pos((uint16_t)(col * 8), (uint16_t)(row * 8), buf, color, bg_color);
+    _stats.cells_drawn += len;
+    _stats.runs++;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       TextGrid::clear
+*
+*   DESCRIPTION:
+*       Fills the display and records every cell as blank
+*
+*********************************************************************/
+void TextGrid::clear(uint16_t bg_color)
+    {
+    checkRotation();
+    _display.fill(bg_color);
+
+    for (uint16_t i = 0; i < _columns * _rows; i++) {
+        _cells[i] = {' ', bg_color, bg_color};
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       TextGrid::invalidate
+*
+*   DESCRIPTION:
+*       Forgets every cell so the next write redraws it
+*
+*********************************************************************/
+void TextGrid::invalidate()
+    {
+    if (_columns * _rows > _cell_count) {
+        _rows = (uint16_t)(_cell_count / _columns);
+    }
+    for (uint16_t i = 0; i < _columns * _rows; i++) {
+        _cells[i].c = '\0';
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       TextGrid::invalidate (area)
+*
+*   DESCRIPTION:
+*       Forgets the cells touched by a pixel area drawn by other means
+*
+*********************************************************************/
+void TextGrid::invalidate(int16_t x, int16_t y, uint16_t width, uint16_t height)
+    {
+    int x_end = x + width;
+    int y_end = y + height;
+    if (x < 0) {
+        x = 0;
+    }
+    if (y < 0) {
+        y = 0;
+    }
+    if (x >= x_end || y >= y_end) {
+        return;
+    }
+
+    uint16_t col_end = (uint16_t)((x_end + 7) / 8);
+    uint16_t row_end = (uint16_t)((y_end + 7) / 8);
+    if (col_end > _columns) {
+        col_end = _columns;
+    }
+    if (row_end > _rows) {
+        row_end = _rows;
+    }
+
+    for (uint16_t row = (uint16_t)(y / 8); row < row_end; row++) {
+        for (uint16_t col = (uint16_t)(x / 8); col < col_end; col++) {
+            _cells[row * _columns + col].c = '\0';
+        }
+    }
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       TextGrid::checkRotation
+*
+*   DESCRIPTION:
+*       Rebuilds the grid for the display's rotation if it changed
+*
+*********************************************************************/
+void TextGrid::checkRotation()
+    {
+    if (_display.rotation() == _rotation) {
+        return;
+    }
+
+    _rotation = _display.rotation();
+    _columns = (uint16_t)(_display.width() / 8);
+    _rows = (uint16_t)(_display.height() / 8);
+    invalidate();
+    }
@@ -0,0 +1,87 @@
+#ifndef TEXT_GRID_HPP
+#define TEXT_GRID_HPP
+/*********************************************************************
+*
+*   HEADER:
+*       character-cell text layer that only redraws cells whose
+*       character or colors changed
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include "displayAPI.hpp"
+
+/*--------------------------------------------------------------------
+                            TYPES/ENUMS
+--------------------------------------------------------------------*/
+typedef struct {
+    char c;                     /* '\0' when the cell content is unknown */
+    uint16_t color;
+    uint16_t bg_color;
+} TextCell;
+
+typedef struct {
+    uint32_t cells_written;     /* cells passed to write()              */
+    uint32_t cells_drawn;       /* cells that differed and were sent    */
+    uint32_t runs;              /* bursts the drawn cells went out in   */
+} TextGridStats;
+
+/*--------------------------------------------------------------------
+                               CLASSES
+--------------------------------------------------------------------*/
+/* Cells are 8x8 pixels on the display's current rotation; a rotation
+   change drops the shadow. cells must hold (width / 8) * (height / 8)
+   entries. Anything drawn over the grid by other means has to be
+   reported with invalidate() so those cells get redrawn. */
+class TextGrid {
+    public:
+        TextGrid(ST7789VW& display, TextCell* cells, uint16_t cell_count);
+
+        /* opaque text starting at a cell, clipped at the end of the row */
+        void write(uint16_t col, uint16_t row, const char* text, uint16_t color, uint16_t bg_color);
+
+        /* fills the display and sets every cell to a blank of bg_color */
+        void clear(uint16_t bg_color);
+
+        void invalidate();
+        void invalidate(int16_t x, int16_t y, uint16_t width, uint16_t height);
+
+        uint16_t columns() const { return _columns; }
+        uint16_t rows() const { return _rows; }
+
+        const TextGridStats& stats() const { return _stats; }
+        void reset_stats() { _stats = TextGridStats(); }
+
+        TextGrid (const TextGrid&) = delete;
+        TextGrid& operator= (const TextGrid&) = delete;
+
+    private:
+        void checkRotation();
+        void drawRun(uint16_t col, uint16_t row, const char* text, uint16_t len, uint16_t color, uint16_t bg_color);
+
+        ST7789VW& _display;
+        TextCell* _cells;
+        uint16_t _cell_count;
+        uint16_t _columns;
+        uint16_t _rows;
+        ST7789VW::Rotation _rotation;
+        TextGridStats _stats;
+};
+
+/* TextGrid with its cells sized at compile time */
+template <uint16_t WIDTH, uint16_t HEIGHT>
+class StaticTextGrid : public TextGrid {
+    public:
+        explicit StaticTextGrid(ST7789VW& display)
+            : TextGrid(display, _cell_storage, (WIDTH / 8) * (HEIGHT / 8))
+            {
+            }
+
+    private:
+        TextCell _cell_storage[(WIDTH / 8) * (HEIGHT / 8)];
+};
+
+#endif // TEXT_GRID_HPP
@@ -0,0 +1,330 @@
+/*********************************************************************
+*
+*   NAME:
+*       bdf2c.cpp
+*
+*   DESCRIPTION:
+*       Host tool that converts a BDF bitmap font into a C++ source
+*       file defining a packed Font for ST7789VW::set_font.
+*
+*       usage: bdf2c [-n name] [-r first-last] [-a bits [-s factor]]
+*                    in.bdf [out.cpp]
+*
+*       The range defaults to 32-126. Codes in the range that the
+*       font does not define get an empty glyph as wide as space.
+*       -a writes an anti-aliased font with 2 or 4 bits of coverage
+*       per pixel; -s then shrinks the BDF by factor, each output
+*       pixel covering factor x factor source pixels, so a large
+*       bitmap font renders small with smooth edges.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+/*--------------------------------------------------------------------
+                                TYPES
+--------------------------------------------------------------------*/
+struct BdfGlyph {
+    int width = 0;
+    int height = 0;
+    int x_offset = 0;
+    int y_offset = 0;           /* BDF: bottom of the box above the baseline */
+    int advance = 0;
+    std::vector<std::vector<uint8_t>> rows;     /* 1 bit, or coverage after shrinkFont */
+};
+
+struct BdfFont {
+    int ascent = 0;
+    int descent = 0;
+    std::map<int, BdfGlyph> glyphs;
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       loadBdf
+*
+*   DESCRIPTION:
+*       Reads the metrics and bitmaps of every encoded glyph
+*
+*********************************************************************/
+static bool loadBdf(const char* path, BdfFont& font)
+    {
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) {
+        return false;
+    }
+
+    char line[512];
+    bool have_ascent = false;
+    int box_h = 0;
+    int box_y = 0;
+    int encoding = -1;
+    BdfGlyph glyph;
+    int bitmap_rows = -1;       /* rows still to read, -1 outside BITMAP */
+
+    while (fgets(line, sizeof(line), f) != nullptr) {
+        if (bitmap_rows > 0) {
+            std::vector<uint8_t> row(glyph.width);
+            size_t digits = strspn(line, "0123456789abcdefABCDEF");
+            for (int col = 0; col < glyph.width && (size_t)(col / 4) < digits; col++) {
+                char hex[2] = {line[col / 4], '\0'};
+                row[col] = (strtol(hex, nullptr, 16) >> (3 - col % 4)) & 1;
+            }
+            glyph.rows.push_back(row);
+            bitmap_rows--;
+            continue;
+        }
+
+        if (sscanf(line, "FONT_ASCENT %d", &font.ascent) == 1) {
+            have_ascent = true;
+        } else if (sscanf(line, "FONT_DESCENT %d", &font.descent) == 1) {
+        } else if (sscanf(line, "FONTBOUNDINGBOX %*d %d %*d %d", &box_h, &box_y) == 2) {
+        } else if (strncmp(line, "STARTCHAR", 9) == 0) {
+            glyph = BdfGlyph();
+            encoding = -1;
+        } else if (sscanf(line, "ENCODING %d", &encoding) == 1) {
+        } else if (sscanf(line, "DWIDTH %d", &glyph.advance) == 1) {
+        } else if (sscanf(line, "BBX %d %d %d %d", &glyph.width, &glyph.height, &glyph.x_offset, &glyph.y_offset) == 4) {
+        } else if (strncmp(line, "BITMAP", 6) == 0) {
+            bitmap_rows = glyph.height;
+        } else if (strncmp(line, "ENDCHAR", 7) == 0) {
+            if (encoding >= 0 && encoding < 256) {
+                font.glyphs[encoding] = glyph;
+            }
+            bitmap_rows = -1;
+        }
+    }
+    fclose(f);
+
+    if (!have_ascent) {
+        font.ascent = box_h + box_y;
+        font.descent = -box_y;
+    }
+    return !font.glyphs.empty();
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       floorDiv
+*
+*   DESCRIPTION:
+*       Integer division rounding toward minus infinity
+*
+*********************************************************************/
+static int floorDiv(int a, int b)
+    {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       shrinkFont
+*
+*   DESCRIPTION:
+*       Box filters every glyph down by factor into coverage values
+*       0 to max_value. Output pixels are aligned to the pen origin
+*       and baseline so glyphs keep their relative placement.
+*
+*********************************************************************/
+static void shrinkFont(BdfFont& font, int factor, int max_value)
+    {
+    for (auto& entry : font.glyphs) {
+        BdfGlyph& in = entry.second;
+        BdfGlyph out;
+        out.advance = (in.advance + factor / 2) / factor;
+
+        if (in.width > 0 && in.height > 0) {
+            int x0 = floorDiv(in.x_offset, factor);
+            int x1 = floorDiv(in.x_offset + in.width - 1, factor);
+            int y0 = floorDiv(in.y_offset, factor);
+            int y1 = floorDiv(in.y_offset + in.height - 1, factor);
+            out.width = x1 - x0 + 1;
+            out.height = y1 - y0 + 1;
+            out.x_offset = x0;
+            out.y_offset = y0;
+
+            std::vector<std::vector<int>> count(out.height, std::vector<int>(out.width, 0));
+            for (int row = 0; row < in.height && row < (int)in.rows.size(); row++) {
+                int y = in.y_offset + in.height - 1 - row;
+                for (int col = 0; col < in.width; col++) {
+                    if (in.rows[row][col]) {
+                        count[y1 - floorDiv(y, factor)][floorDiv(in.x_offset + col, factor) - x0]++;
+                    }
+                }
+            }
+
+            int area = factor * factor;
+            for (const std::vector<int>& counts : count) {
+                std::vector<uint8_t> row(out.width);
+                for (int col = 0; col < out.width; col++) {
+                    row[col] = (uint8_t)((counts[col] * max_value + area / 2) / area);
+                }
+                out.rows.push_back(row);
+            }
+        }
+        in = out;
+    }
+
+    font.ascent = (font.ascent + factor - 1) / factor;
+    font.descent = (font.descent + factor - 1) / factor;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       writeSource
+*
+*   DESCRIPTION:
+*       Packs the glyphs in the range into one bitstream, bpp bits
+*       per pixel, and emits the C++ definition of the font
+*
+*********************************************************************/
+static bool writeSource(FILE* f, const std::string& name, const BdfFont& font, int first, int last, int bpp)
+    {
+    std::vector<uint8_t> bitmap;
+    uint32_t bits = 0;
+    auto push_value = [&](uint8_t value) {
+        if (bits % 8 == 0) {
+            bitmap.push_back(0);
+        }
+        bitmap.back() |= (uint8_t)(value << (8 - bpp - bits % 8));
+        bits += bpp;
+    };
+
+    int space_advance = 0;
+    auto space = font.glyphs.find(' ');
+    if (space != font.glyphs.end()) {
+        space_advance = space->second.advance;
+    }
+
+    int line_height = font.ascent + font.descent;
+    if (line_height <= 0 || line_height > 255) {
+        fprintf(stderr, "bdf2c: unsupported line height %d\n", line_height);
+        return false;
+    }
+
+    std::string glyph_lines;
+    for (int code = first; code <= last; code++) {
+        auto it = font.glyphs.find(code);
+        BdfGlyph glyph;
+        glyph.advance = space_advance;
+        if (it != font.glyphs.end()) {
+            glyph = it->second;
+        }
+
+        int y_offset = font.ascent - (glyph.y_offset + glyph.height);
+        if (glyph.width > 255 || glyph.height > 255 || glyph.advance < 0 || glyph.advance > 255
+            || glyph.x_offset < -128 || glyph.x_offset > 127 || y_offset < -128 || y_offset > 127) {
+            fprintf(stderr, "bdf2c: glyph %d does not fit the Font format\n", code);
+            return false;
+        }
+
+        char entry[96];
+        snprintf(entry, sizeof(entry), "    {%u, %d, %d, %d, %d, %d},  // 0x%02X\n",
+                 bits, glyph.width, glyph.height, glyph.advance, glyph.x_offset, y_offset, code);
+        glyph_lines += entry;
+
+        for (const std::vector<uint8_t>& row : glyph.rows) {
+            for (uint8_t value : row) {
+                push_value(value);
+            }
+        }
+    }
+
+    fprintf(f, "// Generated by bdf2c: codes %d-%d, line height %d, %d bpp, %zu bitmap bytes\n",
+            first, last, line_height, bpp, bitmap.size());
+    fprintf(f, "#include \"font.hpp\"\n\n");
+
+    fprintf(f, "static const uint8_t %s_bitmap[] = {", name.c_str());
+    for (size_t i = 0; i < bitmap.size(); i++) {
+        fprintf(f, "%s0x%02X,", (i % 16 == 0) ? "\n    " : " ", bitmap[i]);
+    }
+    fprintf(f, "\n};\n\n");
+
+    fprintf(f, "static const FontGlyph %s_glyphs[] = {\n%s};\n\n", name.c_str(), glyph_lines.c_str());
+
+    fprintf(f, "extern const Font %s = {\n", name.c_str());
+    fprintf(f, "    %s_bitmap, %s_glyphs, %d, %d, %d, %d\n", name.c_str(), name.c_str(), first, last, line_height, bpp);
+    fprintf(f, "};\n");
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Command line entry point
+*
+*********************************************************************/
+int main(int argc, char** argv)
+    {
+    std::string name = "font";
+    int first = 32;
+    int last = 126;
+    int bpp = 1;
+    int factor = 1;
+    const char* in_path = nullptr;
+    const char* out_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d-%d", &first, &last) != 2) {
+                first = -1;
+            }
+        } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+            bpp = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            factor = atoi(argv[++i]);
+        } else if (in_path == nullptr) {
+            in_path = argv[i];
+        } else {
+            out_path = argv[i];
+        }
+    }
+    if (in_path == nullptr || first < 0 || last > 255 || first > last
+        || (bpp != 1 && bpp != 2 && bpp != 4) || factor < 1 || (factor > 1 && bpp == 1)) {
+        fprintf(stderr, "usage: bdf2c [-n name] [-r first-last] [-a 2|4 [-s factor]] input.bdf [output.cpp]\n");
+        return 2;
+    }
+
+    BdfFont font;
+    if (!loadBdf(in_path, font)) {
+        fprintf(stderr, "bdf2c: cannot read %s\n", in_path);
+        return 1;
+    }
+    if (bpp > 1) {
+        shrinkFont(font, factor, (1 << bpp) - 1);
+    }
+
+    FILE* out = (out_path != nullptr) ? fopen(out_path, "w") : stdout;
+    if (out == nullptr) {
+        fprintf(stderr, "bdf2c: cannot write %s\n", out_path);
+        return 1;
+    }
+    bool ok = writeSource(out, name, font, first, last, bpp);
+    if (out != stdout) {
+        fclose(out);
+    }
+    return ok ? 0 : 1;
+    }
@@ -0,0 +1,416 @@
+/*********************************************************************
+*
+*   NAME:
+*       imgconv.cpp
+*
+*   DESCRIPTION:
+*       Host tool that converts a PPM (or PNG, when built with
+*       libpng) into a C++ source file defining an Image for
+*       ST7789VW::blit.
+*
+*       usage: imgconv [-f auto|rgb565|indexed|rle] [-n name] in [out]
+*
+*       auto picks whichever valid encoding is smallest. indexed and
+*       rle need at most 256 distinct RGB565 colors.
+*
+*   Copyright 2025 Nate Lenze
+*
+*********************************************************************/
+
+/*--------------------------------------------------------------------
+                              INCLUDES
+--------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(IMGCONV_HAVE_PNG)
+#include <png.h>
+#endif
+
+/*--------------------------------------------------------------------
+                                TYPES
+--------------------------------------------------------------------*/
+struct Bitmap {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint16_t> pixels;   /* RGB565 */
+};
+
+struct Encoded {
+    std::string format;             /* ImageFormat enumerator name */
+    std::vector<uint8_t> data;
+    std::vector<uint16_t> palette;
+};
+
+/*--------------------------------------------------------------------
+                              PROCEDURES
+--------------------------------------------------------------------*/
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       rgb565
+*
+*   DESCRIPTION:
+*       Packs 8-bit channels into RGB565
+*
+*********************************************************************/
+static uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b)
+    {
+    return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       ppmToken
+*
+*   DESCRIPTION:
+*       Reads the next whitespace separated header token of a PPM,
+*       skipping comments
+*
+*********************************************************************/
+static bool ppmToken(FILE* f, uint32_t& value)
+    {
+    int c = fgetc(f);
+    while (c != EOF) {
+        if (c == '#') {
+            while (c != EOF && c != '\n') {
+                c = fgetc(f);
+            }
+        } else if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            c = fgetc(f);
+        } else {
+            break;
+        }
+    }
+
+    value = 0;
+    bool any = false;
+    while (c >= '0' && c <= '9') {
+        value = value * 10 + (uint32_t)(c - '0');
+        any = true;
+        c = fgetc(f);
+    }
+    return any;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       loadPpm
+*
+*   DESCRIPTION:
+*       Loads a binary (P6) PPM with maxval 255
+*
+*********************************************************************/
+static bool loadPpm(const char* path, Bitmap& bitmap)
+    {
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) {
+        return false;
+    }
+
+    char magic[2];
+    uint32_t maxval = 0;
+    bool ok = fread(magic, 1, 2, f) == 2 && magic[0] == 'P' && magic[1] == '6'
+           && ppmToken(f, bitmap.width) && ppmToken(f, bitmap.height) && ppmToken(f, maxval) && maxval == 255;
+
+    if (ok) {
+        std::vector<uint8_t> rgb((size_t)bitmap.width * bitmap.height * 3);
+        ok = fread(rgb.data(), 1, rgb.size(), f) == rgb.size();
+        bitmap.pixels.resize((size_t)bitmap.width * bitmap.height);
+        for (size_t i = 0; ok && i < bitmap.pixels.size(); i++) {
+            bitmap.pixels[i] = rgb565(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+        }
+    }
+
+    fclose(f);
+    return ok;
+    }
+
+#if defined(IMGCONV_HAVE_PNG)
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       loadPng
+*
+*   DESCRIPTION:
+*       Loads any PNG through libpng's simplified API, compositing
+*       alpha over black
+*
+*********************************************************************/
+static bool loadPng(const char* path, Bitmap& bitmap)
+    {
+    png_image image;
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&image, path)) {
+        return false;
+    }
+
+    image.format = PNG_FORMAT_RGB;
+    std::vector<uint8_t> rgb(PNG_IMAGE_SIZE(image));
+    png_color black = {0, 0, 0};
+    if (!png_image_finish_read(&image, &black, rgb.data(), 0, nullptr)) {
+        return false;
+    }
+
+    bitmap.width = image.width;
+    bitmap.height = image.height;
+    bitmap.pixels.resize((size_t)image.width * image.height);
+    for (size_t i = 0; i < bitmap.pixels.size(); i++) {
+        bitmap.pixels[i] = rgb565(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+    }
+    return true;
+    }
+#endif
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       encodeRgb565
+*
+*   DESCRIPTION:
+*       Raw big-endian RGB565
+*
+*********************************************************************/
+static Encoded encodeRgb565(const Bitmap& bitmap)
+    {
+    Encoded out;
+    out.format = "RGB565";
+    for (uint16_t px : bitmap.pixels) {
+        out.data.push_back((uint8_t)(px >> 8));
+        out.data.push_back((uint8_t)px);
+    }
+    return out;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       buildPalette
+*
+*   DESCRIPTION:
+*       Collects the distinct colors, fails past 256
+*
+*********************************************************************/
+static bool buildPalette(const Bitmap& bitmap, std::vector<uint16_t>& palette, std::map<uint16_t, uint8_t>& lookup)
+    {
+    for (uint16_t px : bitmap.pixels) {
+        if (lookup.count(px) != 0) {
+            continue;
+        }
+        if (palette.size() == 256) {
+            return false;
+        }
+        lookup[px] = (uint8_t)palette.size();
+        palette.push_back(px);
+    }
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       encodeIndexed
+*
+*   DESCRIPTION:
+*       Packed palette indices at the smallest depth that fits
+*
+*********************************************************************/
+static bool encodeIndexed(const Bitmap& bitmap, Encoded& out)
+    {
+    std::map<uint16_t, uint8_t> lookup;
+    if (!buildPalette(bitmap, out.palette, lookup)) {
+        return false;
+    }
+
+    uint32_t bpp = 8;
+    out.format = "INDEXED_8BPP";
+    if (out.palette.size() <= 2) {
+        bpp = 1;
+        out.format = "INDEXED_1BPP";
+    } else if (out.palette.size() <= 4) {
+        bpp = 2;
+        out.format = "INDEXED_2BPP";
+    } else if (out.palette.size() <= 16) {
+        bpp = 4;
+        out.format = "INDEXED_4BPP";
+    }
+
+    size_t row_bytes = ((size_t)bitmap.width * bpp + 7) / 8;
+    out.data.assign(row_bytes * bitmap.height, 0);
+    for (uint32_t y = 0; y < bitmap.height; y++) {
+        for (uint32_t x = 0; x < bitmap.width; x++) {
+            uint32_t bit = x * bpp;
+            uint8_t index = lookup[bitmap.pixels[(size_t)y * bitmap.width + x]];
+            out.data[y * row_bytes + (bit >> 3)] |= (uint8_t)(index << (8 - bpp - (bit & 7)));
+        }
+    }
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       encodeRle
+*
+*   DESCRIPTION:
+*       (length - 1, index) runs over the whole image
+*
+*********************************************************************/
+static bool encodeRle(const Bitmap& bitmap, Encoded& out)
+    {
+    std::map<uint16_t, uint8_t> lookup;
+    if (!buildPalette(bitmap, out.palette, lookup)) {
+        return false;
+    }
+
+    out.format = "RLE8";
+    size_t i = 0;
+    while (i < bitmap.pixels.size()) {
+        uint16_t px = bitmap.pixels[i];
+        size_t run = 1;
+        while (run < 256 && i + run < bitmap.pixels.size() && bitmap.pixels[i + run] == px) {
+            run++;
+        }
+        out.data.push_back((uint8_t)(run - 1));
+        out.data.push_back(lookup[px]);
+        i += run;
+    }
+    return true;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       encodedSize
+*
+*   DESCRIPTION:
+*       Flash bytes used by an encoding
+*
+*********************************************************************/
+static size_t encodedSize(const Encoded& enc)
+    {
+    return enc.data.size() + enc.palette.size() * 2;
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       writeSource
+*
+*   DESCRIPTION:
+*       Emits the C++ definition of the image
+*
+*********************************************************************/
+static void writeSource(FILE* f, const std::string& name, const Bitmap& bitmap, const Encoded& enc)
+    {
+    fprintf(f, "// Generated by imgconv: %ux%u %s, %zu bytes\n", bitmap.width, bitmap.height, enc.format.c_str(), encodedSize(enc));
+    fprintf(f, "#include \"image.hpp\"\n\n");
+
+    fprintf(f, "static const uint8_t %s_data[] = {", name.c_str());
+    for (size_t i = 0; i < enc.data.size(); i++) {
+        fprintf(f, "%s0x%02X,", (i % 16 == 0) ? "\n    " : " ", enc.data[i]);
+    }
+    fprintf(f, "\n};\n\n");
+
+    if (!enc.palette.empty()) {
+        fprintf(f, "static const uint16_t %s_palette[] = {", name.c_str());
+        for (size_t i = 0; i < enc.palette.size(); i++) {
+            fprintf(f, "%s0x%04X,", (i % 8 == 0) ? "\n    " : " ", enc.palette[i]);
+        }
+        fprintf(f, "\n};\n\n");
+    }
+
+    fprintf(f, "extern const Image %s = {\n", name.c_str());
+    fprintf(f, "    %u, %u, ImageFormat::%s,\n", bitmap.width, bitmap.height, enc.format.c_str());
+    if (enc.palette.empty()) {
+        fprintf(f, "    %s_data, nullptr, 0\n", name.c_str());
+    } else {
+        fprintf(f, "    %s_data, %s_palette, %zu\n", name.c_str(), name.c_str(), enc.palette.size());
+    }
+    fprintf(f, "};\n");
+    }
+
+/*********************************************************************
+*
+*   PROCEDURE NAME:
+*       main
+*
+*   DESCRIPTION:
+*       Command line entry point
+*
+*********************************************************************/
+int main(int argc, char** argv)
+    {
+    std::string format = "auto";
+    std::string name = "image";
+    const char* in_path = nullptr;
+    const char* out_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            format = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (in_path == nullptr) {
+            in_path = argv[i];
+        } else {
+            out_path = argv[i];
+        }
+    }
+    if (in_path == nullptr) {
+        fprintf(stderr, "usage: imgconv [-f auto|rgb565|indexed|rle] [-n name] input.ppm|png [output.cpp]\n");
+        return 2;
+    }
+
+    Bitmap bitmap;
+    bool loaded = loadPpm(in_path, bitmap);
+#if defined(IMGCONV_HAVE_PNG)
+    if (!loaded) {
+        loaded = loadPng(in_path, bitmap);
+    }
+#endif
+    if (!loaded || bitmap.width == 0 || bitmap.width > 0xFFFF || bitmap.height > 0xFFFF) {
+        fprintf(stderr, "imgconv: cannot read %s\n", in_path);
+        return 1;
+    }
+
+    Encoded best = encodeRgb565(bitmap);
+    Encoded candidate;
+    if (format == "indexed" || format == "rle") {
+        bool ok = (format == "indexed") ? encodeIndexed(bitmap, candidate) : encodeRle(bitmap, candidate);
+        if (!ok) {
+            fprintf(stderr, "imgconv: more than 256 colors, use -f rgb565\n");
+            return 1;
+        }
+        best = candidate;
+    } else if (format == "auto") {
+        if (encodeIndexed(bitmap, candidate) && encodedSize(candidate) < encodedSize(best)) {
+            best = candidate;
+        }
+        candidate = Encoded();
+        if (encodeRle(bitmap, candidate) && encodedSize(candidate) < encodedSize(best)) {
+            best = candidate;
+        }
+    } else if (format != "rgb565") {
+        fprintf(stderr, "imgconv: unknown format %s\n", format.c_str());
+        return 2;
+    }
+
+    FILE* out = (out_path != nullptr) ? fopen(out_path, "w") : stdout;
+    if (out == nullptr) {
+        fprintf(stderr, "imgconv: cannot write %s\n", out_path);
+        return 1;
+    }
+    writeSource(out, name, bitmap, best);
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+    }